@@ -0,0 +1,208 @@
+#define _GNU_SOURCE
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "aocode_blake3.h"
+#include <string.h>
+
+/*
+ * A portable implementation of BLAKE3, as specified at https://github.com/BLAKE3-team/BLAKE3-specs.
+ * Parallelism comes from hashing subtrees on separate threads rather than from SIMD.
+ */
+
+#define CHUNK_START (1<<0)
+#define CHUNK_END (1<<1)
+#define PARENT (1<<2)
+#define ROOT (1<<3)
+
+static const uint32_t IV[8]={
+  0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+};
+
+static const uint8_t MSG_SCHEDULE[7][16]={
+  {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15},
+  {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8},
+  {3, 4, 10, 12, 13, 2, 7, 14, 6, 5, 9, 0, 11, 15, 8, 1},
+  {10, 7, 12, 9, 14, 3, 13, 15, 4, 0, 11, 2, 5, 8, 1, 6},
+  {12, 13, 9, 11, 15, 10, 14, 8, 7, 2, 5, 3, 0, 1, 6, 4},
+  {9, 14, 11, 5, 8, 12, 15, 1, 13, 3, 0, 10, 2, 6, 4, 7},
+  {11, 15, 5, 0, 1, 9, 8, 6, 14, 10, 2, 12, 3, 4, 7, 13}
+};
+
+static inline uint32_t rotr(uint32_t w, int c) {
+  return (w>>c) | (w<<(32-c));
+}
+
+static inline uint32_t load32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1]<<8) | ((uint32_t)p[2]<<16) | ((uint32_t)p[3]<<24);
+}
+
+static inline void store32(uint8_t* p, uint32_t w) {
+  p[0]=(uint8_t)w;
+  p[1]=(uint8_t)(w>>8);
+  p[2]=(uint8_t)(w>>16);
+  p[3]=(uint8_t)(w>>24);
+}
+
+static inline void g(uint32_t* s, int a, int b, int c, int d, uint32_t x, uint32_t y) {
+  s[a]=s[a]+s[b]+x;
+  s[d]=rotr(s[d]^s[a], 16);
+  s[c]=s[c]+s[d];
+  s[b]=rotr(s[b]^s[c], 12);
+  s[a]=s[a]+s[b]+y;
+  s[d]=rotr(s[d]^s[a], 8);
+  s[c]=s[c]+s[d];
+  s[b]=rotr(s[b]^s[c], 7);
+}
+
+// Compresses one block, leaving the first eight words of the output in cv
+static void compress(uint32_t cv[8], const uint8_t block[64], uint8_t blockLen, uint64_t counter, uint8_t flags) {
+  uint32_t m[16];
+  int i;
+  for (i=0; i<16; i++) m[i]=load32(block+i*4);
+  uint32_t s[16]={
+    cv[0], cv[1], cv[2], cv[3], cv[4], cv[5], cv[6], cv[7],
+    IV[0], IV[1], IV[2], IV[3], (uint32_t)counter, (uint32_t)(counter>>32), blockLen, flags
+  };
+  int r;
+  for (r=0; r<7; r++) {
+    const uint8_t* sched=MSG_SCHEDULE[r];
+    g(s, 0, 4, 8, 12, m[sched[0]], m[sched[1]]);
+    g(s, 1, 5, 9, 13, m[sched[2]], m[sched[3]]);
+    g(s, 2, 6, 10, 14, m[sched[4]], m[sched[5]]);
+    g(s, 3, 7, 11, 15, m[sched[6]], m[sched[7]]);
+    g(s, 0, 5, 10, 15, m[sched[8]], m[sched[9]]);
+    g(s, 1, 6, 11, 12, m[sched[10]], m[sched[11]]);
+    g(s, 2, 7, 8, 13, m[sched[12]], m[sched[13]]);
+    g(s, 3, 4, 9, 14, m[sched[14]], m[sched[15]]);
+  }
+  for (i=0; i<8; i++) cv[i]=s[i]^s[i+8];
+}
+
+// Compresses the last block of the current chunk, with root for the hash of a single chunk
+static void chunk_output(const aocode_blake3* hasher, uint32_t cv[8], int root) {
+  memcpy(cv, hasher->chunkCv, sizeof(hasher->chunkCv));
+  uint8_t block[64];
+  memcpy(block, hasher->block, hasher->blockLen);
+  memset(block+hasher->blockLen, 0, sizeof(block)-hasher->blockLen);
+  compress(
+    cv, block, hasher->blockLen, hasher->chunkCounter,
+    (hasher->blocksCompressed==0 ? CHUNK_START : 0) | CHUNK_END | (root ? ROOT : 0)
+  );
+}
+
+static void parent_cv(const uint32_t left[8], const uint32_t right[8], uint8_t flags, uint32_t cv[8]) {
+  uint8_t block[64];
+  int i;
+  for (i=0; i<8; i++) {
+    store32(block+i*4, left[i]);
+    store32(block+32+i*4, right[i]);
+  }
+  memcpy(cv, IV, sizeof(IV));
+  compress(cv, block, 64, 0, PARENT|flags);
+}
+
+static void chunk_reset(aocode_blake3* hasher, uint64_t chunkCounter) {
+  memcpy(hasher->chunkCv, IV, sizeof(IV));
+  hasher->chunkCounter=chunkCounter;
+  hasher->blockLen=0;
+  hasher->blocksCompressed=0;
+}
+
+// Pushes the chaining value of a completed chunk, first joining every subtree it completes
+static void push_chunk(aocode_blake3* hasher, uint32_t cv[8]) {
+  hasher->chunks++;
+  uint64_t total=hasher->chunks;
+  while ((total&1)==0) {
+    hasher->stackLen--;
+    parent_cv(hasher->stack[hasher->stackLen], cv, 0, cv);
+    total>>=1;
+  }
+  memcpy(hasher->stack[hasher->stackLen], cv, 8*sizeof(uint32_t));
+  hasher->stackLen++;
+}
+
+void aocode_blake3_init(aocode_blake3* hasher, uint64_t firstChunk) {
+  chunk_reset(hasher, firstChunk);
+  hasher->chunks=0;
+  hasher->stackLen=0;
+}
+
+void aocode_blake3_update(aocode_blake3* hasher, const void* input, size_t len) {
+  const uint8_t* in=(const uint8_t*)input;
+  while (len>0) {
+    // A full block is only compressed once more input follows, since the last block of a chunk is flagged
+    if (hasher->blockLen==64) {
+      if (hasher->blocksCompressed==AOCODE_BLAKE3_CHUNK_LEN/64-1) {
+        uint32_t cv[8];
+        chunk_output(hasher, cv, 0);
+        push_chunk(hasher, cv);
+        chunk_reset(hasher, hasher->chunkCounter+1);
+      } else {
+        compress(hasher->chunkCv, hasher->block, 64, hasher->chunkCounter, hasher->blocksCompressed==0 ? CHUNK_START : 0);
+        hasher->blocksCompressed++;
+        hasher->blockLen=0;
+      }
+    }
+    size_t take=64-hasher->blockLen;
+    if (take>len) take=len;
+    memcpy(hasher->block+hasher->blockLen, in, take);
+    hasher->blockLen+=(uint8_t)take;
+    in+=take;
+    len-=take;
+  }
+}
+
+/*
+ * Joins the current chunk with the stack, from the newest subtree to the oldest.  When root, the final join
+ * is flagged as the root, or the chunk itself when it is the whole input.
+ */
+static void finalize(const aocode_blake3* hasher, uint32_t cv[8], int root) {
+  int i=hasher->stackLen;
+  chunk_output(hasher, cv, root && i==0);
+  while (i>0) {
+    i--;
+    parent_cv(hasher->stack[i], cv, root && i==0 ? ROOT : 0, cv);
+  }
+}
+
+void aocode_blake3_finalize(const aocode_blake3* hasher, uint8_t out[AOCODE_BLAKE3_OUT_LEN]) {
+  uint32_t cv[8];
+  finalize(hasher, cv, 1);
+  int i;
+  for (i=0; i<8; i++) store32(out+i*4, cv[i]);
+}
+
+void aocode_blake3_finalize_cv(const aocode_blake3* hasher, uint32_t cv[8]) {
+  finalize(hasher, cv, 0);
+}
+
+void aocode_blake3_parent(const uint32_t left[8], const uint32_t right[8], int root, void* out) {
+  uint32_t cv[8];
+  parent_cv(left, right, root ? ROOT : 0, cv);
+  if (root) {
+    int i;
+    for (i=0; i<8; i++) store32((uint8_t*)out+i*4, cv[i]);
+  } else {
+    memcpy(out, cv, sizeof(cv));
+  }
+}
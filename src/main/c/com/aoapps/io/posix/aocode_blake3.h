@@ -0,0 +1,83 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stddef.h>
+#include <stdint.h>
+#ifndef _Included_aocode_blake3
+#define _Included_aocode_blake3
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The length of a hash
+#define AOCODE_BLAKE3_OUT_LEN 32
+
+// The length of the chunks at the leaves of the hash tree
+#define AOCODE_BLAKE3_CHUNK_LEN 1024
+
+// The most levels of the hash tree, enough for 2^64 bytes
+#define AOCODE_BLAKE3_MAX_DEPTH 54
+
+/*
+ * Incremental BLAKE3 of a subtree of the hash tree.  Subtrees of a power of two chunks, starting at a multiple of
+ * their size, may be hashed independently, such as in parallel, then joined with aocode_blake3_parent.
+ */
+typedef struct aocode_blake3 {
+  // The chaining value, counter, and buffered block of the current chunk
+  uint32_t chunkCv[8];
+  uint64_t chunkCounter;
+  uint8_t block[64];
+  uint8_t blockLen;
+  uint8_t blocksCompressed;
+  // The chunks completed in this subtree and the chaining values of its complete subtrees
+  uint64_t chunks;
+  uint8_t stackLen;
+  uint32_t stack[AOCODE_BLAKE3_MAX_DEPTH][8];
+} aocode_blake3;
+
+/*
+ * Starts a subtree at the given chunk, which is 0 for a whole input.
+ */
+extern void aocode_blake3_init(aocode_blake3* hasher, uint64_t firstChunk);
+
+extern void aocode_blake3_update(aocode_blake3* hasher, const void* input, size_t len);
+
+/*
+ * Gets the hash of a whole input, started at chunk 0.
+ */
+extern void aocode_blake3_finalize(const aocode_blake3* hasher, uint8_t out[AOCODE_BLAKE3_OUT_LEN]);
+
+/*
+ * Gets the chaining value of a subtree, to be joined with others.  The subtree must not be empty.
+ */
+extern void aocode_blake3_finalize_cv(const aocode_blake3* hasher, uint32_t cv[8]);
+
+/*
+ * Joins the chaining values of two adjacent subtrees, the left of a power of two chunks.  When root, out is the
+ * first AOCODE_BLAKE3_OUT_LEN bytes of the hash, otherwise the eight words of the parent chaining value.
+ */
+extern void aocode_blake3_parent(const uint32_t left[8], const uint32_t right[8], int root, void* out);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
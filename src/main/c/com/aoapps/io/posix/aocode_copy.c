@@ -0,0 +1,375 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#define _GNU_SOURCE
+#include "aocode_copy.h"
+#include "aocode_extent.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+
+// The most sent by one call to sendfile, which the kernel limits to just under 2 GiB
+#define TRANSFER_CHUNK 0x7ffff000
+// The buffer used when sendfile is not supported to out
+#define TRANSFER_BUFFER_SIZE 65536
+
+// Reads until the buffer is full or end of file, returns the number of bytes read or -1
+static ssize_t copy_read_fully(int fd, char* buff, size_t len) {
+  size_t total=0;
+  while (total<len) {
+    ssize_t count=read(fd, buff+total, len-total);
+    if (count==-1) {
+      if (errno==EINTR) continue;
+      return -1;
+    }
+    if (count==0) break;
+    total+=(size_t)count;
+  }
+  return (ssize_t)total;
+}
+
+// Reads at a position until the buffer is full or end of file, returns the number of bytes read or -1
+static ssize_t copy_pread_fully(int fd, char* buff, size_t len, off_t pos) {
+  size_t total=0;
+  while (total<len) {
+    ssize_t count=pread(fd, buff+total, len-total, pos+(off_t)total);
+    if (count==-1) {
+      if (errno==EINTR) continue;
+      return -1;
+    }
+    if (count==0) break;
+    total+=(size_t)count;
+  }
+  return (ssize_t)total;
+}
+
+static int copy_write_fully(int fd, const char* buff, size_t len) {
+  while (len>0) {
+    ssize_t count=write(fd, buff, len);
+    if (count==-1) {
+      if (errno==EINTR) continue;
+      return -1;
+    }
+    buff+=count;
+    len-=(size_t)count;
+  }
+  return 0;
+}
+
+/*
+ * Starts writeback of the window just completed, then waits for the window before it and drops its written pages
+ * from the page cache.  At most two windows are ever dirty or under writeback.  The source pages are left alone,
+ * since they may have been cached for other readers before the copy.
+ * Errors are ignored, except the ones that report a failed write, since write-behind is only an optimization.
+ */
+static int copy_write_behind(int out, off_t windowStart, off_t windowLen, off_t prevStart, off_t prevLen) {
+  if (sync_file_range(out, windowStart, windowLen, SYNC_FILE_RANGE_WRITE)!=0 && errno==EIO) return -1;
+  if (prevLen>0) {
+    if (
+      sync_file_range(out, prevStart, prevLen, SYNC_FILE_RANGE_WAIT_BEFORE|SYNC_FILE_RANGE_WRITE|SYNC_FILE_RANGE_WAIT_AFTER)!=0
+      && (errno==EIO || errno==ENOSPC)
+    ) return -1;
+    posix_fadvise(out, prevStart, prevLen, POSIX_FADV_DONTNEED);
+  }
+  return 0;
+}
+
+int aocode_copy_file(const char* from, const char* to, int overwrite, off_t maxDirty, char* buff, size_t buffSize, const char** errPath) {
+  *errPath=from;
+  int in=open(from, O_RDONLY|O_NOFOLLOW|O_NOCTTY|O_CLOEXEC);
+  if (in==-1) return errno==ELOOP ? AOCODE_NOT_REGULAR_FILE : errno;
+  struct stat st;
+  if (fstat(in, &st)!=0) {
+    int err=errno;
+    close(in);
+    return err;
+  }
+  if (!S_ISREG(st.st_mode)) {
+    close(in);
+    return AOCODE_NOT_REGULAR_FILE;
+  }
+  *errPath=to;
+  int out=open(to, O_WRONLY|O_CREAT|O_TRUNC|O_NOFOLLOW|O_NOCTTY|O_CLOEXEC|(overwrite ? 0 : O_EXCL), 0600);
+  if (out==-1) {
+    int err=errno;
+    close(in);
+    return err;
+  }
+  int err=0;
+  // Ownership before permissions, since changing the owner clears the set-user-ID and set-group-ID bits
+  if (fchown(out, st.st_uid, st.st_gid)!=0 || fchmod(out, st.st_mode & 07777)!=0) {
+    err=errno;
+  } else {
+    // Each window is half the dirty limit, but never less than the buffer
+    off_t window=maxDirty/2<(off_t)buffSize ? (off_t)buffSize : maxDirty/2;
+    off_t written=0;
+    off_t windowStart=0;
+    off_t prevStart=0;
+    off_t prevLen=0;
+    if (maxDirty>0) posix_fadvise(in, 0, 0, POSIX_FADV_SEQUENTIAL);
+    while (1) {
+      ssize_t count=copy_read_fully(in, buff, buffSize);
+      if (count==-1) {
+        err=errno;
+        *errPath=from;
+        break;
+      }
+      if (count==0) break;
+      if (copy_write_fully(out, buff, (size_t)count)!=0) {
+        err=errno;
+        break;
+      }
+      written+=count;
+      if (maxDirty>0 && written-windowStart>=window) {
+        if (copy_write_behind(out, windowStart, written-windowStart, prevStart, prevLen)!=0) {
+          err=errno;
+          break;
+        }
+        prevStart=windowStart;
+        prevLen=written-windowStart;
+        windowStart=written;
+      }
+      if ((size_t)count<buffSize) break;
+    }
+    // Starts writeback of the partial last window, leaving the final wait to any later fsync
+    if (err==0 && maxDirty>0 && written>windowStart) {
+      if (copy_write_behind(out, windowStart, written-windowStart, prevStart, prevLen)!=0) err=errno;
+    }
+  }
+  if (close(out)!=0 && err==0) err=errno;
+  close(in);
+  return err;
+}
+
+// Opens a file for comparison, returns the descriptor or -1 with the error set
+static int compare_open(const char* path, struct stat* st, int* err) {
+  int fd=open(path, O_RDONLY|O_NOCTTY|O_CLOEXEC);
+  if (fd==-1) {
+    *err=errno;
+    return -1;
+  }
+  if (fstat(fd, st)!=0) {
+    *err=errno;
+    close(fd);
+    return -1;
+  }
+  if (!S_ISREG(st->st_mode)) {
+    *err=AOCODE_NOT_REGULAR_FILE;
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+int aocode_compare_files(const char* path1, const char* path2, char* buff, size_t buffSize, int* equal, const char** errPath) {
+  int err=0;
+  struct stat st1;
+  struct stat st2;
+  *errPath=path1;
+  int fd1=compare_open(path1, &st1, &err);
+  if (fd1==-1) return err;
+  *errPath=path2;
+  int fd2=compare_open(path2, &st2, &err);
+  if (fd2==-1) {
+    close(fd1);
+    return err;
+  }
+  *equal=st1.st_size==st2.st_size;
+  if (*equal) {
+    aocode_extent_range* ranges;
+    size_t count;
+    err=aocode_extent_diff(fd1, &st1, fd2, &st2, &ranges, &count);
+    if (err!=0) {
+      *errPath=path1;
+    } else {
+      size_t half=buffSize/2;
+      char* buff1=buff;
+      char* buff2=buff+half;
+      size_t i;
+      for (i=0; *equal && err==0 && i<count; i++) {
+        off_t pos=ranges[i].start;
+        off_t end=pos+ranges[i].len;
+        while (pos<end) {
+          size_t len=(size_t)(end-pos<(off_t)half ? end-pos : (off_t)half);
+          ssize_t count1=copy_pread_fully(fd1, buff1, len, pos);
+          if (count1==-1) {
+            err=errno;
+            *errPath=path1;
+            break;
+          }
+          ssize_t count2=copy_pread_fully(fd2, buff2, len, pos);
+          if (count2==-1) {
+            err=errno;
+            *errPath=path2;
+            break;
+          }
+          // Either file was truncated while being compared
+          if (count1!=count2 || memcmp(buff1, buff2, (size_t)count1)!=0 || (size_t)count1<len) {
+            *equal=0;
+            break;
+          }
+          pos+=len;
+        }
+      }
+      free(ranges);
+    }
+  }
+  close(fd2);
+  close(fd1);
+  return err;
+}
+
+// Waits until a non-blocking out can be written, returns 0 or an errno
+static int transfer_wait(int out) {
+  struct pollfd pfd;
+  pfd.fd=out;
+  pfd.events=POLLOUT;
+  while (poll(&pfd, 1, -1)==-1) {
+    if (errno!=EINTR) return errno;
+  }
+  return 0;
+}
+
+// Writes all of a buffer, waiting while a non-blocking out is full, returns 0 or an errno
+static int transfer_write(int out, const char* buff, size_t len) {
+  while (len>0) {
+    ssize_t count=write(out, buff, len);
+    if (count==-1) {
+      if (errno==EINTR) continue;
+      if (errno==EAGAIN) {
+        int err=transfer_wait(out);
+        if (err!=0) return err;
+        continue;
+      }
+      return errno;
+    }
+    buff+=count;
+    len-=count;
+  }
+  return 0;
+}
+
+// Sends through user space, for when sendfile is not supported to out
+static int transfer_copy(int in, int out, off_t offset, off_t length, off_t* transferred) {
+  char* buff=(char*)malloc(TRANSFER_BUFFER_SIZE);
+  if (buff==NULL) return ENOMEM;
+  int err=0;
+  while (length<0 || *transferred<length) {
+    size_t wanted=TRANSFER_BUFFER_SIZE;
+    if (length>=0 && (off_t)wanted>length-*transferred) wanted=length-*transferred;
+    ssize_t count=pread(in, buff, wanted, offset+*transferred);
+    if (count==-1) {
+      if (errno==EINTR) continue;
+      err=errno;
+      break;
+    }
+    if (count==0) break;
+    err=transfer_write(out, buff, count);
+    if (err!=0) break;
+    *transferred+=count;
+  }
+  free(buff);
+  return err;
+}
+
+int aocode_transfer(int in, int out, off_t offset, off_t length, off_t* transferred) {
+  *transferred=0;
+  off_t position=offset;
+  while (length<0 || *transferred<length) {
+    size_t wanted=TRANSFER_CHUNK;
+    if (length>=0 && (off_t)wanted>length-*transferred) wanted=length-*transferred;
+    ssize_t count=sendfile(out, in, &position, wanted);
+    if (count==-1) {
+      if (errno==EINTR) continue;
+      if (errno==EAGAIN) {
+        int err=transfer_wait(out);
+        if (err!=0) return err;
+        continue;
+      }
+      if ((errno==EINVAL || errno==ENOSYS) && *transferred==0) {
+        return transfer_copy(in, out, offset, length, transferred);
+      }
+      return errno;
+    }
+    // End of file
+    if (count==0) break;
+    *transferred+=count;
+  }
+  return 0;
+}
+
+// Makes the temporary names of concurrent writers distinct
+static unsigned long writeCounter=0;
+
+int aocode_write_file(const char* path, const char* data, size_t len, mode_t mode, uid_t uid, gid_t gid, int sync) {
+  // Split into the directory and the name within it
+  const char* slash=strrchr(path, '/');
+  const char* name=slash==NULL ? path : slash+1;
+  if (*name=='\0') return EISDIR;
+  int dirfd=AT_FDCWD;
+  if (slash!=NULL) {
+    char dir[PATH_MAX];
+    size_t dirLen=slash==path ? 1 : (size_t)(slash-path);
+    if (dirLen>=sizeof(dir)) return ENAMETOOLONG;
+    memcpy(dir, path, dirLen);
+    dir[dirLen]='\0';
+    dirfd=open(dir, O_PATH|O_DIRECTORY|O_CLOEXEC);
+    if (dirfd==-1) return errno;
+  }
+  char tmpName[NAME_MAX+1];
+  int fd=-1;
+  int err=0;
+  int attempt;
+  for (attempt=0; attempt<100; attempt++) {
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    unsigned long unique=__atomic_add_fetch(&writeCounter, 1, __ATOMIC_RELAXED);
+    if ((size_t)snprintf(tmpName, sizeof(tmpName), ".%s.%lx%lx%lx", name, (unsigned long)getpid(), unique, (unsigned long)now.tv_nsec)>=sizeof(tmpName)) {
+      err=ENAMETOOLONG;
+      break;
+    }
+    fd=openat(dirfd, tmpName, O_WRONLY|O_CREAT|O_EXCL|O_NOFOLLOW|O_CLOEXEC, 0600);
+    if (fd!=-1 || errno!=EEXIST) break;
+  }
+  if (fd==-1) {
+    if (err==0) err=errno;
+  } else {
+    err=transfer_write(fd, data, len);
+    if (err==0 && fchown(fd, uid, gid)!=0) err=errno;
+    if (err==0 && fchmod(fd, mode & 07777)!=0) err=errno;
+    if (err==0 && sync && fdatasync(fd)!=0) err=errno;
+    if (close(fd)!=0 && err==0) err=errno;
+    if (err==0 && renameat(dirfd, tmpName, dirfd, name)!=0) err=errno;
+    if (err!=0) unlinkat(dirfd, tmpName, 0);
+  }
+  if (dirfd!=AT_FDCWD) close(dirfd);
+  return err;
+}
@@ -0,0 +1,71 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stddef.h>
+#include <sys/types.h>
+#ifndef _Included_aocode_copy
+#define _Included_aocode_copy
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Returned instead of an errno when a file is not a regular file
+#define AOCODE_NOT_REGULAR_FILE (-2)
+
+/*
+ * Copies a regular file, including its permissions and ownership, never following a final symbolic link.
+ * When maxDirty is positive, the copy is written behind: each completed window of half of maxDirty bytes is sent to
+ * writeback with sync_file_range, the window before it is waited on, and the written pages of the waited
+ * window are dropped from the page cache.  This bounds the dirty pages of the stream instead of leaving the kernel
+ * to throttle the writer in large stalls.  Zero copies through the page cache as usual.
+ * Returns 0, an errno, or AOCODE_NOT_REGULAR_FILE with errPath set to the file that failed.
+ */
+extern int aocode_copy_file(const char* from, const char* to, int overwrite, off_t maxDirty, char* buff, size_t buffSize, const char** errPath);
+
+/*
+ * Compares the contents of two regular files, following symbolic links.  Sets equal to 1 or 0.
+ * Only the ranges found by aocode_extent_diff are read, so the same inode, shared extents, and common holes are
+ * equal without reading them.
+ * Returns 0, an errno, or AOCODE_NOT_REGULAR_FILE with errPath set to the file that failed.
+ */
+extern int aocode_compare_files(const char* path1, const char* path2, char* buff, size_t buffSize, int* equal, const char** errPath);
+
+/*
+ * Sends length bytes of a regular file, starting at offset, to a socket, pipe, or other file with sendfile, so the
+ * bytes are never copied through user space.  A negative length sends through the end of the file.  Waits while a
+ * non-blocking out is full.  Falls back to read and write when the kernel cannot sendfile to out.
+ * Sets transferred to the number of bytes sent, which is less than length when the file is shorter.
+ * Returns 0 or an errno.
+ */
+extern int aocode_transfer(int in, int out, off_t offset, off_t length, off_t* transferred);
+
+/*
+ * Atomically replaces a file: the contents are written to a new temporary file in the same directory, which is
+ * given its owner and mode, optionally flushed with fdatasync, then renamed over the file.  The temporary file
+ * is removed on failure.  Returns 0 or an errno.
+ */
+extern int aocode_write_file(const char* path, const char* data, size_t len, mode_t mode, uid_t uid, gid_t gid, int sync);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
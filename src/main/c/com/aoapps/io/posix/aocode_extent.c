@@ -0,0 +1,260 @@
+#define _GNU_SOURCE
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "aocode_extent.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/fiemap.h>
+#include <linux/fs.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+// The number of extents fetched by each FIEMAP call
+#define EXTENT_BATCH 256
+
+// The flags of extents whose physical location does not identify their data
+#define EXTENT_UNRELIABLE (FIEMAP_EXTENT_UNKNOWN|FIEMAP_EXTENT_DELALLOC|FIEMAP_EXTENT_ENCODED|FIEMAP_EXTENT_DATA_ENCRYPTED \
+  |FIEMAP_EXTENT_NOT_ALIGNED|FIEMAP_EXTENT_DATA_INLINE|FIEMAP_EXTENT_DATA_TAIL)
+
+// The flags of extents with data not yet written, which may be newer than any extent reported for the same range
+#define EXTENT_PENDING (FIEMAP_EXTENT_UNKNOWN|FIEMAP_EXTENT_DELALLOC)
+
+// A growable list of ranges in order
+typedef struct range_list {
+  aocode_extent_range* ranges;
+  size_t count;
+  size_t cap;
+} range_list;
+
+// Adds a range after all others, joining it with the last when adjacent, returns 0 or ENOMEM
+static int range_list_add(range_list* list, off_t start, off_t len) {
+  if (len<=0) return 0;
+  if (list->count>0) {
+    aocode_extent_range* last=&list->ranges[list->count-1];
+    if (last->start+last->len>=start) {
+      off_t end=start+len;
+      if (end>last->start+last->len) last->len=end-last->start;
+      return 0;
+    }
+  }
+  if (list->count==list->cap) {
+    size_t newCap=list->cap==0 ? 16 : list->cap*2;
+    aocode_extent_range* newRanges=(aocode_extent_range*)realloc(list->ranges, newCap*sizeof(aocode_extent_range));
+    if (newRanges==NULL) return ENOMEM;
+    list->ranges=newRanges;
+    list->cap=newCap;
+  }
+  list->ranges[list->count].start=start;
+  list->ranges[list->count].len=len;
+  list->count++;
+  return 0;
+}
+
+/*
+ * Finds the data of a file with SEEK_DATA and SEEK_HOLE, all of it when holes are not supported.
+ * Returns 0 or an errno.
+ */
+static int extent_find_data(int fd, off_t size, range_list* data) {
+  off_t pos=0;
+  while (pos<size) {
+    off_t start=lseek(fd, pos, SEEK_DATA);
+    if (start==-1) {
+      // No more data
+      if (errno==ENXIO) return 0;
+      if (errno==EINVAL || errno==EOPNOTSUPP) return range_list_add(data, pos, size-pos);
+      return errno;
+    }
+    if (start>=size) return 0;
+    off_t end=lseek(fd, start, SEEK_HOLE);
+    if (end==-1) return errno;
+    if (end>size) end=size;
+    int err=range_list_add(data, start, end-start);
+    if (err!=0) return err;
+    pos=end;
+  }
+  return 0;
+}
+
+/*
+ * Gets the extents of a file that have a reliable physical location, setting pending when any have data not yet
+ * written.  Returns 0 or an errno, with the list empty when FIEMAP is not supported.
+ */
+static int extent_fiemap(int fd, off_t size, struct fiemap_extent** extents, size_t* count, int* pending) {
+  *extents=NULL;
+  *count=0;
+  *pending=0;
+  size_t cap=0;
+  struct fiemap* map=(struct fiemap*)malloc(sizeof(struct fiemap)+EXTENT_BATCH*sizeof(struct fiemap_extent));
+  if (map==NULL) return ENOMEM;
+  int err=0;
+  uint64_t pos=0;
+  int done=0;
+  while (!done && pos<(uint64_t)size) {
+    memset(map, 0, sizeof(struct fiemap));
+    map->fm_start=pos;
+    map->fm_length=(uint64_t)size-pos;
+    map->fm_extent_count=EXTENT_BATCH;
+    if (ioctl(fd, FS_IOC_FIEMAP, map)!=0) {
+      if (errno!=EOPNOTSUPP && errno!=ENOTTY && errno!=EINVAL) err=errno;
+      *count=0;
+      break;
+    }
+    if (map->fm_mapped_extents==0) break;
+    uint32_t i;
+    for (i=0; i<map->fm_mapped_extents; i++) {
+      struct fiemap_extent* extent=&map->fm_extents[i];
+      if (extent->fe_flags & FIEMAP_EXTENT_LAST) done=1;
+      pos=extent->fe_logical+extent->fe_length;
+      if (extent->fe_flags & EXTENT_PENDING) *pending=1;
+      if (extent->fe_flags & EXTENT_UNRELIABLE) continue;
+      if (*count==cap) {
+        size_t newCap=cap==0 ? EXTENT_BATCH : cap*2;
+        struct fiemap_extent* newExtents=(struct fiemap_extent*)realloc(*extents, newCap*sizeof(struct fiemap_extent));
+        if (newExtents==NULL) {
+          err=ENOMEM;
+          done=1;
+          break;
+        }
+        *extents=newExtents;
+        cap=newCap;
+      }
+      (*extents)[(*count)++]=*extent;
+    }
+  }
+  free(map);
+  if (err!=0) {
+    free(*extents);
+    *extents=NULL;
+    *count=0;
+  }
+  return err;
+}
+
+/*
+ * Finds the ranges both files map to the same physical location, in order.  Finds none when either file has data
+ * not yet written, since without flushing, which would write back every dirty page of both files, the extents
+ * reported may be where their data was and not where it will be.
+ * Returns 0 or an errno.
+ */
+static int extent_find_shared(int fd1, int fd2, off_t size, range_list* shared) {
+  struct fiemap_extent* extents1;
+  struct fiemap_extent* extents2;
+  size_t count1;
+  size_t count2;
+  int pending1;
+  int pending2;
+  int err=extent_fiemap(fd1, size, &extents1, &count1, &pending1);
+  if (err!=0) return err;
+  err=extent_fiemap(fd2, size, &extents2, &count2, &pending2);
+  if (err!=0) {
+    free(extents1);
+    return err;
+  }
+  size_t i1=0;
+  size_t i2=0;
+  while (err==0 && !pending1 && !pending2 && i1<count1 && i2<count2) {
+    struct fiemap_extent* e1=&extents1[i1];
+    struct fiemap_extent* e2=&extents2[i2];
+    uint64_t end1=e1->fe_logical+e1->fe_length;
+    uint64_t end2=e2->fe_logical+e2->fe_length;
+    uint64_t start=e1->fe_logical>e2->fe_logical ? e1->fe_logical : e2->fe_logical;
+    uint64_t end=end1<end2 ? end1 : end2;
+    // The overlap is shared when both map it to the same place
+    if (start<end && e1->fe_physical-e1->fe_logical==e2->fe_physical-e2->fe_logical) {
+      if (end>(uint64_t)size) end=(uint64_t)size;
+      if (start<end) err=range_list_add(shared, (off_t)start, (off_t)(end-start));
+    }
+    if (end1<=end2) i1++;
+    else i2++;
+  }
+  free(extents2);
+  free(extents1);
+  return err;
+}
+
+// Checks whether two files are on the same filesystem, so their physical locations may be compared
+static int extent_same_filesystem(int fd1, const struct stat* st1, int fd2, const struct stat* st2) {
+  if (st1->st_dev==st2->st_dev) return 1;
+  // Subvolumes, such as of btrfs, have their own device numbers but share a mount
+  struct statx stx1;
+  struct statx stx2;
+  return
+    statx(fd1, "", AT_EMPTY_PATH, STATX_MNT_ID, &stx1)==0 && (stx1.stx_mask & STATX_MNT_ID)
+    && statx(fd2, "", AT_EMPTY_PATH, STATX_MNT_ID, &stx2)==0 && (stx2.stx_mask & STATX_MNT_ID)
+    && stx1.stx_mnt_id==stx2.stx_mnt_id;
+}
+
+int aocode_extent_diff(int fd1, const struct stat* st1, int fd2, const struct stat* st2, aocode_extent_range** ranges, size_t* count) {
+  *ranges=NULL;
+  *count=0;
+  if (st1->st_dev==st2->st_dev && st1->st_ino==st2->st_ino) return 0;
+  off_t size=st1->st_size;
+  range_list data1={NULL, 0, 0};
+  range_list data2={NULL, 0, 0};
+  range_list data={NULL, 0, 0};
+  range_list shared={NULL, 0, 0};
+  range_list diff={NULL, 0, 0};
+  int err=extent_find_data(fd1, size, &data1);
+  if (err==0) err=extent_find_data(fd2, size, &data2);
+  // The data of either file, joined in order
+  size_t i1=0;
+  size_t i2=0;
+  while (err==0 && (i1<data1.count || i2<data2.count)) {
+    aocode_extent_range* next;
+    if (i2>=data2.count || (i1<data1.count && data1.ranges[i1].start<=data2.ranges[i2].start)) next=&data1.ranges[i1++];
+    else next=&data2.ranges[i2++];
+    err=range_list_add(&data, next->start, next->len);
+  }
+  if (err==0 && data.count>0 && extent_same_filesystem(fd1, st1, fd2, st2)) err=extent_find_shared(fd1, fd2, size, &shared);
+  // Less the shared ranges
+  size_t id;
+  size_t is=0;
+  for (id=0; err==0 && id<data.count; id++) {
+    off_t pos=data.ranges[id].start;
+    off_t end=pos+data.ranges[id].len;
+    while (err==0 && pos<end) {
+      while (is<shared.count && shared.ranges[is].start+shared.ranges[is].len<=pos) is++;
+      if (is<shared.count && shared.ranges[is].start<=pos) {
+        pos=shared.ranges[is].start+shared.ranges[is].len;
+      } else {
+        off_t stop=is<shared.count && shared.ranges[is].start<end ? shared.ranges[is].start : end;
+        err=range_list_add(&diff, pos, stop-pos);
+        pos=stop;
+      }
+    }
+  }
+  free(shared.ranges);
+  free(data.ranges);
+  free(data2.ranges);
+  free(data1.ranges);
+  if (err!=0) {
+    free(diff.ranges);
+    return err;
+  }
+  *ranges=diff.ranges;
+  *count=diff.count;
+  return 0;
+}
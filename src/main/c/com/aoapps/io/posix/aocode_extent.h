@@ -0,0 +1,54 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stddef.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#ifndef _Included_aocode_extent
+#define _Included_aocode_extent
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// One range of a file
+typedef struct aocode_extent_range {
+  off_t start;
+  off_t len;
+} aocode_extent_range;
+
+/*
+ * Finds the ranges of two open regular files, both of the given size, that must be read to compare their contents.
+ * Left out are the ranges that are provably equal without reading them:
+ *   - All of the file, when both are the same inode
+ *   - Ranges that are holes in both files, found with SEEK_DATA and SEEK_HOLE
+ *   - Ranges both files map to the same physical extents of the same filesystem, such as reflinked copies,
+ *     found with FIEMAP.  Extents without a reliable physical location, such as compressed extents, are always
+ *     read, and all of both files is read when either has delayed allocation or unknown extents.
+ * Sets ranges to a new array in order, which must be freed, and count to its length, which is 0 when nothing needs
+ * to be read.  Returns 0 or an errno.
+ */
+extern int aocode_extent_diff(int fd1, const struct stat* st1, int fd2, const struct stat* st2, aocode_extent_range** ranges, size_t* count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
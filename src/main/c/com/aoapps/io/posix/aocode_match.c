@@ -0,0 +1,177 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#define _GNU_SOURCE
+#include "aocode_match.h"
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MATCH_NONE UINT32_MAX
+
+void aocode_match_free(aocode_match* match) {
+  if (match==NULL) return;
+  free(match->lengths);
+  free(match->table);
+  free(match->outputs);
+  free(match->dictLinks);
+  free(match->sames);
+  free(match);
+}
+
+aocode_match* aocode_match_compile(const unsigned char* const* patterns, const uint32_t* lengths, uint32_t count) {
+  aocode_match* match=(aocode_match*)calloc(1, sizeof(aocode_match));
+  if (match==NULL) return NULL;
+  match->patternCount=count;
+  // Give each byte used by a pattern its own class, class zero is every other byte
+  uint64_t totalLen=0;
+  uint32_t p;
+  for (p=0; p<count; p++) {
+    if (lengths[p]==0) {
+      aocode_match_free(match);
+      errno=EINVAL;
+      return NULL;
+    }
+    totalLen+=lengths[p];
+    uint32_t i;
+    for (i=0; i<lengths[p]; i++) match->classes[patterns[p][i]]=1;
+  }
+  match->classCount=1;
+  int b;
+  for (b=0; b<256; b++) {
+    if (match->classes[b]!=0) match->classes[b]=(uint8_t)match->classCount++;
+  }
+  uint32_t classCount=match->classCount;
+  // One state per pattern byte at most, plus the root, with room for the low flag bit
+  if (totalLen>=(UINT32_MAX>>1) || (totalLen+1)*classCount>AOCODE_MATCH_MAX_TABLE/sizeof(uint32_t)) {
+    aocode_match_free(match);
+    errno=E2BIG;
+    return NULL;
+  }
+  size_t maxStates=(size_t)totalLen+1;
+  match->lengths=(uint32_t*)malloc((count==0 ? 1 : count)*sizeof(uint32_t));
+  match->table=(uint32_t*)calloc(maxStates*classCount, sizeof(uint32_t));
+  match->outputs=(uint32_t*)malloc(maxStates*sizeof(uint32_t));
+  match->dictLinks=(uint32_t*)calloc(maxStates, sizeof(uint32_t));
+  match->sames=(uint32_t*)malloc((count==0 ? 1 : count)*sizeof(uint32_t));
+  uint32_t* fails=(uint32_t*)calloc(maxStates, sizeof(uint32_t));
+  uint32_t* queue=(uint32_t*)malloc(maxStates*sizeof(uint32_t));
+  if (
+    match->lengths==NULL || match->table==NULL || match->outputs==NULL || match->dictLinks==NULL
+    || match->sames==NULL || fails==NULL || queue==NULL
+  ) {
+    free(fails);
+    free(queue);
+    aocode_match_free(match);
+    errno=ENOMEM;
+    return NULL;
+  }
+  memset(match->outputs, 0xff, maxStates*sizeof(uint32_t));
+  memcpy(match->lengths, lengths, count*sizeof(uint32_t));
+  uint32_t* table=match->table;
+  // Build the trie, a zero transition is no child since the root is never a child
+  uint32_t stateCount=1;
+  for (p=0; p<count; p++) {
+    uint32_t state=0;
+    uint32_t i;
+    for (i=0; i<lengths[p]; i++) {
+      uint32_t* next=&table[(size_t)state*classCount+match->classes[patterns[p][i]]];
+      if (*next==0) *next=stateCount++;
+      state=*next;
+    }
+    // Keep duplicate patterns in order
+    match->sames[p]=MATCH_NONE;
+    if (match->outputs[state]==MATCH_NONE) {
+      match->outputs[state]=p;
+    } else {
+      uint32_t last=match->outputs[state];
+      while (match->sames[last]!=MATCH_NONE) last=match->sames[last];
+      match->sames[last]=p;
+    }
+  }
+  // Fill in the missing transitions breadth-first, each row only depends on the rows of shallower states
+  size_t head=0;
+  size_t tail=0;
+  uint32_t c;
+  for (c=0; c<classCount; c++) {
+    uint32_t child=table[c];
+    if (child!=0) queue[tail++]=child;
+  }
+  while (head<tail) {
+    uint32_t state=queue[head++];
+    uint32_t* row=&table[(size_t)state*classCount];
+    const uint32_t* failRow=&table[(size_t)fails[state]*classCount];
+    for (c=0; c<classCount; c++) {
+      uint32_t child=row[c];
+      if (child!=0) {
+        uint32_t fail=failRow[c];
+        fails[child]=fail;
+        match->dictLinks[child]=match->outputs[fail]!=MATCH_NONE ? fail : match->dictLinks[fail];
+        queue[tail++]=child;
+      } else {
+        row[c]=failRow[c];
+      }
+    }
+  }
+  free(fails);
+  free(queue);
+  // Shift in the flag for states with matches so a scan only follows links when needed
+  size_t t;
+  size_t tableSize=(size_t)stateCount*classCount;
+  for (t=0; t<tableSize; t++) {
+    uint32_t next=table[t];
+    table[t]=(next<<1) | (match->outputs[next]!=MATCH_NONE || match->dictLinks[next]!=0 ? 1 : 0);
+  }
+  // Release the unused states
+  uint32_t* shrunk=(uint32_t*)realloc(table, tableSize*sizeof(uint32_t));
+  if (shrunk!=NULL) match->table=shrunk;
+  return match;
+}
+
+int aocode_match_scan(const aocode_match* match, uint32_t* state, uint64_t offset, const unsigned char* buff, size_t len, aocode_match_hit hit, void* ctx) {
+  const uint32_t* table=match->table;
+  const uint8_t* classes=match->classes;
+  size_t classCount=match->classCount;
+  uint32_t current=*state;
+  size_t i;
+  for (i=0; i<len; i++) {
+    uint32_t next=table[(size_t)current*classCount+classes[buff[i]]];
+    current=next>>1;
+    if ((next & 1)!=0) {
+      uint64_t end=offset+i+1;
+      uint32_t out=current;
+      do {
+        uint32_t p;
+        for (p=match->outputs[out]; p!=MATCH_NONE; p=match->sames[p]) {
+          int err=hit(ctx, end-match->lengths[p], p);
+          if (err!=0) {
+            *state=current;
+            return err;
+          }
+        }
+        out=match->dictLinks[out];
+      } while (out!=0);
+    }
+  }
+  *state=current;
+  return 0;
+}
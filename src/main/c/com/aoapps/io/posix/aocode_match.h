@@ -0,0 +1,70 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stddef.h>
+#include <stdint.h>
+#ifndef _Included_aocode_match
+#define _Included_aocode_match
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Called for each match, with the offset of its first byte, returns 0 to continue or an errno to stop the scan
+typedef int (*aocode_match_hit)(void* ctx, uint64_t offset, uint32_t pattern);
+
+/*
+ * An Aho-Corasick automaton compiled to a complete DFA.  Bytes are mapped to equivalence classes, with all bytes
+ * that appear in no pattern sharing one class, so each state only has one transition per class.  A scan does one
+ * table lookup per input byte regardless of the number of patterns.
+ */
+typedef struct aocode_match {
+  uint32_t patternCount;
+  uint32_t* lengths;     // The length of each pattern
+  uint32_t classCount;
+  uint8_t classes[256];  // The class of each byte
+  uint32_t* table;       // Indexed by state*classCount+class, the next state shifted left one, low bit set when the next state has matches
+  uint32_t* outputs;     // The first pattern ending at each state, UINT32_MAX for none
+  uint32_t* dictLinks;   // The next state along the failure links that has a pattern ending, zero for none
+  uint32_t* sames;       // The next identical pattern, UINT32_MAX for none
+} aocode_match;
+
+// The largest transition table compiled, about one state per pattern byte times four bytes per class
+#define AOCODE_MATCH_MAX_TABLE (256*1024*1024)
+
+/*
+ * Compiles the patterns, which must not be empty.  Returns NULL with errno set on failure, E2BIG when the table would
+ * be larger than AOCODE_MATCH_MAX_TABLE.
+ */
+extern aocode_match* aocode_match_compile(const unsigned char* const* patterns, const uint32_t* lengths, uint32_t count);
+
+extern void aocode_match_free(aocode_match* match);
+
+/*
+ * Scans the next block of a stream.  The state starts at zero and is carried between blocks so that matches may span
+ * them.  The offset is that of the first byte of the block within the stream.  Returns 0 or the error from hit.
+ */
+extern int aocode_match_scan(const aocode_match* match, uint32_t* state, uint64_t offset, const unsigned char* buff, size_t len, aocode_match_hit hit, void* ctx);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,335 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#define _GNU_SOURCE
+#include "aocode_pool.h"
+#include <errno.h>
+#include <limits.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/sysmacros.h>
+#include <unistd.h>
+
+// The work queue and CPUs of one NUMA node
+typedef struct pool_node {
+  int node;
+  cpu_set_t cpus;
+  int cpuCount;
+  int workerCount;
+  size_t queued;
+  aocode_pool_task* head;
+  aocode_pool_task* tail;
+} pool_node;
+
+// The tasks of one call to aocode_pool_run
+typedef struct aocode_pool_job {
+  size_t remaining;
+  int failed;
+  pthread_cond_t done;
+} aocode_pool_job;
+
+// The worker of one node
+typedef struct pool_worker {
+  size_t nodeIndex;
+} pool_worker;
+
+static pthread_once_t poolOnce=PTHREAD_ONCE_INIT;
+static pthread_mutex_t poolLock=PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t poolWork=PTHREAD_COND_INITIALIZER;
+static pool_node* poolNodes=NULL;
+static size_t poolNodeCount=0;
+static int poolStarted=0;
+static size_t poolNextNode=0;
+
+// The buffer for running tasks on the calling thread when the pool cannot be started
+static pthread_mutex_t fallbackLock=PTHREAD_MUTEX_INITIALIZER;
+static char* fallbackBuff=NULL;
+
+// The nodes of block devices, cached since sysfs lookups are slow
+typedef struct pool_dev_node {
+  dev_t dev;
+  int node;
+} pool_dev_node;
+
+static pool_dev_node* devNodes=NULL;
+static size_t devNodeCount=0;
+static size_t devNodeCap=0;
+
+// Parses a sysfs list such as "0-3,8-11" into a CPU set, returns the number of CPUs or -1
+static int pool_parse_cpulist(const char* list, cpu_set_t* cpus) {
+  CPU_ZERO(cpus);
+  int count=0;
+  while (*list!='\0' && *list!='\n') {
+    char* end;
+    long first=strtol(list, &end, 10);
+    if (end==list || first<0) return -1;
+    long last=first;
+    if (*end=='-') {
+      const char* lastStr=end+1;
+      last=strtol(lastStr, &end, 10);
+      if (end==lastStr || last<first) return -1;
+    }
+    long cpu;
+    for (cpu=first; cpu<=last && cpu<CPU_SETSIZE; cpu++) {
+      CPU_SET(cpu, cpus);
+      count++;
+    }
+    list=end;
+    if (*list==',') list++;
+  }
+  return count;
+}
+
+// Reads the first line of a small sysfs file, returns 0 or -1
+static int pool_read_line(const char* path, char* buff, size_t buffSize) {
+  FILE* file=fopen(path, "re");
+  if (file==NULL) return -1;
+  char* line=fgets(buff, (int)buffSize, file);
+  fclose(file);
+  return line==NULL ? -1 : 0;
+}
+
+// Adds one node, limited to the CPUs this process may run on
+static int pool_add_node(int node, const cpu_set_t* cpus, const cpu_set_t* allowed) {
+  pool_node* newNodes=(pool_node*)realloc(poolNodes, (poolNodeCount+1)*sizeof(pool_node));
+  if (newNodes==NULL) return -1;
+  poolNodes=newNodes;
+  pool_node* poolNode=&poolNodes[poolNodeCount];
+  memset(poolNode, 0, sizeof(pool_node));
+  poolNode->node=node;
+  CPU_AND(&poolNode->cpus, cpus, allowed);
+  poolNode->cpuCount=CPU_COUNT(&poolNode->cpus);
+  if (poolNode->cpuCount>0) poolNodeCount++;
+  return 0;
+}
+
+// Finds the NUMA nodes and their CPUs, falling back to a single node of all allowed CPUs
+static void pool_detect_topology(void) {
+  cpu_set_t allowed;
+  if (sched_getaffinity(0, sizeof(cpu_set_t), &allowed)!=0) {
+    CPU_ZERO(&allowed);
+    long cpu;
+    long cpuCount=sysconf(_SC_NPROCESSORS_ONLN);
+    for (cpu=0; cpu<cpuCount && cpu<CPU_SETSIZE; cpu++) CPU_SET(cpu, &allowed);
+  }
+  char buff[4096];
+  cpu_set_t online;
+  if (pool_read_line("/sys/devices/system/node/online", buff, sizeof(buff))==0 && pool_parse_cpulist(buff, &online)>0) {
+    int node;
+    for (node=0; node<CPU_SETSIZE; node++) {
+      if (!CPU_ISSET(node, &online)) continue;
+      char path[PATH_MAX];
+      snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", node);
+      cpu_set_t cpus;
+      if (pool_read_line(path, buff, sizeof(buff))==0 && pool_parse_cpulist(buff, &cpus)>0) {
+        if (pool_add_node(node, &cpus, &allowed)!=0) break;
+      }
+    }
+  }
+  if (poolNodeCount==0) pool_add_node(-1, &allowed, &allowed);
+}
+
+/*
+ * Takes the next task from this worker's node.  Tasks are only taken from other nodes when they have
+ * more queued than their own workers can start, so work stays near its device unless a node is backlogged.
+ * Returns NULL when there is nothing to do.
+ */
+static aocode_pool_task* pool_take(size_t nodeIndex) {
+  size_t c;
+  for (c=0; c<poolNodeCount; c++) {
+    pool_node* poolNode=&poolNodes[(nodeIndex+c)%poolNodeCount];
+    aocode_pool_task* task=poolNode->head;
+    if (task!=NULL && (c==0 || poolNode->queued>(size_t)poolNode->workerCount)) {
+      poolNode->head=task->next;
+      if (poolNode->head==NULL) poolNode->tail=NULL;
+      poolNode->queued--;
+      return task;
+    }
+  }
+  return NULL;
+}
+
+static void* pool_worker_run(void* arg) {
+  size_t nodeIndex=((pool_worker*)arg)->nodeIndex;
+  free(arg);
+  pool_node* poolNode=&poolNodes[nodeIndex];
+  if (poolNode->node!=-1) pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &poolNode->cpus);
+  // Allocated and touched after pinning so the pages are placed on this node
+  char* buff=(char*)mmap(NULL, AOCODE_POOL_BUFFER_SIZE, PROT_READ|PROT_WRITE, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+  if (buff==MAP_FAILED) buff=NULL;
+  else memset(buff, 0, AOCODE_POOL_BUFFER_SIZE);
+  pthread_mutex_lock(&poolLock);
+  while (1) {
+    aocode_pool_task* task=pool_take(nodeIndex);
+    if (task==NULL) {
+      pthread_cond_wait(&poolWork, &poolLock);
+      continue;
+    }
+    aocode_pool_job* job=task->job;
+    if (job->failed) {
+      task->err=ECANCELED;
+    } else {
+      pthread_mutex_unlock(&poolLock);
+      int err=buff==NULL ? ENOMEM : task->run(task, buff, AOCODE_POOL_BUFFER_SIZE);
+      pthread_mutex_lock(&poolLock);
+      task->err=err;
+      if (err!=0 && !job->failed) {
+        task->first=1;
+        job->failed=1;
+      }
+    }
+    if (--job->remaining==0) pthread_cond_signal(&job->done);
+  }
+  return NULL;
+}
+
+static void pool_start(void) {
+  pool_detect_topology();
+  size_t n;
+  for (n=0; n<poolNodeCount; n++) {
+    int workers=poolNodes[n].cpuCount;
+    if (workers>AOCODE_POOL_MAX_WORKERS_PER_NODE) workers=AOCODE_POOL_MAX_WORKERS_PER_NODE;
+    int w;
+    for (w=0; w<workers; w++) {
+      pool_worker* worker=(pool_worker*)malloc(sizeof(pool_worker));
+      if (worker==NULL) break;
+      worker->nodeIndex=n;
+      pthread_t thread;
+      pthread_attr_t attr;
+      pthread_attr_init(&attr);
+      pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+      if (pthread_create(&thread, &attr, pool_worker_run, worker)==0) {
+        poolNodes[n].workerCount++;
+        poolStarted=1;
+      } else {
+        free(worker);
+      }
+      pthread_attr_destroy(&attr);
+    }
+  }
+}
+
+int aocode_pool_node_of_dev(dev_t dev) {
+  int node=-1;
+  pthread_mutex_lock(&poolLock);
+  size_t c;
+  for (c=0; c<devNodeCount; c++) {
+    if (devNodes[c].dev==dev) {
+      node=devNodes[c].node;
+      pthread_mutex_unlock(&poolLock);
+      return node;
+    }
+  }
+  pthread_mutex_unlock(&poolLock);
+  // Walk up from the block device, or partition, to the bus device that knows its node
+  char link[PATH_MAX];
+  snprintf(link, sizeof(link), "/sys/dev/block/%u:%u", major(dev), minor(dev));
+  char* path=realpath(link, NULL);
+  if (path!=NULL) {
+    char* slash;
+    while ((slash=strrchr(path, '/'))!=NULL && slash!=path) {
+      char numaNode[PATH_MAX];
+      char buff[32];
+      snprintf(numaNode, sizeof(numaNode), "%s/numa_node", path);
+      if (pool_read_line(numaNode, buff, sizeof(buff))==0) {
+        node=atoi(buff);
+        break;
+      }
+      *slash='\0';
+    }
+    free(path);
+  }
+  pthread_mutex_lock(&poolLock);
+  if (devNodeCount==devNodeCap) {
+    size_t newCap=devNodeCap==0 ? 16 : devNodeCap<<1;
+    pool_dev_node* newDevNodes=(pool_dev_node*)realloc(devNodes, newCap*sizeof(pool_dev_node));
+    if (newDevNodes!=NULL) {
+      devNodes=newDevNodes;
+      devNodeCap=newCap;
+    }
+  }
+  if (devNodeCount<devNodeCap) {
+    devNodes[devNodeCount].dev=dev;
+    devNodes[devNodeCount].node=node;
+    devNodeCount++;
+  }
+  pthread_mutex_unlock(&poolLock);
+  return node;
+}
+
+int aocode_pool_run(aocode_pool_task** tasks, size_t count) {
+  pthread_once(&poolOnce, pool_start);
+  int failed=0;
+  size_t c;
+  if (!poolStarted) {
+    pthread_mutex_lock(&fallbackLock);
+    if (fallbackBuff==NULL) fallbackBuff=(char*)malloc(AOCODE_POOL_BUFFER_SIZE);
+    for (c=0; c<count; c++) {
+      tasks[c]->first=0;
+      if (failed) {
+        tasks[c]->err=ECANCELED;
+      } else {
+        tasks[c]->err=fallbackBuff==NULL ? ENOMEM : tasks[c]->run(tasks[c], fallbackBuff, AOCODE_POOL_BUFFER_SIZE);
+        if (tasks[c]->err!=0) {
+          tasks[c]->first=1;
+          failed=1;
+        }
+      }
+    }
+    pthread_mutex_unlock(&fallbackLock);
+    return failed ? -1 : 0;
+  }
+  if (count==0) return 0;
+  aocode_pool_job job;
+  job.remaining=count;
+  job.failed=0;
+  pthread_cond_init(&job.done, NULL);
+  pthread_mutex_lock(&poolLock);
+  for (c=0; c<count; c++) {
+    aocode_pool_task* task=tasks[c];
+    task->job=&job;
+    task->next=NULL;
+    task->err=0;
+    task->first=0;
+    // Tasks without a known node are spread across the nodes
+    size_t n;
+    for (n=0; n<poolNodeCount; n++) {
+      if (task->node!=-1 && poolNodes[n].node==task->node) break;
+    }
+    if (n==poolNodeCount) n=poolNextNode++%poolNodeCount;
+    pool_node* poolNode=&poolNodes[n];
+    if (poolNode->tail==NULL) poolNode->head=task;
+    else poolNode->tail->next=task;
+    poolNode->tail=task;
+    poolNode->queued++;
+  }
+  pthread_cond_broadcast(&poolWork);
+  while (job.remaining>0) pthread_cond_wait(&job.done, &poolLock);
+  failed=job.failed;
+  pthread_mutex_unlock(&poolLock);
+  pthread_cond_destroy(&job.done);
+  return failed ? -1 : 0;
+}
@@ -0,0 +1,68 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stddef.h>
+#include <sys/types.h>
+#ifndef _Included_aocode_pool
+#define _Included_aocode_pool
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The size of the I/O buffer of each worker, allocated on the worker's NUMA node
+#define AOCODE_POOL_BUFFER_SIZE (1024*1024)
+
+// The most workers started for each NUMA node
+#define AOCODE_POOL_MAX_WORKERS_PER_NODE 8
+
+// One unit of work, embedded as the first member of a larger task
+typedef struct aocode_pool_task {
+  // Performs the task with the worker's node-local buffer, returns 0 or an errno
+  int (*run)(struct aocode_pool_task* task, char* buff, size_t buffSize);
+  int node;  // The preferred NUMA node, -1 for any
+  int err;   // The result of run, or ECANCELED when skipped after another task failed
+  int first; // Whether this task was the first of its call to fail
+  // Private
+  struct aocode_pool_task* next;
+  struct aocode_pool_job* job;
+} aocode_pool_task;
+
+/*
+ * Gets the NUMA node closest to a block device, from the first numa_node found in its sysfs device path.
+ * Returns -1 when unknown, such as for virtual devices.
+ */
+extern int aocode_pool_node_of_dev(dev_t dev);
+
+/*
+ * Runs all tasks on the shared worker pool and waits for them to complete.  Each task is queued on its
+ * preferred node, where it is run by a worker pinned to that node's CPUs, unless a worker of another
+ * node is idle first.  Once any task fails, the tasks not yet started are skipped.
+ *
+ * Returns 0 when all tasks succeeded, otherwise -1 with the errors in each task and first set on the task
+ * whose failure happened first.  When the pool cannot be started, runs the tasks on the calling thread.
+ */
+extern int aocode_pool_run(aocode_pool_task** tasks, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -0,0 +1,309 @@
+#define _GNU_SOURCE
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "aocode_range.h"
+#include "aocode_copy.h"
+#include "aocode_extent.h"
+#include "aocode_pool.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Returned by a range that found a difference, so the ranges not yet started are skipped
+#define RANGE_DIFFERENT (-3)
+
+// One range of a file, or of each of two files when comparing
+typedef struct range_task {
+  aocode_pool_task task;
+  int fd1;
+  int fd2;
+  off_t start;
+  off_t len;
+  // Set once any range differs, so ranges being read stop early
+  int* stop;
+  // Whether this range is the whole file, so its hash is the root
+  int root;
+  // The hash of this range, the root hash when root
+  uint32_t cv[8];
+  uint8_t hash[AOCODE_BLAKE3_OUT_LEN];
+  // Which file failed
+  int errFile;
+} range_task;
+
+// Reads exactly len bytes at pos, returns 0 or an errno, with EIO when the file was truncated
+static int range_pread_fully(int fd, char* buff, size_t len, off_t pos) {
+  while (len>0) {
+    ssize_t count=pread(fd, buff, len, pos);
+    if (count==-1) {
+      if (errno==EINTR) continue;
+      return errno;
+    }
+    if (count==0) return EIO;
+    buff+=count;
+    len-=(size_t)count;
+    pos+=count;
+  }
+  return 0;
+}
+
+static int range_compare_run(aocode_pool_task* task, char* buff, size_t buffSize) {
+  range_task* range=(range_task*)task;
+  size_t half=buffSize/2;
+  char* buff1=buff;
+  char* buff2=buff+half;
+  off_t pos=range->start;
+  off_t end=range->start+range->len;
+  while (pos<end) {
+    if (__atomic_load_n(range->stop, __ATOMIC_RELAXED)) return ECANCELED;
+    size_t len=(size_t)(end-pos<(off_t)half ? end-pos : (off_t)half);
+    int err=range_pread_fully(range->fd1, buff1, len, pos);
+    if (err!=0) {
+      range->errFile=1;
+      return err;
+    }
+    err=range_pread_fully(range->fd2, buff2, len, pos);
+    if (err!=0) {
+      range->errFile=2;
+      return err;
+    }
+    if (memcmp(buff1, buff2, len)!=0) {
+      __atomic_store_n(range->stop, 1, __ATOMIC_RELAXED);
+      return RANGE_DIFFERENT;
+    }
+    pos+=len;
+  }
+  return 0;
+}
+
+static int range_hash_run(aocode_pool_task* task, char* buff, size_t buffSize) {
+  range_task* range=(range_task*)task;
+  aocode_blake3 hasher;
+  aocode_blake3_init(&hasher, (uint64_t)(range->start/AOCODE_BLAKE3_CHUNK_LEN));
+  off_t pos=range->start;
+  off_t end=range->start+range->len;
+  while (pos<end) {
+    size_t len=(size_t)(end-pos<(off_t)buffSize ? end-pos : (off_t)buffSize);
+    int err=range_pread_fully(range->fd1, buff, len, pos);
+    if (err!=0) return err;
+    aocode_blake3_update(&hasher, buff, len);
+    pos+=len;
+  }
+  if (range->root) aocode_blake3_finalize(&hasher, range->hash);
+  else aocode_blake3_finalize_cv(&hasher, range->cv);
+  return 0;
+}
+
+/*
+ * Splits a file of the given size into ranges to hash, returns the tasks or NULL when out of memory.
+ * An empty file has one empty range.
+ */
+static range_task* range_split(off_t size, int fd, int node, size_t* count) {
+  size_t n=size==0 ? 1 : (size_t)((size+AOCODE_RANGE_SIZE-1)/AOCODE_RANGE_SIZE);
+  range_task* tasks=(range_task*)calloc(n, sizeof(range_task));
+  if (tasks==NULL) return NULL;
+  size_t i;
+  for (i=0; i<n; i++) {
+    range_task* range=&tasks[i];
+    range->task.node=node;
+    range->fd1=fd;
+    range->fd2=-1;
+    range->start=(off_t)i*AOCODE_RANGE_SIZE;
+    range->len=size-range->start<AOCODE_RANGE_SIZE ? size-range->start : AOCODE_RANGE_SIZE;
+    range->root=n==1;
+  }
+  *count=n;
+  return tasks;
+}
+
+/*
+ * Splits the ranges two files differ in into parts of at most AOCODE_RANGE_SIZE, returns the tasks or NULL when out
+ * of memory.
+ */
+static range_task* range_split_diff(const aocode_extent_range* diff, size_t diffCount, int fd1, int fd2, int node, int* stop, size_t* count) {
+  size_t n=0;
+  size_t d;
+  for (d=0; d<diffCount; d++) n+=(size_t)((diff[d].len+AOCODE_RANGE_SIZE-1)/AOCODE_RANGE_SIZE);
+  range_task* tasks=(range_task*)calloc(n, sizeof(range_task));
+  if (tasks==NULL) return NULL;
+  size_t i=0;
+  for (d=0; d<diffCount; d++) {
+    off_t pos=diff[d].start;
+    off_t end=pos+diff[d].len;
+    while (pos<end) {
+      range_task* range=&tasks[i++];
+      range->task.node=node;
+      range->fd1=fd1;
+      range->fd2=fd2;
+      range->start=pos;
+      range->len=end-pos<AOCODE_RANGE_SIZE ? end-pos : AOCODE_RANGE_SIZE;
+      range->stop=stop;
+      pos+=range->len;
+    }
+  }
+  *count=n;
+  return tasks;
+}
+
+// Runs the ranges on the pool, returns 0 or -1 with the errors in each range
+static int range_run(range_task* tasks, size_t count, int (*run)(aocode_pool_task*, char*, size_t)) {
+  aocode_pool_task** taskPtrs=(aocode_pool_task**)malloc(count*sizeof(aocode_pool_task*));
+  if (taskPtrs==NULL) {
+    tasks[0].task.err=ENOMEM;
+    return -1;
+  }
+  size_t i;
+  for (i=0; i<count; i++) {
+    tasks[i].task.run=run;
+    taskPtrs[i]=&tasks[i].task;
+  }
+  int result=aocode_pool_run(taskPtrs, count);
+  free(taskPtrs);
+  return result;
+}
+
+// Opens a regular file to be read in ranges, returns the descriptor or -1 with the error set
+static int range_open(const char* path, struct stat* st, int* err) {
+  int fd=open(path, O_RDONLY|O_NOCTTY|O_CLOEXEC);
+  if (fd==-1) {
+    *err=errno;
+    return -1;
+  }
+  if (fstat(fd, st)!=0) {
+    *err=errno;
+    close(fd);
+    return -1;
+  }
+  if (!S_ISREG(st->st_mode)) {
+    *err=AOCODE_NOT_REGULAR_FILE;
+    close(fd);
+    return -1;
+  }
+  // Each range is read in order, but the ranges are read at once
+  posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+  return fd;
+}
+
+int aocode_range_compare(const char* path1, const char* path2, int* equal, const char** errPath) {
+  int err=0;
+  struct stat st1;
+  struct stat st2;
+  *errPath=path1;
+  int fd1=range_open(path1, &st1, &err);
+  if (fd1==-1) return err;
+  *errPath=path2;
+  int fd2=range_open(path2, &st2, &err);
+  if (fd2==-1) {
+    close(fd1);
+    return err;
+  }
+  *equal=st1.st_size==st2.st_size;
+  aocode_extent_range* diff=NULL;
+  size_t diffCount=0;
+  if (*equal) {
+    err=aocode_extent_diff(fd1, &st1, fd2, &st2, &diff, &diffCount);
+    if (err!=0) *errPath=path1;
+  }
+  if (*equal && diffCount>0) {
+    int stop=0;
+    size_t count;
+    range_task* tasks=range_split_diff(diff, diffCount, fd1, fd2, aocode_pool_node_of_dev(st1.st_dev), &stop, &count);
+    if (tasks==NULL) {
+      err=ENOMEM;
+    } else {
+      if (range_run(tasks, count, range_compare_run)!=0) {
+        // A real error is reported over a difference, since the difference may be the result of it
+        size_t i;
+        for (i=0; i<count; i++) {
+          int rangeErr=tasks[i].task.err;
+          if (rangeErr==RANGE_DIFFERENT) {
+            *equal=0;
+          } else if (rangeErr!=0 && rangeErr!=ECANCELED) {
+            err=rangeErr;
+            *errPath=tasks[i].errFile==2 ? path2 : path1;
+            break;
+          }
+        }
+      }
+      free(tasks);
+    }
+  }
+  free(diff);
+  close(fd2);
+  close(fd1);
+  return err;
+}
+
+/*
+ * Joins the chaining values of ranges first to last, exclusive, into the chaining value of their subtree.
+ * The left subtree has the largest power of two chunks less than the total, which is always whole ranges.
+ */
+static void range_join(const range_task* tasks, size_t first, size_t last, int root, void* out) {
+  if (last-first==1) {
+    memcpy(out, tasks[first].cv, sizeof(tasks[first].cv));
+    return;
+  }
+  off_t start=tasks[first].start;
+  off_t end=tasks[last-1].start+tasks[last-1].len;
+  uint64_t chunks=(uint64_t)((end-start+AOCODE_BLAKE3_CHUNK_LEN-1)/AOCODE_BLAKE3_CHUNK_LEN);
+  uint64_t leftChunks=1;
+  while (leftChunks*2<chunks) leftChunks*=2;
+  size_t leftRanges=(size_t)(leftChunks*AOCODE_BLAKE3_CHUNK_LEN/AOCODE_RANGE_SIZE);
+  uint32_t left[8];
+  uint32_t right[8];
+  range_join(tasks, first, first+leftRanges, 0, left);
+  range_join(tasks, first+leftRanges, last, 0, right);
+  aocode_blake3_parent(left, right, root, out);
+}
+
+int aocode_range_hash(const char* path, uint8_t out[AOCODE_BLAKE3_OUT_LEN]) {
+  int err=0;
+  struct stat st;
+  int fd=range_open(path, &st, &err);
+  if (fd==-1) return err;
+  size_t count;
+  range_task* tasks=range_split(st.st_size, fd, aocode_pool_node_of_dev(st.st_dev), &count);
+  if (tasks==NULL) {
+    err=ENOMEM;
+  } else {
+    if (range_run(tasks, count, range_hash_run)!=0) {
+      size_t i;
+      for (i=0; i<count; i++) {
+        if (tasks[i].task.err!=0 && tasks[i].task.err!=ECANCELED) {
+          err=tasks[i].task.err;
+          break;
+        }
+      }
+      if (err==0) err=ECANCELED;
+    } else if (count==1) {
+      memcpy(out, tasks[0].hash, AOCODE_BLAKE3_OUT_LEN);
+    } else {
+      range_join(tasks, 0, count, 1, out);
+    }
+    free(tasks);
+  }
+  close(fd);
+  return err;
+}
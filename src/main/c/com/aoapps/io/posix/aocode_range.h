@@ -0,0 +1,54 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include "aocode_blake3.h"
+#ifndef _Included_aocode_range
+#define _Included_aocode_range
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The size of the ranges of a file read in parallel, a power of two chunks so each is a subtree of the hash
+#define AOCODE_RANGE_SIZE ((off_t)16*1024*1024)
+
+/*
+ * Compares the contents of two regular files, following symbolic links, split into ranges read with pread on the
+ * worker pool.  Only the ranges found by aocode_extent_diff are read.  Stops at the first difference found by any
+ * range.  Sets equal to 1 or 0.
+ * Returns 0, an errno, or AOCODE_NOT_REGULAR_FILE with errPath set to the file that failed.
+ */
+extern int aocode_range_compare(const char* path1, const char* path2, int* equal, const char** errPath);
+
+/*
+ * Hashes the contents of a regular file with BLAKE3, following symbolic links, split into ranges hashed on the
+ * worker pool and joined as subtrees of the hash tree.
+ * Returns 0, an errno, or AOCODE_NOT_REGULAR_FILE.
+ */
+extern int aocode_range_hash(const char* path, uint8_t out[AOCODE_BLAKE3_OUT_LEN]);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
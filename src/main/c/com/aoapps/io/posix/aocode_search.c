@@ -0,0 +1,334 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#define _GNU_SOURCE
+#include "aocode_search.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// The most files waiting to be scanned before the walker waits
+#define SEARCH_FILE_QUEUE 4096
+// The most results waiting for the consumer before the scanners wait
+#define SEARCH_PENDING_RESULTS 256
+// The most hits in one result, a file with more is split into several
+#define SEARCH_RESULT_HITS 4096
+
+// The state of one scanner while it scans one file
+typedef struct search_scan {
+  aocode_search* search;
+  const char* path;
+  aocode_search_result* result;
+} search_scan;
+
+// Records the first failure and stops the search, the lock must be held
+static void search_fail_locked(aocode_search* search, int err, const char* path) {
+  if (search->err==0) {
+    search->err=err;
+    search->errPath=path==NULL ? NULL : strdup(path);
+  }
+  search->cancel=1;
+  pthread_cond_broadcast(&search->changed);
+}
+
+static void search_fail(aocode_search* search, int err, const char* path) {
+  pthread_mutex_lock(&search->lock);
+  search_fail_locked(search, err, path);
+  pthread_mutex_unlock(&search->lock);
+}
+
+void aocode_search_free_results(aocode_search_result* results) {
+  while (results!=NULL) {
+    aocode_search_result* next=results->next;
+    free(results->path);
+    free(results->hits);
+    free(results);
+    results=next;
+  }
+}
+
+// Queues each regular file within the size limit, in walk order
+static int search_visit(aocode_walk_entry* entry, void* ctx) {
+  aocode_search* search=(aocode_search*)ctx;
+  if (__atomic_load_n(&search->cancel, __ATOMIC_RELAXED)) return ECANCELED;
+  const struct stat* st=&entry->stat.st;
+  if (
+    !S_ISREG(st->st_mode)
+    || st->st_size==0
+    || (search->maxSize>=0 && st->st_size>search->maxSize)
+  ) return 0;
+  char* path=strdup(entry->path);
+  if (path==NULL) return ENOMEM;
+  pthread_mutex_lock(&search->lock);
+  while (search->fileCount==SEARCH_FILE_QUEUE && !search->cancel) pthread_cond_wait(&search->changed, &search->lock);
+  if (search->cancel) {
+    pthread_mutex_unlock(&search->lock);
+    free(path);
+    return ECANCELED;
+  }
+  search->files[(search->fileHead+search->fileCount++)%SEARCH_FILE_QUEUE]=path;
+  pthread_cond_broadcast(&search->changed);
+  pthread_mutex_unlock(&search->lock);
+  return 0;
+}
+
+static void* search_walk_run(void* arg) {
+  aocode_search* search=(aocode_search*)arg;
+  int result=aocode_walk_tree(&search->walk, search->root);
+  pthread_mutex_lock(&search->lock);
+  if (result!=0 && !search->cancel) search_fail_locked(search, search->walk.err, search->walk.errPath);
+  search->walking=0;
+  pthread_cond_broadcast(&search->changed);
+  pthread_mutex_unlock(&search->lock);
+  return NULL;
+}
+
+// Hands a result to the consumer, waiting while it is behind, returns 0 or ECANCELED
+static int search_publish(aocode_search* search, aocode_search_result* result) {
+  pthread_mutex_lock(&search->lock);
+  while (search->resultCount>=SEARCH_PENDING_RESULTS && !search->cancel) pthread_cond_wait(&search->changed, &search->lock);
+  if (search->cancel) {
+    pthread_mutex_unlock(&search->lock);
+    aocode_search_free_results(result);
+    return ECANCELED;
+  }
+  if (search->resultsTail==NULL) search->results=result;
+  else search->resultsTail->next=result;
+  search->resultsTail=result;
+  search->resultCount++;
+  pthread_cond_broadcast(&search->changed);
+  pthread_mutex_unlock(&search->lock);
+  return 0;
+}
+
+static int search_hit(void* ctx, uint64_t offset, uint32_t pattern) {
+  search_scan* scan=(search_scan*)ctx;
+  aocode_search_result* result=scan->result;
+  if (result!=NULL && result->count==SEARCH_RESULT_HITS) {
+    scan->result=NULL;
+    int err=search_publish(scan->search, result);
+    if (err!=0) return err;
+    result=NULL;
+  }
+  if (result==NULL) {
+    result=(aocode_search_result*)calloc(1, sizeof(aocode_search_result));
+    if (result==NULL) return ENOMEM;
+    result->path=strdup(scan->path);
+    if (result->path==NULL) {
+      free(result);
+      return ENOMEM;
+    }
+    scan->result=result;
+  }
+  if (result->count==result->cap) {
+    size_t newCap=result->cap==0 ? 16 : result->cap<<1;
+    aocode_search_hit* newHits=(aocode_search_hit*)realloc(result->hits, newCap*sizeof(aocode_search_hit));
+    if (newHits==NULL) return ENOMEM;
+    result->hits=newHits;
+    result->cap=newCap;
+  }
+  aocode_search_hit* hit=&result->hits[result->count++];
+  hit->offset=offset;
+  hit->pattern=pattern;
+  return 0;
+}
+
+/*
+ * Scans one file from start to end, returns 0 or an errno.  Files removed or replaced by another type since being
+ * found are skipped.
+ */
+static int search_scan_file(aocode_search* search, const char* path, unsigned char* buff) {
+  // Does not update the access times of a sweep, when permitted
+  int flags=O_RDONLY|O_NOFOLLOW|O_NOCTTY|O_NONBLOCK|O_CLOEXEC;
+  int fd=open(path, flags|O_NOATIME);
+  if (fd==-1 && errno==EPERM) fd=open(path, flags);
+  if (fd==-1) return errno==ENOENT || errno==ELOOP ? 0 : errno;
+  struct stat st;
+  if (fstat(fd, &st)!=0) {
+    int err=errno;
+    close(fd);
+    return err;
+  }
+  if (!S_ISREG(st.st_mode)) {
+    close(fd);
+    return 0;
+  }
+  posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+  search_scan scan;
+  scan.search=search;
+  scan.path=path;
+  scan.result=NULL;
+  uint32_t state=0;
+  uint64_t offset=0;
+  int err=0;
+  while (!__atomic_load_n(&search->cancel, __ATOMIC_RELAXED)) {
+    ssize_t count=read(fd, buff, AOCODE_SEARCH_BUFFER_SIZE);
+    if (count==-1) {
+      if (errno==EINTR) continue;
+      err=errno;
+      break;
+    }
+    if (count==0) break;
+    err=aocode_match_scan(search->match, &state, offset, buff, count, search_hit, &scan);
+    if (err!=0) break;
+    offset+=count;
+  }
+  close(fd);
+  if (scan.result!=NULL) {
+    if (err==0) err=search_publish(search, scan.result);
+    else aocode_search_free_results(scan.result);
+  }
+  return err;
+}
+
+// Whether a failure to scan a file stops the search, since it would fail every other file too
+static int search_is_fatal(int err) {
+  return err==ENOMEM || err==EMFILE || err==ENFILE;
+}
+
+// Reports a file that could not be scanned, returns 0 or an errno that stops the search
+static int search_publish_error(aocode_search* search, const char* path, int err) {
+  aocode_search_result* result=(aocode_search_result*)calloc(1, sizeof(aocode_search_result));
+  if (result==NULL) return ENOMEM;
+  result->path=strdup(path);
+  if (result->path==NULL) {
+    free(result);
+    return ENOMEM;
+  }
+  result->err=err;
+  return search_publish(search, result);
+}
+
+static void* search_scan_run(void* arg) {
+  aocode_search* search=(aocode_search*)arg;
+  unsigned char* buff=(unsigned char*)malloc(AOCODE_SEARCH_BUFFER_SIZE);
+  if (buff==NULL) search_fail(search, ENOMEM, NULL);
+  pthread_mutex_lock(&search->lock);
+  while (buff!=NULL) {
+    while (search->fileCount==0 && search->walking && !search->cancel) pthread_cond_wait(&search->changed, &search->lock);
+    if (search->cancel || search->fileCount==0) break;
+    char* path=search->files[search->fileHead];
+    search->fileHead=(search->fileHead+1)%SEARCH_FILE_QUEUE;
+    search->fileCount--;
+    pthread_cond_broadcast(&search->changed);
+    pthread_mutex_unlock(&search->lock);
+    int err=search_scan_file(search, path, buff);
+    if (err!=0 && err!=ECANCELED && !search_is_fatal(err)) err=search_publish_error(search, path, err);
+    pthread_mutex_lock(&search->lock);
+    if (err!=0 && err!=ECANCELED) search_fail_locked(search, err, path);
+    free(path);
+  }
+  search->scanning--;
+  pthread_cond_broadcast(&search->changed);
+  pthread_mutex_unlock(&search->lock);
+  free(buff);
+  return NULL;
+}
+
+int aocode_search_start(aocode_search* search, const char* path, const aocode_match* match, off_t maxSize, int flags) {
+  memset(search, 0, sizeof(aocode_search));
+  search->match=match;
+  search->maxSize=maxSize;
+  pthread_mutex_init(&search->lock, NULL);
+  pthread_cond_init(&search->changed, NULL);
+  aocode_walk_init(&search->walk, search_visit, NULL, search, flags);
+  search->root=strdup(path);
+  search->files=(char**)malloc(SEARCH_FILE_QUEUE*sizeof(char*));
+  if (search->root==NULL || search->files==NULL) return ENOMEM;
+  long cpus=sysconf(_SC_NPROCESSORS_ONLN);
+  int wanted=cpus<2 ? 2 : cpus>AOCODE_SEARCH_MAX_SCANNERS ? AOCODE_SEARCH_MAX_SCANNERS : (int)cpus;
+  // Hold the lock so the scanners wait for the walker to be started
+  pthread_mutex_lock(&search->lock);
+  int err=0;
+  while (search->scannerCount<wanted) {
+    err=pthread_create(&search->scanners[search->scannerCount], NULL, search_scan_run, search);
+    if (err!=0) break;
+    search->scannerCount++;
+  }
+  if (search->scannerCount>0) {
+    err=pthread_create(&search->walker, NULL, search_walk_run, search);
+    if (err==0) search->walkerStarted=search->walking=1;
+  }
+  search->scanning=search->scannerCount;
+  if (!search->walking) search->cancel=1;
+  pthread_cond_broadcast(&search->changed);
+  pthread_mutex_unlock(&search->lock);
+  return search->walking ? 0 : err;
+}
+
+aocode_search_result* aocode_search_next(aocode_search* search) {
+  pthread_mutex_lock(&search->lock);
+  while (
+    search->results==NULL
+    && (search->walking || search->scanning>0)
+    && !search->cancel
+  ) pthread_cond_wait(&search->changed, &search->lock);
+  aocode_search_result* results=NULL;
+  if (!search->cancel) {
+    results=search->results;
+    search->results=NULL;
+    search->resultsTail=NULL;
+    search->resultCount=0;
+    pthread_cond_broadcast(&search->changed);
+  }
+  pthread_mutex_unlock(&search->lock);
+  return results;
+}
+
+void aocode_search_cancel(aocode_search* search) {
+  pthread_mutex_lock(&search->lock);
+  search->cancel=1;
+  pthread_cond_broadcast(&search->changed);
+  pthread_mutex_unlock(&search->lock);
+}
+
+void aocode_search_end(aocode_search* search) {
+  if (search->walkerStarted) pthread_join(search->walker, NULL);
+  search->walkerStarted=0;
+  int c;
+  for (c=0; c<search->scannerCount; c++) pthread_join(search->scanners[c], NULL);
+  search->scannerCount=0;
+  while (search->fileCount>0) {
+    free(search->files[search->fileHead]);
+    search->fileHead=(search->fileHead+1)%SEARCH_FILE_QUEUE;
+    search->fileCount--;
+  }
+  aocode_search_free_results(search->results);
+  search->results=NULL;
+  search->resultsTail=NULL;
+  search->resultCount=0;
+}
+
+void aocode_search_destroy(aocode_search* search) {
+  aocode_walk_destroy(&search->walk);
+  free(search->files);
+  search->files=NULL;
+  free(search->root);
+  search->root=NULL;
+  free(search->errPath);
+  search->errPath=NULL;
+  pthread_cond_destroy(&search->changed);
+  pthread_mutex_destroy(&search->lock);
+}
@@ -0,0 +1,114 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "aocode_match.h"
+#include "aocode_walk.h"
+#include <pthread.h>
+#include <stdint.h>
+#include <sys/types.h>
+#ifndef _Included_aocode_search
+#define _Included_aocode_search
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The size of the read buffer of each scanner
+#define AOCODE_SEARCH_BUFFER_SIZE (1024*1024)
+
+// The most scanner threads, which mostly wait on I/O
+#define AOCODE_SEARCH_MAX_SCANNERS 32
+
+// One match within a file
+typedef struct aocode_search_hit {
+  uint64_t offset;   // The offset of the first byte of the match
+  uint32_t pattern;  // The index of the pattern matched
+} aocode_search_hit;
+
+// The matches found in one file, a file with many matches may be split over several results
+typedef struct aocode_search_result {
+  struct aocode_search_result* next;
+  char* path;
+  int err;  // When not zero, the file could not be read and this result has no hits
+  size_t count;
+  size_t cap;
+  aocode_search_hit* hits;
+} aocode_search_result;
+
+/*
+ * Searches the contents of all regular files in a tree for many patterns at once.  A walker thread finds the files
+ * while scanner threads read them in large blocks through a shared matcher.  The results are collected for a single
+ * consumer thread, with the scanners waiting when the consumer falls behind.
+ *
+ * A file that cannot be opened or read is reported as a result with err set, and the search continues.  Only running
+ * out of memory or file descriptors, a failure of the walk, or cancel stop the search.
+ */
+typedef struct aocode_search {
+  const aocode_match* match;
+  off_t maxSize;         // Larger files are skipped, negative for no limit
+  int err;               // The first failure, set once ended
+  char* errPath;         // The path of the first failure
+  // Private
+  pthread_mutex_t lock;
+  pthread_cond_t changed;  // Signaled when any queue or state changes
+  int cancel;
+  aocode_walk walk;
+  char* root;
+  pthread_t walker;
+  int walkerStarted;
+  int walking;             // Cleared as the walker exits
+  char** files;            // The ring of files waiting to be scanned
+  size_t fileHead;
+  size_t fileCount;
+  pthread_t scanners[AOCODE_SEARCH_MAX_SCANNERS];
+  int scannerCount;
+  int scanning;            // The number of scanners still running
+  aocode_search_result* results;  // The results waiting for the consumer, in order found
+  aocode_search_result* resultsTail;
+  size_t resultCount;
+} aocode_search;
+
+/*
+ * Starts searching the tree at path, with the walk flags of aocode_walk.  The matcher must remain until the search
+ * is destroyed.  Returns 0 or an errno, aocode_search_end and aocode_search_destroy must be called either way.
+ */
+extern int aocode_search_start(aocode_search* search, const char* path, const aocode_match* match, off_t maxSize, int flags);
+
+/*
+ * Waits for the next results, returning NULL once the search has ended.  The results must be released with
+ * aocode_search_free_results.
+ */
+extern aocode_search_result* aocode_search_next(aocode_search* search);
+
+extern void aocode_search_free_results(aocode_search_result* results);
+
+// Stops the search early, the threads finish what they are doing and aocode_search_next returns NULL
+extern void aocode_search_cancel(aocode_search* search);
+
+// Waits for all threads to finish, err and errPath are then set on failure
+extern void aocode_search_end(aocode_search* search);
+
+extern void aocode_search_destroy(aocode_search* search);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
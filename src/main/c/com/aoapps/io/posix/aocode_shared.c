@@ -1,6 +1,6 @@
 /*
  * ao-io-posix - Java interface to native POSIX filesystem objects.
- * Copyright (C) 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007, 2008, 2009, 2010, 2011, 2015, 2016, 2021, 2022  AO Industries, Inc.
+ * Copyright (C) 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007, 2008, 2009, 2010, 2011, 2015, 2016, 2021, 2022, 2026  AO Industries, Inc.
  *     support@aoindustries.com
  *     7262 Bull Pen Cir
  *     Mobile, AL 36695
@@ -20,10 +20,19 @@
  * You should have received a copy of the GNU Lesser General Public License
  * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
  */
+#define _GNU_SOURCE
 #include <jni.h>
 #include <errno.h>
-//include <stdlib.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/sysmacros.h>
+#include <sys/types.h>
+#include <unistd.h>
 #include "aocode_shared.h"
 
 extern int errno;
@@ -33,6 +42,7 @@ const char* getErrorType(const int err) {
   const char* errString;
   if (err==EACCES) errString=SECURITY_EXCEPTION;
   else if (err==EBADF) errString=IO_EXCEPTION;
+  else if (err==ECONNRESET) errString=IO_EXCEPTION;
   else if (err==EEXIST) errString=IO_EXCEPTION;
   else if (err==EFAULT) errString=RUNTIME_EXCEPTION;
   else if (err==EINTR) errString=INTERRUPTED_IO_EXCEPTION;
@@ -46,9 +56,248 @@ const char* getErrorType(const int err) {
   else if (err==ENOSPC) errString=IO_EXCEPTION;
   else if (err==ENOSYS) errString=NO_SUCH_METHOD_EXCEPTION;
   else if (err==ENOTDIR) errString=IO_EXCEPTION;
+  else if (err==ENOTTY) errString=IO_EXCEPTION;
+  else if (err==EOPNOTSUPP) errString=IO_EXCEPTION;
   else if (err==EPERM) errString=SECURITY_EXCEPTION;
+  else if (err==EPIPE) errString=IO_EXCEPTION;
   else if (err==EROFS) errString=IO_EXCEPTION;
+  else if (err==ESTALE) errString=FILE_NOT_FOUND_EXCEPTION;
   else if (err==EXDEV) errString=IO_EXCEPTION;
   else errString=RUNTIME_EXCEPTION;
   return errString;
 }
+
+void throwErrno(JNIEnv* env, const int err, const char* path) {
+  jclass newExcCls=(*env)->FindClass(env, getErrorType(err));
+  if (newExcCls!=NULL) {
+    const char* message=strerror(err);
+    if (path!=NULL) {
+      size_t len=strlen(path)+strlen(message)+3;
+      char* buff=(char*)malloc(len);
+      if (buff!=NULL) {
+        snprintf(buff, len, "%s: %s", path, message);
+        (*env)->ThrowNew(env, newExcCls, buff);
+        free(buff);
+        return;
+      }
+    }
+    (*env)->ThrowNew(env, newExcCls, message);
+  }
+}
+
+int aocode_fstatat(int dirfd, const char* name, aocode_stat* buf, int flags) {
+#ifdef STATX_BASIC_STATS
+  // Remembers when the kernel does not support statx so the fallback is used directly
+  static volatile int statxMissing=0;
+  if (!statxMissing) {
+    struct statx stx;
+    if (statx(dirfd, name, flags, STATX_BASIC_STATS, &stx)==0) {
+      memset(&buf->st, 0, sizeof(struct stat));
+      buf->st.st_dev     = makedev(stx.stx_dev_major, stx.stx_dev_minor);
+      buf->st.st_ino     = stx.stx_ino;
+      buf->st.st_mode    = stx.stx_mode;
+      buf->st.st_nlink   = stx.stx_nlink;
+      buf->st.st_uid     = stx.stx_uid;
+      buf->st.st_gid     = stx.stx_gid;
+      buf->st.st_rdev    = makedev(stx.stx_rdev_major, stx.stx_rdev_minor);
+      buf->st.st_size    = stx.stx_size;
+      buf->st.st_blksize = stx.stx_blksize;
+      buf->st.st_blocks  = stx.stx_blocks;
+      buf->st.st_atime   = stx.stx_atime.tv_sec;
+      buf->st.st_mtime   = stx.stx_mtime.tv_sec;
+      buf->st.st_ctime   = stx.stx_ctime.tv_sec;
+      buf->attributes     = stx.stx_attributes;
+      buf->attributesMask = stx.stx_attributes_mask;
+      return 0;
+    }
+    if (errno!=ENOSYS) return -1;
+    statxMissing=1;
+  }
+#endif
+  if (fstatat(dirfd, name, &buf->st, flags & ~AT_NO_AUTOMOUNT)!=0) return -1;
+  buf->attributes=0;
+  buf->attributesMask=0;
+  return 0;
+}
+
+#ifndef __NR_openat2
+#define __NR_openat2 437
+#endif
+
+// The arguments of openat2(2), which is too new for most C libraries to declare
+struct aocode_open_how {
+  uint64_t flags;
+  uint64_t mode;
+  uint64_t resolve;
+};
+
+#define AOCODE_RESOLVE_NO_SYMLINKS 0x04
+
+/*
+ * Opens each directory along the way with O_NOFOLLOW, for kernels without openat2.
+ */
+static int openNoSymlinksChain(const char* path, int flags) {
+  int dirfd=AT_FDCWD;
+  const char* name=path;
+  if (*name=='/') {
+    while (*name=='/') name++;
+    dirfd=open("/", O_PATH|O_DIRECTORY|O_CLOEXEC);
+    if (dirfd==-1) return -1;
+  }
+  while (1) {
+    const char* slash=strchr(name, '/');
+    if (slash==NULL) break;
+    size_t len=slash-name;
+    if (len>0) {
+      if (len>NAME_MAX) {
+        if (dirfd!=AT_FDCWD) close(dirfd);
+        errno=ENAMETOOLONG;
+        return -1;
+      }
+      char component[NAME_MAX+1];
+      memcpy(component, name, len);
+      component[len]='\0';
+      // O_PATH with O_NOFOLLOW opens a symbolic link itself, which fstat then detects
+      int fd=openat(dirfd, component, O_PATH|O_NOFOLLOW|O_CLOEXEC);
+      int err=errno;
+      if (fd!=-1) {
+        struct stat st;
+        if (fstat(fd, &st)!=0) err=errno;
+        else if (S_ISLNK(st.st_mode)) err=ELOOP;
+        else if (!S_ISDIR(st.st_mode)) err=ENOTDIR;
+        else err=0;
+        if (err!=0) {
+          close(fd);
+          fd=-1;
+        }
+      }
+      if (dirfd!=AT_FDCWD) close(dirfd);
+      if (fd==-1) {
+        errno=err;
+        return -1;
+      }
+      dirfd=fd;
+    }
+    name=slash+1;
+  }
+  // A trailing slash opens the directory itself
+  int fd=openat(dirfd, *name=='\0' ? "." : name, flags|O_NOFOLLOW|O_CLOEXEC);
+  int err=errno;
+  if (dirfd!=AT_FDCWD) close(dirfd);
+  errno=err;
+  return fd;
+}
+
+int aocode_open_nosymlinks(const char* path, int flags) {
+  // Remembers when the kernel does not support openat2 so the fallback is used directly
+  static volatile int openat2Missing=0;
+  if (!openat2Missing) {
+    struct aocode_open_how how;
+    memset(&how, 0, sizeof(how));
+    how.flags=(uint64_t)(flags|O_NOFOLLOW|O_CLOEXEC);
+    how.resolve=AOCODE_RESOLVE_NO_SYMLINKS;
+    int fd;
+    do {
+      fd=(int)syscall(__NR_openat2, AT_FDCWD, path, &how, sizeof(how));
+    } while (fd==-1 && errno==EINTR);
+    // Also blocked by some seccomp filters
+    if (fd!=-1 || (errno!=ENOSYS && errno!=EPERM)) return fd;
+    openat2Missing=1;
+  }
+  int fd;
+  do {
+    fd=openNoSymlinksChain(path, flags);
+  } while (fd==-1 && errno==EINTR);
+  return fd;
+}
+
+jobject newStat(JNIEnv* env, const aocode_stat* buf) {
+  jobject stat=NULL;
+  jclass statClass=(*env)->FindClass(env, "com/aoapps/io/posix/Stat");
+  if (statClass!=NULL) {
+    jmethodID constructor=(*env)->GetMethodID(env, statClass, "<init>", "(ZJJJIIIJJIJJJJJJ)V");
+    if (constructor!=NULL) {
+      stat=(*env)->NewObject(
+        env,
+        statClass,
+        constructor,
+        JNI_TRUE,
+        (jlong)buf->st.st_dev,
+        (jlong)buf->st.st_ino,
+        (jlong)buf->st.st_mode,
+        (jint)buf->st.st_nlink,
+        (jint)buf->st.st_uid,
+        (jint)buf->st.st_gid,
+        (jlong)buf->st.st_rdev,
+        (jlong)buf->st.st_size,
+        (jint)buf->st.st_blksize,
+        (jlong)buf->st.st_blocks,
+        ((jlong)(buf->st.st_atime))*1000,
+        ((jlong)(buf->st.st_mtime))*1000,
+        ((jlong)(buf->st.st_ctime))*1000,
+        (jlong)buf->attributes,
+        (jlong)buf->attributesMask
+      );
+    }
+    (*env)->DeleteLocalRef(env, statClass);
+  }
+  return stat;
+}
+
+jobject newFileDescriptor(JNIEnv* env, int fd) {
+  jobject fileDescriptor=NULL;
+  jclass fdClass=(*env)->FindClass(env, "java/io/FileDescriptor");
+  if (fdClass!=NULL) {
+    jmethodID constructor=(*env)->GetMethodID(env, fdClass, "<init>", "()V");
+    if (constructor!=NULL) {
+      // The private field is set directly, as done by the JDK itself
+      jfieldID field=(*env)->GetFieldID(env, fdClass, "fd", "I");
+      if (field!=NULL) {
+        fileDescriptor=(*env)->NewObject(env, fdClass, constructor);
+        if (fileDescriptor!=NULL) (*env)->SetIntField(env, fileDescriptor, field, fd);
+      }
+    }
+    (*env)->DeleteLocalRef(env, fdClass);
+  }
+  return fileDescriptor;
+}
+
+int getFileDescriptor(JNIEnv* env, jobject fileDescriptor) {
+  int fd=-1;
+  jclass fdClass=(*env)->FindClass(env, "java/io/FileDescriptor");
+  if (fdClass!=NULL) {
+    jfieldID field=(*env)->GetFieldID(env, fdClass, "fd", "I");
+    if (field!=NULL) {
+      fd=(*env)->GetIntField(env, fileDescriptor, field);
+      if (fd<0) {
+        jclass excCls=(*env)->FindClass(env, IO_EXCEPTION);
+        if (excCls!=NULL) (*env)->ThrowNew(env, excCls, "File descriptor is closed");
+      }
+    }
+    (*env)->DeleteLocalRef(env, fdClass);
+  }
+  return fd;
+}
+
+jint registerNatives(JNIEnv* env, const char* className, const JNINativeMethod* methods, jint count) {
+  jclass cls=(*env)->FindClass(env, className);
+  if (cls==NULL) return JNI_ERR;
+  jint result=(*env)->RegisterNatives(env, cls, methods, count);
+  (*env)->DeleteLocalRef(env, cls);
+  return result==0 ? JNI_OK : JNI_ERR;
+}
+
+/*
+ * Binds all native methods directly when the library is loaded, avoiding the lookup of each
+ * mangled symbol name on first call.
+ */
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void* reserved) {
+  JNIEnv* env;
+  if ((*vm)->GetEnv(vm, (void**)&env, JNI_VERSION_1_6)!=JNI_OK) return JNI_ERR;
+  if (registerFileHandleCacheNatives(env)!=JNI_OK) return JNI_ERR;
+  if (registerMappedRegionNatives(env)!=JNI_OK) return JNI_ERR;
+  if (registerPosixFileNatives(env)!=JNI_OK) return JNI_ERR;
+  if (registerPosixFileHandleNatives(env)!=JNI_OK) return JNI_ERR;
+  if (registerDevRandomNatives(env)!=JNI_OK) return JNI_ERR;
+  return JNI_VERSION_1_6;
+}
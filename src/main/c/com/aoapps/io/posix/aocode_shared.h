@@ -1,6 +1,6 @@
 /*
  * ao-io-posix - Java interface to native POSIX filesystem objects.
- * Copyright (C) 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007, 2008, 2009, 2010, 2011, 2015, 2016, 2021  AO Industries, Inc.
+ * Copyright (C) 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007, 2008, 2009, 2010, 2011, 2015, 2016, 2021, 2026  AO Industries, Inc.
  *     support@aoindustries.com
  *     7262 Bull Pen Cir
  *     Mobile, AL 36695
@@ -21,6 +21,8 @@
  * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
  */
 #include <jni.h>
+#include <stdint.h>
+#include <sys/stat.h>
 #ifndef _Included_aocode_shared
 #define _Included_aocode_shared
 #ifdef __cplusplus
@@ -36,6 +38,45 @@ static const char* RUNTIME_EXCEPTION="java/lang/RuntimeException";
 static const char* SECURITY_EXCEPTION="java/lang/SecurityException";
 
 extern const char* getErrorType(const int err);
+
+// Throws the exception for the provided errno, prefixing the message with the path when not NULL
+extern void throwErrno(JNIEnv* env, const int err, const char* path);
+
+// The result of one stat call, including the statx attributes when available
+typedef struct aocode_stat {
+  struct stat st;
+  uint64_t attributes;
+  uint64_t attributesMask;
+} aocode_stat;
+
+// Performs a statx when available, falling back to fstatat.  Returns 0 on success or -1 with errno set.
+extern int aocode_fstatat(int dirfd, const char* name, aocode_stat* buf, int flags);
+
+/*
+ * Opens a file as openat(AT_FDCWD, path, flags|O_NOFOLLOW|O_CLOEXEC), but fails with ELOOP when any component of the
+ * path is a symbolic link.  Uses openat2 when available, otherwise opens each directory along the way.
+ * Returns the file descriptor or -1 with errno set.
+ */
+extern int aocode_open_nosymlinks(const char* path, int flags);
+
+// Creates a new com.aoapps.io.posix.Stat, returns NULL with an exception pending on failure
+extern jobject newStat(JNIEnv* env, const aocode_stat* buf);
+
+// Creates a new java.io.FileDescriptor owning the provided file descriptor, returns NULL with an exception pending on failure
+extern jobject newFileDescriptor(JNIEnv* env, int fd);
+
+// Gets the file descriptor of a java.io.FileDescriptor, returns -1 with an exception pending on failure
+extern int getFileDescriptor(JNIEnv* env, jobject fileDescriptor);
+
+// Registers the native methods of one class, returns JNI_OK or JNI_ERR with an exception pending
+extern jint registerNatives(JNIEnv* env, const char* className, const JNINativeMethod* methods, jint count);
+
+// The registrations for each class, called from JNI_OnLoad
+extern jint registerFileHandleCacheNatives(JNIEnv* env);
+extern jint registerMappedRegionNatives(JNIEnv* env);
+extern jint registerPosixFileNatives(JNIEnv* env);
+extern jint registerPosixFileHandleNatives(JNIEnv* env);
+extern jint registerDevRandomNatives(JNIEnv* env);
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,375 @@
+#define _GNU_SOURCE
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "aocode_symlink.h"
+#include <errno.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// The outcome of resolving one link
+typedef struct symlink_memo {
+  dev_t dev;
+  ino_t ino;
+  char* path;      // The canonical path of the link itself
+  char* target;    // The contents of the link
+  char* resolved;  // The canonical path it resolves to, NULL unless AOCODE_SYMLINK_OK
+  int err;         // The errno when the contents could not be read
+  int status;      // The classification, or one of the MEMO_* states
+  int links;       // The links followed to resolve it, including itself
+} symlink_memo;
+
+// Still being resolved, so reaching it again is a cycle
+#define MEMO_RESOLVING (-1)
+// Not yet resolved, or last resolved too deep in another chain to be known on its own
+#define MEMO_UNKNOWN (-2)
+
+// A path being built one component at a time
+typedef struct symlink_path {
+  char* buf;
+  size_t len;
+  size_t cap;
+} symlink_path;
+
+static int path_set(symlink_path* path, const char* value, size_t len) {
+  if (len+1>path->cap) {
+    size_t cap=path->cap==0 ? PATH_MAX : path->cap;
+    while (len+1>cap) cap*=2;
+    char* buf=(char*)realloc(path->buf, cap);
+    if (buf==NULL) return -1;
+    path->buf=buf;
+    path->cap=cap;
+  }
+  memcpy(path->buf, value, len);
+  path->buf[len]='\0';
+  path->len=len;
+  return 0;
+}
+
+static int path_append(symlink_path* path, const char* name, size_t nameLen) {
+  size_t len=path->len;
+  // The root is kept as the empty string while building
+  if (len+1+nameLen+1>path->cap) {
+    size_t cap=path->cap==0 ? PATH_MAX : path->cap;
+    while (len+1+nameLen+1>cap) cap*=2;
+    char* buf=(char*)realloc(path->buf, cap);
+    if (buf==NULL) return -1;
+    path->buf=buf;
+    path->cap=cap;
+  }
+  path->buf[len]='/';
+  memcpy(path->buf+len+1, name, nameLen);
+  path->len=len+1+nameLen;
+  path->buf[path->len]='\0';
+  return 0;
+}
+
+static size_t memo_hash(dev_t dev, ino_t ino, size_t cap) {
+  uint64_t h=((uint64_t)dev*0x9e3779b97f4a7c15ULL) ^ ((uint64_t)ino*0xc2b2ae3d27d4eb4fULL);
+  return (size_t)(h ^ (h>>29)) & (cap-1);
+}
+
+static symlink_memo* memo_find(aocode_symlink* symlink, dev_t dev, ino_t ino) {
+  if (symlink->memoCap==0) return NULL;
+  size_t i=memo_hash(dev, ino, symlink->memoCap);
+  symlink_memo* memo;
+  while ((memo=symlink->memos[i])!=NULL) {
+    if (memo->dev==dev && memo->ino==ino) return memo;
+    i=(i+1) & (symlink->memoCap-1);
+  }
+  return NULL;
+}
+
+// Takes ownership of memo, returns 0 or -1 with errno set
+static int memo_add(aocode_symlink* symlink, symlink_memo* memo) {
+  // Kept at most half full
+  if ((symlink->memoCount+1)*2>symlink->memoCap) {
+    size_t cap=symlink->memoCap==0 ? 1024 : symlink->memoCap*2;
+    symlink_memo** memos=(symlink_memo**)calloc(cap, sizeof(symlink_memo*));
+    if (memos==NULL) return -1;
+    size_t i;
+    for (i=0; i<symlink->memoCap; i++) {
+      symlink_memo* old=symlink->memos[i];
+      if (old!=NULL) {
+        size_t j=memo_hash(old->dev, old->ino, cap);
+        while (memos[j]!=NULL) j=(j+1) & (cap-1);
+        memos[j]=old;
+      }
+    }
+    free(symlink->memos);
+    symlink->memos=memos;
+    symlink->memoCap=cap;
+  }
+  size_t i=memo_hash(memo->dev, memo->ino, symlink->memoCap);
+  while (symlink->memos[i]!=NULL) i=(i+1) & (symlink->memoCap-1);
+  symlink->memos[i]=memo;
+  symlink->memoCount++;
+  return 0;
+}
+
+static void memo_free(symlink_memo* memo) {
+  free(memo->path);
+  free(memo->target);
+  free(memo->resolved);
+  free(memo);
+}
+
+// Reads the contents of a link into a new string, returns NULL with errno set on failure
+static char* read_link(const char* path, const struct stat* st) {
+  size_t size=st->st_size>0 && st->st_size<PATH_MAX ? (size_t)st->st_size+1 : PATH_MAX;
+  for (;;) {
+    char* target=(char*)malloc(size);
+    if (target==NULL) return NULL;
+    ssize_t len=readlink(path, target, size);
+    if (len==-1) {
+      free(target);
+      return NULL;
+    }
+    if ((size_t)len<size) {
+      target[len]='\0';
+      return target;
+    }
+    // Changed since the lstat
+    free(target);
+    size*=2;
+  }
+}
+
+static int resolve_link(aocode_symlink* symlink, const char* path, const struct stat* st, int depth, int* links, char** resolved);
+
+/*
+ * Resolves a path, relative to the canonical directory base when not absolute, following all links.  Sets resolved
+ * to a new canonical path when AOCODE_SYMLINK_OK.  Returns the classification, or -1 with errno set.
+ */
+static int resolve_path(aocode_symlink* symlink, const char* base, const char* target, int depth, int* links, char** resolved) {
+  symlink_path path={NULL, 0, 0};
+  if (path_set(&path, "", 0)!=0) return -1;
+  if (target[0]!='/' && strcmp(base, "/")!=0 && path_set(&path, base, strlen(base))!=0) {
+    free(path.buf);
+    return -1;
+  }
+  int status=AOCODE_SYMLINK_OK;
+  const char* pos=target;
+  while (status==AOCODE_SYMLINK_OK) {
+    while (*pos=='/') pos++;
+    if (*pos=='\0') break;
+    const char* end=pos;
+    while (*end!='\0' && *end!='/') end++;
+    size_t nameLen=(size_t)(end-pos);
+    // Anything after, even a trailing slash, requires a directory
+    int needDir=*end=='/';
+    if (nameLen==1 && pos[0]=='.') {
+      // Nothing to do
+    } else if (nameLen==2 && pos[0]=='.' && pos[1]=='.') {
+      // Already canonical, so the parent is simply the path without its last component
+      char* slash=strrchr(path.buf, '/');
+      if (slash!=NULL) {
+        *slash='\0';
+        path.len=(size_t)(slash-path.buf);
+      }
+    } else {
+      if (path_append(&path, pos, nameLen)!=0) {
+        status=-1;
+        break;
+      }
+      struct stat st;
+      if (lstat(path.buf, &st)!=0) {
+        if (errno==ENOMEM) status=-1;
+        else status=AOCODE_SYMLINK_BROKEN;
+      } else if (S_ISLNK(st.st_mode)) {
+        char* linkResolved;
+        status=resolve_link(symlink, path.buf, &st, depth+1, links, &linkResolved);
+        if (status==AOCODE_SYMLINK_OK) {
+          // A link to the root resolves to the empty string while building
+          int err=path_set(&path, linkResolved, strcmp(linkResolved, "/")==0 ? 0 : strlen(linkResolved));
+          free(linkResolved);
+          if (err!=0) status=-1;
+        }
+      } else if (needDir && !S_ISDIR(st.st_mode)) {
+        status=AOCODE_SYMLINK_BROKEN;
+      }
+    }
+    pos=end;
+  }
+  if (status==AOCODE_SYMLINK_OK) {
+    if (path.len==0 && path_set(&path, "/", 1)!=0) status=-1;
+    else {
+      *resolved=path.buf;
+      return status;
+    }
+  }
+  int err=errno;
+  free(path.buf);
+  errno=err;
+  return status;
+}
+
+/*
+ * Resolves the link at the canonical path with its lstat, adding the links followed to links.
+ * Returns the classification, or -1 with errno set.
+ */
+static int resolve_link(aocode_symlink* symlink, const char* path, const struct stat* st, int depth, int* links, char** resolved) {
+  if (depth>AOCODE_SYMLINK_MAX) {
+    // The links below here on the stack were cut short, so their outcomes are not remembered
+    symlink->truncated++;
+    return AOCODE_SYMLINK_LOOP;
+  }
+  symlink_memo* memo=memo_find(symlink, st->st_dev, st->st_ino);
+  if (memo!=NULL) {
+    if (strcmp(memo->path, path)!=0) {
+      // Another name for the same link, resolved without being remembered
+      memo=NULL;
+    } else if (memo->status==MEMO_RESOLVING) {
+      return AOCODE_SYMLINK_LOOP;
+    } else if (memo->status!=MEMO_UNKNOWN) {
+      *links+=memo->links;
+      if (*links>AOCODE_SYMLINK_MAX) return AOCODE_SYMLINK_LOOP;
+      if (memo->status==AOCODE_SYMLINK_OK) {
+        *resolved=strdup(memo->resolved);
+        if (*resolved==NULL) return -1;
+      }
+      return memo->status;
+    }
+  } else {
+    memo=(symlink_memo*)calloc(1, sizeof(symlink_memo));
+    if (memo==NULL) return -1;
+    memo->dev=st->st_dev;
+    memo->ino=st->st_ino;
+    memo->status=MEMO_UNKNOWN;
+    memo->path=strdup(path);
+    if (memo->path==NULL || memo_add(symlink, memo)!=0) {
+      int err=errno;
+      memo_free(memo);
+      errno=err;
+      return -1;
+    }
+  }
+  char* target=NULL;
+  if (memo!=NULL && memo->target!=NULL) {
+    target=memo->target;
+  } else {
+    target=read_link(path, st);
+    if (target==NULL && errno==ENOMEM) return -1;
+    if (memo!=NULL) {
+      memo->target=target;
+      memo->err=errno;
+    }
+  }
+  int status;
+  int followed=0;
+  char* linkResolved=NULL;
+  size_t truncated=symlink->truncated;
+  if (target==NULL) {
+    status=AOCODE_SYMLINK_BROKEN;
+  } else {
+    if (memo!=NULL) memo->status=MEMO_RESOLVING;
+    // The directory of a canonical path is canonical
+    const char* slash=strrchr(path, '/');
+    char* base=slash==NULL || slash==path ? strdup("/") : strndup(path, (size_t)(slash-path));
+    if (base==NULL) status=-1;
+    else {
+      status=resolve_path(symlink, base, target, depth, &followed, &linkResolved);
+      free(base);
+    }
+    if (memo==NULL) free(target);
+    if (status==-1) {
+      if (memo!=NULL) memo->status=MEMO_UNKNOWN;
+      return -1;
+    }
+  }
+  followed++;
+  if (status==AOCODE_SYMLINK_OK && followed>AOCODE_SYMLINK_MAX) {
+    free(linkResolved);
+    linkResolved=NULL;
+    status=AOCODE_SYMLINK_LOOP;
+  }
+  if (memo!=NULL) {
+    if (symlink->truncated!=truncated) {
+      memo->status=MEMO_UNKNOWN;
+    } else {
+      memo->links=followed;
+      if (linkResolved!=NULL) {
+        memo->resolved=strdup(linkResolved);
+        if (memo->resolved==NULL) {
+          memo->status=MEMO_UNKNOWN;
+          free(linkResolved);
+          return -1;
+        }
+      }
+      memo->status=status;
+    }
+  }
+  *links+=followed;
+  if (status==AOCODE_SYMLINK_OK && *links>AOCODE_SYMLINK_MAX) {
+    free(linkResolved);
+    return AOCODE_SYMLINK_LOOP;
+  }
+  if (status==AOCODE_SYMLINK_OK) *resolved=linkResolved;
+  return status;
+}
+
+int aocode_symlink_init(aocode_symlink* symlink, const char* root) {
+  memset(symlink, 0, sizeof(aocode_symlink));
+  symlink->root=realpath(root, NULL);
+  if (symlink->root==NULL) return errno;
+  symlink->rootLen=strlen(symlink->root);
+  return 0;
+}
+
+int aocode_symlink_classify(aocode_symlink* symlink, const char* path, const struct stat* st, const char** target) {
+  int links=0;
+  char* resolved=NULL;
+  int status=resolve_link(symlink, path, st, 0, &links, &resolved);
+  if (status==-1) return -1;
+  // Hard links share their contents, so the remembered contents of any name will do
+  symlink_memo* memo=memo_find(symlink, st->st_dev, st->st_ino);
+  if (memo->target==NULL) {
+    free(resolved);
+    errno=memo->err;
+    return -1;
+  }
+  *target=memo->target;
+  if (status==AOCODE_SYMLINK_OK) {
+    // Within the root when equal to it or below it
+    if (
+      symlink->rootLen>1
+      && !(strncmp(resolved, symlink->root, symlink->rootLen)==0
+        && (resolved[symlink->rootLen]=='\0' || resolved[symlink->rootLen]=='/'))
+    ) {
+      status=AOCODE_SYMLINK_ESCAPE;
+    }
+  }
+  free(resolved);
+  return status;
+}
+
+void aocode_symlink_destroy(aocode_symlink* symlink) {
+  size_t i;
+  for (i=0; i<symlink->memoCap; i++) {
+    if (symlink->memos[i]!=NULL) memo_free(symlink->memos[i]);
+  }
+  free(symlink->memos);
+  free(symlink->root);
+}
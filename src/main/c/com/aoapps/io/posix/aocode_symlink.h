@@ -0,0 +1,72 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <stddef.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#ifndef _Included_aocode_symlink
+#define _Included_aocode_symlink
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Symbolic link classifications, must match com.aoapps.io.posix.SymlinkHandler
+#define AOCODE_SYMLINK_OK     0  // Resolves to an existing file within the root
+#define AOCODE_SYMLINK_BROKEN 1  // The target, or a directory along the way, does not exist or cannot be searched
+#define AOCODE_SYMLINK_LOOP   2  // Resolving requires following more than AOCODE_SYMLINK_MAX links, including any cycle
+#define AOCODE_SYMLINK_ESCAPE 3  // Resolves to an existing file outside the root
+
+// The most links followed in one resolution, matching the kernel's limit before ELOOP
+#define AOCODE_SYMLINK_MAX 40
+
+/*
+ * Resolves chains of symbolic links entirely in user space, one lstat per path component, remembering the outcome of
+ * every link by its (dev, ino) so each link is read and resolved only once no matter how many chains pass through it.
+ * The outcome of a link depends on where it is, so a remembered outcome is only reused for the same canonical path,
+ * which keeps hard-linked symbolic links and bind mounts correct.
+ */
+typedef struct aocode_symlink {
+  char* root;        // The canonical root that links must resolve within
+  size_t rootLen;
+  // Private
+  struct symlink_memo** memos;  // Open addressing by (dev, ino)
+  size_t memoCap;
+  size_t memoCount;
+  size_t truncated;             // Counts resolutions cut short by AOCODE_SYMLINK_MAX
+} aocode_symlink;
+
+// Canonicalizes the root, returns 0 or an errno, aocode_symlink_destroy must be called either way
+extern int aocode_symlink_init(aocode_symlink* symlink, const char* root);
+
+/*
+ * Classifies the symbolic link at the canonical path with its lstat, setting target to its contents, which are
+ * owned by the resolver.  Returns one of the AOCODE_SYMLINK_* classifications, or -1 with errno set when the link
+ * itself could not be read or memory was exhausted.
+ */
+extern int aocode_symlink_classify(aocode_symlink* symlink, const char* path, const struct stat* st, const char** target);
+
+extern void aocode_symlink_destroy(aocode_symlink* symlink);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
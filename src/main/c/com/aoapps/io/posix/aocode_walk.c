@@ -0,0 +1,929 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#define _GNU_SOURCE
+#include <jni.h>
+#include "aocode_shared.h"
+#include "aocode_walk.h"
+#include "jni_util.h"
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef STATX_ATTR_MOUNT_ROOT
+#define STATX_ATTR_MOUNT_ROOT 0x00002000
+#endif
+
+// One directory entry read before any of them are processed
+typedef struct walk_dirent {
+  ino_t ino;
+  size_t nameOff;
+} walk_dirent;
+
+// The number of helper threads and how far ahead of the walk they may stat
+#define WALK_PREFETCH_THREADS 4
+#define WALK_PREFETCH_WINDOW 128
+// How much of each subdirectory is read ahead
+#define WALK_PREFETCH_DIR_BYTES 32768
+
+// The prefetch states of one entry
+#define WALK_SLOT_FREE 0     // Not yet claimed
+#define WALK_SLOT_CLAIMED 1  // Being stat'ed by a helper
+#define WALK_SLOT_DONE 2     // Stat'ed by a helper, waiting for the walk
+#define WALK_SLOT_TAKEN 3    // Reached by the walk, or must not be touched by helpers
+
+// The prefetched stat of one entry
+typedef struct walk_slot {
+  int state;
+  int err;
+  aocode_stat stat;
+} walk_slot;
+
+// All the entries of one directory
+typedef struct walk_batch {
+  walk_dirent* entries;
+  size_t count;
+  size_t cap;
+  char* names;
+  size_t namesLen;
+  size_t namesCap;
+  // Prefetch, guarded by the prefetch lock
+  int fd;               // The directory, for the helpers
+  walk_slot* slots;
+  size_t next;          // The next entry a helper may claim
+  size_t consumer;      // The entry the walk is processing, the start of the window
+  int busy;             // The number of helpers working on this batch
+} walk_batch;
+
+// The helper threads shared by one walk
+typedef struct walk_prefetch {
+  pthread_mutex_t lock;
+  pthread_cond_t work;  // Signaled when entries may be claimed
+  pthread_cond_t done;  // Signaled when a helper finishes an entry
+  walk_batch* batch;    // The batch being walked, NULL when none
+  int stop;
+  int threadCount;
+  pthread_t threads[WALK_PREFETCH_THREADS];
+  const aocode_walk* walk;
+} walk_prefetch;
+
+// How often the position is written to the checkpoint
+#define WALK_CHECKPOINT_MILLIS 1000
+// Identifies a checkpoint file and its format
+static const char WALK_CHECKPOINT_MAGIC[8]={'A', 'O', 'W', 'A', 'L', 'K', 'C', '1'};
+// The walk flags that change the order of a walk and must match to resume
+#define WALK_CHECKPOINT_FLAGS (AOCODE_WALK_ONE_FILE_SYSTEM | AOCODE_WALK_INODE_ORDER)
+// The resume depth once all resumed directories have been left
+#define WALK_NOT_RESUMING ((size_t)-1)
+
+// One directory being walked, the directory at depth N is frame N
+typedef struct walk_frame {
+  dev_t dev;
+  ino_t ino;
+  const walk_batch* batch;
+  size_t done;  // The number of entries of the batch finished
+} walk_frame;
+
+// One directory of the checkpoint being resumed from
+typedef struct walk_resume {
+  dev_t dev;
+  ino_t ino;
+  ino_t lastIno;
+  char* lastName;  // The last entry finished, NULL when none
+} walk_resume;
+
+// The traversal position of a checkpointed walk
+typedef struct walk_cursor {
+  char* tmpPath;
+  walk_frame* frames;
+  size_t depth;
+  size_t cap;
+  walk_resume* resume;
+  size_t resumeCount;
+  size_t resumeDepth;  // The depth of the only directory that may continue the resume
+  struct timespec next;
+  unsigned char* buff;
+  size_t buffCap;
+} walk_cursor;
+
+void aocode_walk_init(aocode_walk* walk, aocode_walk_visit pre, aocode_walk_visit post, void* ctx, int flags) {
+  memset(walk, 0, sizeof(aocode_walk));
+  walk->pre=pre;
+  walk->post=post;
+  walk->ctx=ctx;
+  walk->flags=flags;
+}
+
+void aocode_walk_destroy(aocode_walk* walk) {
+  free(walk->path);
+  walk->path=NULL;
+  free(walk->errPath);
+  walk->errPath=NULL;
+  free(walk->skippedPath);
+  walk->skippedPath=NULL;
+  size_t c;
+  for (c=0; c<walk->mountCount; c++) free(walk->mounts[c]);
+  free(walk->mounts);
+  walk->mounts=NULL;
+  walk->mountCount=0;
+}
+
+void aocode_walk_throw(JNIEnv* env, const aocode_walk* walk) {
+  if (walk->err==AOCODE_WALK_BAD_CHECKPOINT) {
+    const char* path=walk->errPath==NULL ? "" : walk->errPath;
+    size_t len=strlen(path)+64;
+    char* message=(char*)malloc(len);
+    if (message==NULL) {
+      JNU_ThrowOutOfMemoryError(env, NULL);
+      return;
+    }
+    snprintf(message, len, "Checkpoint is invalid or from another operation: %s", path);
+    JNU_ThrowByName(env, IO_EXCEPTION, message);
+    free(message);
+  } else {
+    throwErrno(env, walk->err, walk->errPath);
+  }
+}
+
+static int walk_cursor_write(aocode_walk* walk);
+
+// Records the first failure and the position it happened at, always returns -1
+static int walk_fail(aocode_walk* walk, int err) {
+  if (walk->err==0) {
+    walk->err=err;
+    walk->errPath=walk->path==NULL ? NULL : strdup(walk->path);
+    // Best effort, the failure itself is what gets reported
+    if (walk->cursor!=NULL && walk->cursor->depth>0) walk_cursor_write(walk);
+  }
+  return -1;
+}
+
+// Records the first failure for the checkpoint itself, always returns -1
+static int walk_fail_checkpoint(aocode_walk* walk, int err) {
+  if (walk->err==0) {
+    walk->err=err;
+    walk->errPath=strdup(walk->checkpoint);
+  }
+  return -1;
+}
+
+// Makes sure the path buffer can hold len characters plus the terminator
+static int walk_path_reserve(aocode_walk* walk, size_t len) {
+  if (len>=walk->pathCap) {
+    size_t newCap=walk->pathCap==0 ? 256 : walk->pathCap;
+    while (len>=newCap) newCap<<=1;
+    char* newPath=(char*)realloc(walk->path, newCap);
+    if (newPath==NULL) return ENOMEM;
+    walk->path=newPath;
+    walk->pathCap=newCap;
+  }
+  return 0;
+}
+
+static int walk_compare_strings(const void* a, const void* b) {
+  return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+// Decodes the octal escapes used in /proc/self/mountinfo, in place
+static void walk_unescape_mount(char* str) {
+  char* out=str;
+  while (*str!='\0') {
+    if (
+      str[0]=='\\'
+      && str[1]>='0' && str[1]<='7'
+      && str[2]>='0' && str[2]<='7'
+      && str[3]>='0' && str[3]<='7'
+    ) {
+      *out++=(char)(((str[1]-'0')<<6) | ((str[2]-'0')<<3) | (str[3]-'0'));
+      str+=4;
+    } else {
+      *out++=*str++;
+    }
+  }
+  *out='\0';
+}
+
+// Finds all mount points below the starting path so they may be skipped without being touched
+static int walk_load_mounts(aocode_walk* walk, const char* path) {
+  char* realRoot=realpath(path, NULL);
+  if (realRoot==NULL) return errno;
+  size_t realRootLen=strlen(realRoot);
+  if (realRootLen==1) realRootLen=0; // "/"
+  FILE* mountinfo=fopen("/proc/self/mountinfo", "re");
+  if (mountinfo==NULL) {
+    // Fall back to device and statx mount root detection only
+    free(realRoot);
+    return 0;
+  }
+  int err=0;
+  size_t cap=0;
+  char* line=NULL;
+  size_t lineCap=0;
+  while (getline(&line, &lineCap, mountinfo)!=-1) {
+    // The mount point is the fifth field
+    char* saveptr;
+    char* field=strtok_r(line, " ", &saveptr);
+    int c;
+    for (c=1; c<5 && field!=NULL; c++) field=strtok_r(NULL, " ", &saveptr);
+    if (field==NULL) continue;
+    walk_unescape_mount(field);
+    if (
+      strncmp(field, realRoot, realRootLen)!=0
+      || field[realRootLen]!='/'
+      || field[realRootLen+1]=='\0'
+    ) continue;
+    if (walk->mountCount==cap) {
+      size_t newCap=cap==0 ? 16 : cap<<1;
+      char** newMounts=(char**)realloc(walk->mounts, newCap*sizeof(char*));
+      if (newMounts==NULL) {
+        err=ENOMEM;
+        break;
+      }
+      walk->mounts=newMounts;
+      cap=newCap;
+    }
+    char* relative=strdup(field+realRootLen+1);
+    if (relative==NULL) {
+      err=ENOMEM;
+      break;
+    }
+    walk->mounts[walk->mountCount++]=relative;
+  }
+  free(line);
+  fclose(mountinfo);
+  free(realRoot);
+  if (walk->mountCount>1) qsort(walk->mounts, walk->mountCount, sizeof(char*), walk_compare_strings);
+  return err;
+}
+
+// Checks if the current path is a known mount point below the starting path
+static int walk_is_known_mount(const aocode_walk* walk) {
+  if (walk->mountCount==0) return 0;
+  const char* relative=walk->path+walk->rootLen;
+  while (*relative=='/') relative++;
+  return bsearch(&relative, walk->mounts, walk->mountCount, sizeof(char*), walk_compare_strings)!=NULL;
+}
+
+// Records a mount point that is not walked, returns 0 to continue the walk
+static int walk_skip_mount(aocode_walk* walk, int depth) {
+  if (walk->skippedMounts++==0) walk->skippedPath=strdup(walk->path);
+  // Every directory on the current path contains it
+  if ((size_t)depth>walk->skippedDepth) walk->skippedDepth=depth;
+  return 0;
+}
+
+// Reads all entries, except "." and "..", returns 0 or an errno
+static int walk_read_batch(DIR* dir, walk_batch* batch) {
+  struct dirent* de;
+  errno=0;
+  while ((de=readdir(dir))!=NULL) {
+    const char* name=de->d_name;
+    if (name[0]=='.' && (name[1]=='\0' || (name[1]=='.' && name[2]=='\0'))) continue;
+    size_t nameLen=strlen(name)+1;
+    if (batch->count==batch->cap) {
+      size_t newCap=batch->cap==0 ? 64 : batch->cap<<1;
+      walk_dirent* newEntries=(walk_dirent*)realloc(batch->entries, newCap*sizeof(walk_dirent));
+      if (newEntries==NULL) return ENOMEM;
+      batch->entries=newEntries;
+      batch->cap=newCap;
+    }
+    if (batch->namesLen+nameLen>batch->namesCap) {
+      size_t newCap=batch->namesCap==0 ? 4096 : batch->namesCap;
+      while (batch->namesLen+nameLen>newCap) newCap<<=1;
+      char* newNames=(char*)realloc(batch->names, newCap);
+      if (newNames==NULL) return ENOMEM;
+      batch->names=newNames;
+      batch->namesCap=newCap;
+    }
+    walk_dirent* entry=&batch->entries[batch->count++];
+    entry->ino=de->d_ino;
+    entry->nameOff=batch->namesLen;
+    memcpy(batch->names+batch->namesLen, name, nameLen);
+    batch->namesLen+=nameLen;
+    errno=0;
+  }
+  return errno;
+}
+
+// The names of the batch being sorted, qsort has no context argument
+static __thread const char* walk_sort_names;
+
+// Orders by inode, then by name for hard links within the same directory
+static int walk_compare_inodes(const void* a, const void* b) {
+  const walk_dirent* da=(const walk_dirent*)a;
+  const walk_dirent* db=(const walk_dirent*)b;
+  if (da->ino<db->ino) return -1;
+  if (da->ino>db->ino) return 1;
+  return strcmp(walk_sort_names+da->nameOff, walk_sort_names+db->nameOff);
+}
+
+static int walk_compare_names(const void* a, const void* b) {
+  return strcmp(
+    walk_sort_names+((const walk_dirent*)a)->nameOff,
+    walk_sort_names+((const walk_dirent*)b)->nameOff
+  );
+}
+
+// Puts the entries in inode order, or in name order when only a stable order is needed
+static void walk_sort_batch(walk_batch* batch, int inodeOrder) {
+  if (batch->count>1) {
+    walk_sort_names=batch->names;
+    qsort(batch->entries, batch->count, sizeof(walk_dirent), inodeOrder ? walk_compare_inodes : walk_compare_names);
+  }
+}
+
+static void walk_free_batch(walk_batch* batch) {
+  free(batch->entries);
+  free(batch->names);
+  free(batch->slots);
+}
+
+// Reads the start of a directory so that the walk finds it in cache
+static void walk_prefetch_dir(int parentfd, const char* name, char* buff) {
+  int fd=openat(parentfd, name, O_RDONLY|O_DIRECTORY|O_NOFOLLOW|O_NONBLOCK|O_CLOEXEC);
+  if (fd!=-1) {
+    syscall(SYS_getdents64, fd, buff, WALK_PREFETCH_DIR_BYTES);
+    close(fd);
+  }
+}
+
+// Claims entries within the window of the current batch until the walk ends
+static void* walk_prefetch_run(void* arg) {
+  walk_prefetch* prefetch=(walk_prefetch*)arg;
+  const aocode_walk* walk=prefetch->walk;
+  int oneFileSystem=(walk->flags & AOCODE_WALK_ONE_FILE_SYSTEM)!=0;
+  char* buff=(char*)malloc(WALK_PREFETCH_DIR_BYTES);
+  pthread_mutex_lock(&prefetch->lock);
+  while (!prefetch->stop) {
+    walk_batch* batch=prefetch->batch;
+    if (batch!=NULL) {
+      size_t limit=batch->consumer+WALK_PREFETCH_WINDOW;
+      if (limit>batch->count) limit=batch->count;
+      while (batch->next<limit && batch->slots[batch->next].state!=WALK_SLOT_FREE) batch->next++;
+      if (batch->next<limit) {
+        size_t index=batch->next++;
+        walk_slot* slot=&batch->slots[index];
+        slot->state=WALK_SLOT_CLAIMED;
+        batch->busy++;
+        int fd=batch->fd;
+        const char* name=batch->names+batch->entries[index].nameOff;
+        pthread_mutex_unlock(&prefetch->lock);
+        int err=0;
+        if (aocode_fstatat(fd, name, &slot->stat, AT_SYMLINK_NOFOLLOW|AT_NO_AUTOMOUNT)!=0) {
+          err=errno;
+        } else if (
+          buff!=NULL
+          && S_ISDIR(slot->stat.st.st_mode)
+          && !(
+            oneFileSystem
+            && (
+              slot->stat.st.st_dev!=walk->rootDev
+              || (slot->stat.attributes & STATX_ATTR_MOUNT_ROOT)!=0
+            )
+          )
+        ) {
+          walk_prefetch_dir(fd, name, buff);
+        }
+        pthread_mutex_lock(&prefetch->lock);
+        slot->err=err;
+        slot->state=WALK_SLOT_DONE;
+        batch->busy--;
+        pthread_cond_broadcast(&prefetch->done);
+        continue;
+      }
+    }
+    pthread_cond_wait(&prefetch->work, &prefetch->lock);
+  }
+  pthread_mutex_unlock(&prefetch->lock);
+  free(buff);
+  return NULL;
+}
+
+// Starts the helper threads, continuing without prefetch when none can be started
+static void walk_prefetch_start(aocode_walk* walk) {
+  walk_prefetch* prefetch=(walk_prefetch*)calloc(1, sizeof(walk_prefetch));
+  if (prefetch==NULL) return;
+  pthread_mutex_init(&prefetch->lock, NULL);
+  pthread_cond_init(&prefetch->work, NULL);
+  pthread_cond_init(&prefetch->done, NULL);
+  prefetch->walk=walk;
+  while (
+    prefetch->threadCount<WALK_PREFETCH_THREADS
+    && pthread_create(&prefetch->threads[prefetch->threadCount], NULL, walk_prefetch_run, prefetch)==0
+  ) prefetch->threadCount++;
+  if (prefetch->threadCount==0) {
+    pthread_cond_destroy(&prefetch->done);
+    pthread_cond_destroy(&prefetch->work);
+    pthread_mutex_destroy(&prefetch->lock);
+    free(prefetch);
+    return;
+  }
+  walk->prefetch=prefetch;
+}
+
+static void walk_prefetch_stop(aocode_walk* walk) {
+  walk_prefetch* prefetch=walk->prefetch;
+  if (prefetch==NULL) return;
+  pthread_mutex_lock(&prefetch->lock);
+  prefetch->stop=1;
+  pthread_cond_broadcast(&prefetch->work);
+  pthread_mutex_unlock(&prefetch->lock);
+  int c;
+  for (c=0; c<prefetch->threadCount; c++) pthread_join(prefetch->threads[c], NULL);
+  pthread_cond_destroy(&prefetch->done);
+  pthread_cond_destroy(&prefetch->work);
+  pthread_mutex_destroy(&prefetch->lock);
+  free(prefetch);
+  walk->prefetch=NULL;
+}
+
+/*
+ * Makes a batch available to the helpers, returning the batch it replaces.
+ * Known mount points are never handed to the helpers.  Returns 0 or an errno.
+ */
+static int walk_prefetch_publish(aocode_walk* walk, walk_batch* batch, int fd, size_t pathLen, size_t start, walk_batch** prev) {
+  walk_prefetch* prefetch=walk->prefetch;
+  batch->slots=(walk_slot*)calloc(batch->count, sizeof(walk_slot));
+  if (batch->slots==NULL) return ENOMEM;
+  batch->fd=fd;
+  batch->next=start;
+  batch->consumer=start;
+  if ((walk->flags & AOCODE_WALK_ONE_FILE_SYSTEM)!=0 && walk->mountCount>0) {
+    int sep=pathLen==0 || walk->path[pathLen-1]!='/';
+    size_t c;
+    for (c=start; c<batch->count; c++) {
+      const char* name=batch->names+batch->entries[c].nameOff;
+      int err=walk_path_reserve(walk, pathLen+sep+strlen(name));
+      if (err!=0) {
+        walk->path[pathLen]='\0';
+        return err;
+      }
+      if (sep) walk->path[pathLen]='/';
+      strcpy(walk->path+pathLen+sep, name);
+      if (walk_is_known_mount(walk)) batch->slots[c].state=WALK_SLOT_TAKEN;
+    }
+    walk->path[pathLen]='\0';
+  }
+  pthread_mutex_lock(&prefetch->lock);
+  *prev=prefetch->batch;
+  prefetch->batch=batch;
+  pthread_cond_broadcast(&prefetch->work);
+  pthread_mutex_unlock(&prefetch->lock);
+  return 0;
+}
+
+// Waits for the helpers to finish with a batch and restores the batch it replaced
+static void walk_prefetch_retire(aocode_walk* walk, walk_batch* batch, walk_batch* prev) {
+  walk_prefetch* prefetch=walk->prefetch;
+  pthread_mutex_lock(&prefetch->lock);
+  while (batch->busy>0) pthread_cond_wait(&prefetch->done, &prefetch->lock);
+  prefetch->batch=prev;
+  pthread_cond_broadcast(&prefetch->work);
+  pthread_mutex_unlock(&prefetch->lock);
+}
+
+/*
+ * Moves the window to an entry and takes its prefetched stat.  Returns 1 when the stat was prefetched,
+ * or 0 when the walk must stat the entry itself.
+ */
+static int walk_prefetch_take(aocode_walk* walk, walk_batch* batch, size_t index, aocode_stat* stat) {
+  walk_prefetch* prefetch=walk->prefetch;
+  walk_slot* slot=&batch->slots[index];
+  int taken=0;
+  pthread_mutex_lock(&prefetch->lock);
+  batch->consumer=index;
+  pthread_cond_broadcast(&prefetch->work);
+  while (slot->state==WALK_SLOT_CLAIMED) pthread_cond_wait(&prefetch->done, &prefetch->lock);
+  if (slot->state==WALK_SLOT_DONE && slot->err==0) {
+    *stat=slot->stat;
+    taken=1;
+  }
+  slot->state=WALK_SLOT_TAKEN;
+  pthread_mutex_unlock(&prefetch->lock);
+  return taken;
+}
+
+static void walk_put64(unsigned char** pos, uint64_t value) {
+  memcpy(*pos, &value, sizeof(value));
+  *pos+=sizeof(value);
+}
+
+static void walk_put32(unsigned char** pos, uint32_t value) {
+  memcpy(*pos, &value, sizeof(value));
+  *pos+=sizeof(value);
+}
+
+// Reads from the checkpoint, returns 0 when past the end
+static int walk_get(const unsigned char** pos, const unsigned char* end, void* value, size_t len) {
+  if ((size_t)(end-*pos)<len) return 0;
+  memcpy(value, *pos, len);
+  *pos+=len;
+  return 1;
+}
+
+static void walk_cursor_free(walk_cursor* cursor) {
+  size_t c;
+  for (c=0; c<cursor->resumeCount; c++) free(cursor->resume[c].lastName);
+  free(cursor->resume);
+  free(cursor->frames);
+  free(cursor->buff);
+  free(cursor->tmpPath);
+  free(cursor);
+}
+
+/*
+ * Parses a checkpoint, returns 0 or AOCODE_WALK_BAD_CHECKPOINT.  The format, in native byte order, is the magic,
+ * the operation, the walk flags, and the frame count, followed by each frame as its dev, ino, last finished ino,
+ * and the length and bytes of the last finished name, with a length of zero when none.
+ */
+static int walk_cursor_parse(aocode_walk* walk, const unsigned char* pos, const unsigned char* end) {
+  walk_cursor* cursor=walk->cursor;
+  char magic[sizeof(WALK_CHECKPOINT_MAGIC)];
+  int32_t op[3];
+  int32_t flags;
+  uint32_t count;
+  if (
+    !walk_get(&pos, end, magic, sizeof(magic))
+    || memcmp(magic, WALK_CHECKPOINT_MAGIC, sizeof(magic))!=0
+    || !walk_get(&pos, end, op, sizeof(op))
+    || op[0]!=walk->checkpointOp[0] || op[1]!=walk->checkpointOp[1] || op[2]!=walk->checkpointOp[2]
+    || !walk_get(&pos, end, &flags, sizeof(flags))
+    || flags!=(walk->flags & WALK_CHECKPOINT_FLAGS)
+    || !walk_get(&pos, end, &count, sizeof(count))
+    // Every frame takes at least 28 bytes
+    || count>(size_t)(end-pos)/28
+  ) return AOCODE_WALK_BAD_CHECKPOINT;
+  cursor->resume=(walk_resume*)calloc(count==0 ? 1 : count, sizeof(walk_resume));
+  if (cursor->resume==NULL) return ENOMEM;
+  while (cursor->resumeCount<count) {
+    walk_resume* resume=&cursor->resume[cursor->resumeCount++];
+    uint64_t dev, ino, lastIno;
+    uint32_t nameLen;
+    if (
+      !walk_get(&pos, end, &dev, sizeof(dev))
+      || !walk_get(&pos, end, &ino, sizeof(ino))
+      || !walk_get(&pos, end, &lastIno, sizeof(lastIno))
+      || !walk_get(&pos, end, &nameLen, sizeof(nameLen))
+      || nameLen>(size_t)(end-pos)
+    ) return AOCODE_WALK_BAD_CHECKPOINT;
+    resume->dev=(dev_t)dev;
+    resume->ino=(ino_t)ino;
+    resume->lastIno=(ino_t)lastIno;
+    if (nameLen>0) {
+      if (memchr(pos, '\0', nameLen)!=NULL) return AOCODE_WALK_BAD_CHECKPOINT;
+      resume->lastName=(char*)malloc(nameLen+1);
+      if (resume->lastName==NULL) return ENOMEM;
+      memcpy(resume->lastName, pos, nameLen);
+      resume->lastName[nameLen]='\0';
+      pos+=nameLen;
+    }
+  }
+  return pos==end ? 0 : AOCODE_WALK_BAD_CHECKPOINT;
+}
+
+// Reads the checkpoint when it exists, returns 0 or -1 on failure
+static int walk_cursor_start(aocode_walk* walk) {
+  walk_cursor* cursor=(walk_cursor*)calloc(1, sizeof(walk_cursor));
+  if (cursor==NULL) return walk_fail_checkpoint(walk, ENOMEM);
+  walk->cursor=cursor;
+  size_t pathLen=strlen(walk->checkpoint);
+  cursor->tmpPath=(char*)malloc(pathLen+5);
+  if (cursor->tmpPath==NULL) return walk_fail_checkpoint(walk, ENOMEM);
+  memcpy(cursor->tmpPath, walk->checkpoint, pathLen);
+  memcpy(cursor->tmpPath+pathLen, ".tmp", 5);
+  cursor->resumeDepth=WALK_NOT_RESUMING;
+  clock_gettime(CLOCK_MONOTONIC_COARSE, &cursor->next);
+  cursor->next.tv_sec+=WALK_CHECKPOINT_MILLIS/1000;
+  int fd=open(walk->checkpoint, O_RDONLY|O_CLOEXEC);
+  if (fd==-1) {
+    if (errno==ENOENT) return 0;
+    return walk_fail_checkpoint(walk, errno);
+  }
+  struct stat st;
+  unsigned char* data=NULL;
+  int err=0;
+  if (fstat(fd, &st)!=0) {
+    err=errno;
+  } else if (!S_ISREG(st.st_mode) || st.st_size>(64<<20)) {
+    err=AOCODE_WALK_BAD_CHECKPOINT;
+  } else if ((data=(unsigned char*)malloc(st.st_size==0 ? 1 : st.st_size))==NULL) {
+    err=ENOMEM;
+  } else {
+    size_t len=0;
+    while (len<(size_t)st.st_size) {
+      ssize_t count=read(fd, data+len, st.st_size-len);
+      if (count==-1) {
+        if (errno==EINTR) continue;
+        err=errno;
+        break;
+      }
+      if (count==0) break;
+      len+=count;
+    }
+    if (err==0) err=walk_cursor_parse(walk, data, data+len);
+  }
+  free(data);
+  close(fd);
+  if (err!=0) return walk_fail_checkpoint(walk, err);
+  if (cursor->resumeCount>0) cursor->resumeDepth=0;
+  return 0;
+}
+
+// Writes the position to a temporary file then renames it over the checkpoint, returns 0 or an errno
+static int walk_cursor_write(aocode_walk* walk) {
+  walk_cursor* cursor=walk->cursor;
+  size_t len=sizeof(WALK_CHECKPOINT_MAGIC)+5*sizeof(int32_t);
+  size_t c;
+  for (c=0; c<cursor->depth; c++) {
+    const walk_frame* frame=&cursor->frames[c];
+    len+=3*sizeof(uint64_t)+sizeof(uint32_t);
+    if (frame->done>0) len+=strlen(frame->batch->names+frame->batch->entries[frame->done-1].nameOff);
+  }
+  if (len>cursor->buffCap) {
+    unsigned char* newBuff=(unsigned char*)realloc(cursor->buff, len);
+    if (newBuff==NULL) return ENOMEM;
+    cursor->buff=newBuff;
+    cursor->buffCap=len;
+  }
+  unsigned char* pos=cursor->buff;
+  memcpy(pos, WALK_CHECKPOINT_MAGIC, sizeof(WALK_CHECKPOINT_MAGIC));
+  pos+=sizeof(WALK_CHECKPOINT_MAGIC);
+  for (c=0; c<3; c++) walk_put32(&pos, (uint32_t)walk->checkpointOp[c]);
+  walk_put32(&pos, (uint32_t)(walk->flags & WALK_CHECKPOINT_FLAGS));
+  walk_put32(&pos, (uint32_t)cursor->depth);
+  for (c=0; c<cursor->depth; c++) {
+    const walk_frame* frame=&cursor->frames[c];
+    walk_put64(&pos, (uint64_t)frame->dev);
+    walk_put64(&pos, (uint64_t)frame->ino);
+    if (frame->done>0) {
+      const walk_dirent* last=&frame->batch->entries[frame->done-1];
+      const char* name=frame->batch->names+last->nameOff;
+      size_t nameLen=strlen(name);
+      walk_put64(&pos, (uint64_t)last->ino);
+      walk_put32(&pos, (uint32_t)nameLen);
+      memcpy(pos, name, nameLen);
+      pos+=nameLen;
+    } else {
+      walk_put64(&pos, 0);
+      walk_put32(&pos, 0);
+    }
+  }
+  int fd=open(cursor->tmpPath, O_WRONLY|O_CREAT|O_TRUNC|O_NOFOLLOW|O_CLOEXEC, 0600);
+  if (fd==-1) return errno;
+  int err=0;
+  const unsigned char* data=cursor->buff;
+  while (len>0) {
+    ssize_t count=write(fd, data, len);
+    if (count==-1) {
+      if (errno==EINTR) continue;
+      err=errno;
+      break;
+    }
+    data+=count;
+    len-=count;
+  }
+  if (err==0 && fdatasync(fd)!=0) err=errno;
+  if (close(fd)!=0 && err==0) err=errno;
+  if (err==0 && rename(cursor->tmpPath, walk->checkpoint)!=0) err=errno;
+  if (err!=0) unlink(cursor->tmpPath);
+  return err;
+}
+
+// Writes the position when it has not been written for a while, returns 0 or -1 on failure
+static int walk_cursor_tick(aocode_walk* walk) {
+  walk_cursor* cursor=walk->cursor;
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+  if (now.tv_sec<cursor->next.tv_sec || (now.tv_sec==cursor->next.tv_sec && now.tv_nsec<cursor->next.tv_nsec)) return 0;
+  int err=walk_cursor_write(walk);
+  if (err!=0) return walk_fail_checkpoint(walk, err);
+  cursor->next=now;
+  cursor->next.tv_sec+=WALK_CHECKPOINT_MILLIS/1000;
+  return 0;
+}
+
+// Adds the frame for a directory being walked, returns 0 or an errno
+static int walk_cursor_push(walk_cursor* cursor, const aocode_stat* stat, const walk_batch* batch) {
+  if (cursor->depth==cursor->cap) {
+    size_t newCap=cursor->cap==0 ? 32 : cursor->cap<<1;
+    walk_frame* newFrames=(walk_frame*)realloc(cursor->frames, newCap*sizeof(walk_frame));
+    if (newFrames==NULL) return ENOMEM;
+    cursor->frames=newFrames;
+    cursor->cap=newCap;
+  }
+  walk_frame* frame=&cursor->frames[cursor->depth++];
+  frame->dev=stat->st.st_dev;
+  frame->ino=stat->st.st_ino;
+  frame->batch=batch;
+  frame->done=0;
+  return 0;
+}
+
+/*
+ * Finds where to start in a directory, skipping the entries finished before the checkpoint was written.
+ * Only the directories of the checkpoint, still with the same dev and ino, continue the resume.
+ */
+static size_t walk_cursor_resume(aocode_walk* walk, size_t depth, const walk_batch* batch) {
+  walk_cursor* cursor=walk->cursor;
+  if (cursor->resumeDepth!=depth) return 0;
+  walk_frame* frame=&cursor->frames[depth];
+  if (
+    depth>=cursor->resumeCount
+    || cursor->resume[depth].dev!=frame->dev
+    || cursor->resume[depth].ino!=frame->ino
+  ) {
+    cursor->resumeDepth=WALK_NOT_RESUMING;
+    return 0;
+  }
+  const walk_resume* resume=&cursor->resume[depth];
+  cursor->resumeDepth=depth+1;
+  if (resume->lastName==NULL) return 0;
+  int inodeOrder=(walk->flags & AOCODE_WALK_INODE_ORDER)!=0;
+  size_t start=0;
+  while (start<batch->count) {
+    const walk_dirent* entry=&batch->entries[start];
+    int diff;
+    if (inodeOrder && entry->ino!=resume->lastIno) diff=entry->ino<resume->lastIno ? -1 : 1;
+    else diff=strcmp(batch->names+entry->nameOff, resume->lastName);
+    if (diff>0) break;
+    start++;
+  }
+  frame->done=start;
+  return start;
+}
+
+// Walks one entry, the path buffer holds its path at pathLen, uses the prefetched stat when not NULL
+static int walk_entry(aocode_walk* walk, int parentfd, const char* name, size_t pathLen, int depth, const aocode_stat* prefetched) {
+  aocode_walk_entry entry;
+  entry.dirfd=parentfd;
+  entry.name=name;
+  entry.path=walk->path;
+  entry.depth=depth;
+  entry.skippedMount=0;
+  int oneFileSystem=(walk->flags & AOCODE_WALK_ONE_FILE_SYSTEM)!=0;
+  // Known mount points are skipped before stat, which could block on a remote filesystem
+  if (oneFileSystem && depth>0 && walk_is_known_mount(walk)) return walk_skip_mount(walk, depth);
+  if (prefetched!=NULL) {
+    entry.stat=*prefetched;
+  } else if (aocode_fstatat(parentfd, name, &entry.stat, AT_SYMLINK_NOFOLLOW|AT_NO_AUTOMOUNT)!=0) {
+    // OK if removed while walking
+    if (errno==ENOENT && depth>0) return 0;
+    return walk_fail(walk, errno);
+  }
+  if (depth==0) {
+    walk->rootDev=entry.stat.st.st_dev;
+    // A checkpoint is only resumed on the same tree
+    if (
+      walk->cursor!=NULL
+      && walk->cursor->resumeCount>0
+      && (walk->cursor->resume[0].dev!=entry.stat.st.st_dev || walk->cursor->resume[0].ino!=entry.stat.st.st_ino)
+    ) return walk_fail_checkpoint(walk, AOCODE_WALK_BAD_CHECKPOINT);
+  } else if (
+    oneFileSystem
+    && (
+      entry.stat.st.st_dev!=walk->rootDev
+      || (entry.stat.attributes & STATX_ATTR_MOUNT_ROOT)!=0
+    )
+  ) {
+    // Mounted after the walk started
+    return walk_skip_mount(walk, depth);
+  }
+  int skip=0;
+  if (walk->pre!=NULL) {
+    int ret=walk->pre(&entry, walk->ctx);
+    if (ret==AOCODE_WALK_SKIP) skip=1;
+    else if (ret!=0) return walk_fail(walk, ret);
+  }
+  if (!skip && S_ISDIR(entry.stat.st.st_mode)) {
+    int fd=openat(parentfd, name, O_RDONLY|O_DIRECTORY|O_NOFOLLOW|O_CLOEXEC);
+    if (fd==-1) {
+      if (errno==ENOENT && depth>0) return 0;
+      return walk_fail(walk, errno);
+    }
+    DIR* dir=fdopendir(fd);
+    if (dir==NULL) {
+      int err=errno;
+      close(fd);
+      return walk_fail(walk, err);
+    }
+    walk_batch batch;
+    memset(&batch, 0, sizeof(walk_batch));
+    int result=0;
+    int err=walk_read_batch(dir, &batch);
+    walk_cursor* cursor=walk->cursor;
+    if (err==0 && cursor!=NULL) err=walk_cursor_push(cursor, &entry.stat, &batch);
+    if (err!=0) {
+      result=walk_fail(walk, err);
+    } else {
+      int inodeOrder=(walk->flags & AOCODE_WALK_INODE_ORDER)!=0;
+      if (inodeOrder || cursor!=NULL) walk_sort_batch(&batch, inodeOrder);
+      size_t start=cursor==NULL ? 0 : walk_cursor_resume(walk, depth, &batch);
+      int childDirfd=dirfd(dir);
+      walk_batch* prev=NULL;
+      int published=0;
+      if (walk->prefetch!=NULL && start<batch.count) {
+        // Entries being skipped are never handed to the helpers
+        err=walk_prefetch_publish(walk, &batch, childDirfd, pathLen, start, &prev);
+        if (err!=0) result=walk_fail(walk, err);
+        else published=1;
+      }
+      int sep=pathLen==0 || walk->path[pathLen-1]!='/';
+      size_t c;
+      for (c=start; result==0 && c<batch.count; c++) {
+        const char* childName=batch.names+batch.entries[c].nameOff;
+        size_t childLen=pathLen+sep+strlen(childName);
+        err=walk_path_reserve(walk, childLen);
+        if (err!=0) {
+          walk->path[pathLen]='\0';
+          result=walk_fail(walk, err);
+          break;
+        }
+        if (sep) walk->path[pathLen]='/';
+        strcpy(walk->path+pathLen+sep, childName);
+        aocode_stat childStat;
+        int hasStat=published && walk_prefetch_take(walk, &batch, c, &childStat);
+        result=walk_entry(walk, childDirfd, childName, childLen, depth+1, hasStat ? &childStat : NULL);
+        if (cursor!=NULL) {
+          // Only the first entry after the skipped ones may continue the resume
+          cursor->resumeDepth=WALK_NOT_RESUMING;
+          if (result==0) {
+            cursor->frames[depth].done=c+1;
+            result=walk_cursor_tick(walk);
+          }
+        }
+      }
+      walk->path[pathLen]='\0';
+      if (published) walk_prefetch_retire(walk, &batch, prev);
+    }
+    if (cursor!=NULL) {
+      if (cursor->resumeDepth>(size_t)depth) cursor->resumeDepth=WALK_NOT_RESUMING;
+      if (cursor->depth>(size_t)depth) cursor->depth=depth;
+    }
+    walk_free_batch(&batch);
+    closedir(dir);
+    if (result!=0) return result;
+  }
+  // Leaving this directory, only its parents still contain the skipped mount points
+  entry.skippedMount=(size_t)depth<walk->skippedDepth;
+  if (entry.skippedMount) walk->skippedDepth=depth;
+  if (walk->post!=NULL) {
+    entry.path=walk->path;
+    int ret=walk->post(&entry, walk->ctx);
+    if (ret!=0 && ret!=AOCODE_WALK_SKIP) return walk_fail(walk, ret);
+  }
+  return 0;
+}
+
+int aocode_walk_tree(aocode_walk* walk, const char* path) {
+  size_t pathLen=strlen(path);
+  int err=walk_path_reserve(walk, pathLen);
+  if (err!=0) return walk_fail(walk, err);
+  memcpy(walk->path, path, pathLen+1);
+  walk->rootLen=pathLen;
+  if ((walk->flags & AOCODE_WALK_ONE_FILE_SYSTEM)!=0) {
+    err=walk_load_mounts(walk, path);
+    if (err!=0) return walk_fail(walk, err);
+  }
+  if (walk->checkpoint!=NULL && walk_cursor_start(walk)!=0) {
+    walk_cursor_free(walk->cursor);
+    walk->cursor=NULL;
+    return -1;
+  }
+  if ((walk->flags & AOCODE_WALK_PREFETCH)!=0) walk_prefetch_start(walk);
+  int result=walk_entry(walk, AT_FDCWD, path, pathLen, 0, NULL);
+  walk_prefetch_stop(walk);
+  if (walk->cursor!=NULL) {
+    walk_cursor_free(walk->cursor);
+    walk->cursor=NULL;
+    if (result==0 && unlink(walk->checkpoint)!=0 && errno!=ENOENT) result=walk_fail_checkpoint(walk, errno);
+  }
+  return result;
+}
@@ -0,0 +1,98 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include "aocode_shared.h"
+#ifndef _Included_aocode_walk
+#define _Included_aocode_walk
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Returned from a pre-order visit to not descend into a directory
+#define AOCODE_WALK_SKIP (-1)
+
+// Walk flags, must match com.aoapps.io.posix.WalkOption
+#define AOCODE_WALK_ONE_FILE_SYSTEM 0x1  // Do not descend into, or even stat, other mounts
+#define AOCODE_WALK_INODE_ORDER     0x2  // Process the entries of each directory in inode order
+#define AOCODE_WALK_PREFETCH        0x4  // Stat upcoming entries and read ahead subdirectories on helper threads
+
+// The error for a checkpoint that is corrupt or was written by a different operation or tree
+#define AOCODE_WALK_BAD_CHECKPOINT (-2)
+
+// One filesystem object found during a walk
+typedef struct aocode_walk_entry {
+  int dirfd;         // The directory containing this entry, AT_FDCWD for the starting path
+  const char* name;  // The name relative to dirfd
+  const char* path;  // The full path, only valid during the visit
+  aocode_stat stat;  // The stat of the entry, not following symbolic links
+  int depth;         // Zero for the starting path
+  int skippedMount;  // Whether a mount point below this directory was not walked, only set for the post visit
+} aocode_walk_entry;
+
+// Visits an entry, returns 0 to continue, AOCODE_WALK_SKIP to not descend, or an errno to stop the walk
+typedef int (*aocode_walk_visit)(aocode_walk_entry* entry, void* ctx);
+
+// A depth-first walk of a directory tree that never follows symbolic links
+typedef struct aocode_walk {
+  aocode_walk_visit pre;   // Called before the contents of a directory, may be NULL
+  aocode_walk_visit post;  // Called after the contents of a directory, may be NULL
+  void* ctx;
+  int flags;
+  int err;                 // The errno that stopped the walk
+  char* errPath;           // The path where the walk stopped
+  size_t skippedMounts;    // The number of mount points not walked due to AOCODE_WALK_ONE_FILE_SYSTEM
+  char* skippedPath;       // The path of the first mount point not walked
+  const char* checkpoint;  // The cursor file to resume from and periodically write, NULL for none
+  int checkpointOp[3];     // Identifies the operation and its arguments, a cursor from another operation is rejected
+  // Private
+  char* path;
+  size_t pathCap;
+  size_t rootLen;
+  dev_t rootDev;
+  char** mounts;           // Sorted mount points below the starting path, relative to it
+  size_t mountCount;
+  size_t skippedDepth;     // The directories on the current path above this depth contain a skipped mount point
+  struct walk_prefetch* prefetch;  // The helper threads for AOCODE_WALK_PREFETCH
+  struct walk_cursor* cursor;      // The traversal position when checkpointing
+} aocode_walk;
+
+extern void aocode_walk_init(aocode_walk* walk, aocode_walk_visit pre, aocode_walk_visit post, void* ctx, int flags);
+
+/*
+ * Walks the tree starting at path, returns 0 on success or -1 with walk->err and walk->errPath set.
+ *
+ * When walk->checkpoint is set, the entries of each directory are processed in a stable order (by name, or by inode
+ * with AOCODE_WALK_INODE_ORDER) and the position is written to the checkpoint about once a second and when the
+ * walk fails.  A later walk of the same operation resumes from the checkpoint, skipping the subtrees already
+ * finished without reading them.  The checkpoint is removed when the walk succeeds.
+ */
+extern int aocode_walk_tree(aocode_walk* walk, const char* path);
+
+// Throws the exception for a failed walk
+extern void aocode_walk_throw(JNIEnv* env, const aocode_walk* walk);
+
+extern void aocode_walk_destroy(aocode_walk* walk);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
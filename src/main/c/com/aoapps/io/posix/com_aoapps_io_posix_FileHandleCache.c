@@ -0,0 +1,195 @@
+#define _GNU_SOURCE
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <jni.h>
+#include "aocode_shared.h"
+#include "jni_util.h"
+#include "com_aoapps_io_posix_FileHandleCache.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/inotify.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Any of these on a cached file makes its descriptor stale: contents, metadata or link count, rename, removal
+#define WATCH_MASK (IN_MODIFY|IN_ATTRIB|IN_MOVE_SELF|IN_DELETE_SELF)
+
+// The most events read by one call, the rest are read by the next call
+#define EVENT_BUFFER_SIZE (64*(sizeof(struct inotify_event)+NAME_MAX+1))
+
+/*
+ * Class:     com_aoapps_io_posix_FileHandleCache
+ * Method:    getOpenFileLimit0
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_com_aoapps_io_posix_FileHandleCache_getOpenFileLimit0(JNIEnv* env, jclass cls) {
+  struct rlimit limit;
+  if (getrlimit(RLIMIT_NOFILE, &limit)!=0) {
+    throwErrno(env, errno, NULL);
+    return 0;
+  }
+  return limit.rlim_cur==RLIM_INFINITY || limit.rlim_cur>INT64_MAX ? INT64_MAX : (jlong)limit.rlim_cur;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_FileHandleCache
+ * Method:    inotifyInit0
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_com_aoapps_io_posix_FileHandleCache_inotifyInit0(JNIEnv* env, jclass cls) {
+  int fd=inotify_init1(IN_NONBLOCK|IN_CLOEXEC);
+  if (fd==-1) throwErrno(env, errno, NULL);
+  return fd;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_FileHandleCache
+ * Method:    addWatch0
+ * Signature: (II)I
+ */
+JNIEXPORT jint JNICALL Java_com_aoapps_io_posix_FileHandleCache_addWatch0(JNIEnv* env, jclass cls, jint inotifyFd, jint fd) {
+  // Watched through the open descriptor, so it is the same file even if the path has since changed
+  char path[32];
+  snprintf(path, sizeof(path), "/proc/self/fd/%d", fd);
+  int wd=inotify_add_watch(inotifyFd, path, WATCH_MASK);
+  if (wd==-1) throwErrno(env, errno, NULL);
+  return wd;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_FileHandleCache
+ * Method:    removeWatch0
+ * Signature: (II)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_FileHandleCache_removeWatch0(JNIEnv* env, jclass cls, jint inotifyFd, jint wd) {
+  // EINVAL when already removed by the kernel along with its file
+  if (inotify_rm_watch(inotifyFd, wd)!=0 && errno!=EINVAL) throwErrno(env, errno, NULL);
+}
+
+/*
+ * Class:     com_aoapps_io_posix_FileHandleCache
+ * Method:    readEvents0
+ * Signature: (I)[I
+ */
+JNIEXPORT jintArray JNICALL Java_com_aoapps_io_posix_FileHandleCache_readEvents0(JNIEnv* env, jclass cls, jint inotifyFd) {
+  char buff[EVENT_BUFFER_SIZE] __attribute__((aligned(__alignof__(struct inotify_event))));
+  ssize_t len;
+  do {
+    len=read(inotifyFd, buff, sizeof(buff));
+  } while (len==-1 && errno==EINTR);
+  if (len==-1) {
+    if (errno!=EAGAIN) throwErrno(env, errno, NULL);
+    return NULL;
+  }
+  // One watch descriptor per event, OVERFLOW when events were lost
+  jint wds[EVENT_BUFFER_SIZE/sizeof(struct inotify_event)];
+  jsize count=0;
+  char* pos=buff;
+  while (pos<buff+len) {
+    struct inotify_event* event=(struct inotify_event*)pos;
+    wds[count++]=(event->mask & IN_Q_OVERFLOW) ? com_aoapps_io_posix_FileHandleCache_OVERFLOW : event->wd;
+    pos+=sizeof(struct inotify_event)+event->len;
+  }
+  jintArray result=(*env)->NewIntArray(env, count);
+  if (result!=NULL) (*env)->SetIntArrayRegion(env, result, 0, count, wds);
+  return result;
+}
+
+// Copies the identity and state of a file, with the nanosecond change time so rapid changes are seen
+static void setFileId(JNIEnv* env, jlongArray jid, const struct stat* st) {
+  jlong id[6]={
+    (jlong)st->st_dev,
+    (jlong)st->st_ino,
+    (jlong)st->st_size,
+    (jlong)st->st_ctim.tv_sec*1000000000+st->st_ctim.tv_nsec,
+    (jlong)st->st_nlink,
+    (jlong)st->st_mode
+  };
+  (*env)->SetLongArrayRegion(env, jid, 0, 6, id);
+}
+
+/*
+ * Class:     com_aoapps_io_posix_FileHandleCache
+ * Method:    getFileId0
+ * Signature: (I[J)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_FileHandleCache_getFileId0(JNIEnv* env, jclass cls, jint fd, jlongArray jid) {
+  struct stat st;
+  if (fstat(fd, &st)!=0) {
+    throwErrno(env, errno, NULL);
+    return;
+  }
+  setFileId(env, jid, &st);
+}
+
+/*
+ * Class:     com_aoapps_io_posix_FileHandleCache
+ * Method:    getPathId0
+ * Signature: (Ljava/lang/String;[J)Z
+ */
+JNIEXPORT jboolean JNICALL Java_com_aoapps_io_posix_FileHandleCache_getPathId0(JNIEnv* env, jclass cls, jstring jpath, jlongArray jid) {
+  jboolean found=JNI_FALSE;
+  const char* path=getString8859_1Chars(env, jpath);
+  if (path!=NULL) {
+    // Resolved as when opened, so a path now through a symbolic link is reopened, which then fails
+    int fd=aocode_open_nosymlinks(path, O_PATH);
+    struct stat st;
+    if (fd!=-1 && fstat(fd, &st)==0) {
+      setFileId(env, jid, &st);
+      found=JNI_TRUE;
+    } else if (errno!=ENOENT && errno!=ENOTDIR && errno!=ELOOP) {
+      throwErrno(env, errno, path);
+    }
+    if (fd!=-1) close(fd);
+    releaseString8859_1Chars(path);
+  }
+  return found;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_FileHandleCache
+ * Method:    close0
+ * Signature: (I)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_FileHandleCache_close0(JNIEnv* env, jclass cls, jint fd) {
+  if (close(fd)!=0 && errno!=EINTR) throwErrno(env, errno, NULL);
+}
+
+static const JNINativeMethod methods[]={
+  {"getOpenFileLimit0", "()J", (void*)Java_com_aoapps_io_posix_FileHandleCache_getOpenFileLimit0},
+  {"inotifyInit0", "()I", (void*)Java_com_aoapps_io_posix_FileHandleCache_inotifyInit0},
+  {"addWatch0", "(II)I", (void*)Java_com_aoapps_io_posix_FileHandleCache_addWatch0},
+  {"removeWatch0", "(II)V", (void*)Java_com_aoapps_io_posix_FileHandleCache_removeWatch0},
+  {"readEvents0", "(I)[I", (void*)Java_com_aoapps_io_posix_FileHandleCache_readEvents0},
+  {"getFileId0", "(I[J)V", (void*)Java_com_aoapps_io_posix_FileHandleCache_getFileId0},
+  {"getPathId0", "(Ljava/lang/String;[J)Z", (void*)Java_com_aoapps_io_posix_FileHandleCache_getPathId0},
+  {"close0", "(I)V", (void*)Java_com_aoapps_io_posix_FileHandleCache_close0}
+};
+
+jint registerFileHandleCacheNatives(JNIEnv* env) {
+  return registerNatives(env, "com/aoapps/io/posix/FileHandleCache", methods, sizeof(methods)/sizeof(methods[0]));
+}
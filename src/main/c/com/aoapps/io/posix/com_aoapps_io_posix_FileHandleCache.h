@@ -0,0 +1,99 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_aoapps_io_posix_FileHandleCache */
+
+#ifndef _Included_com_aoapps_io_posix_FileHandleCache
+#define _Included_com_aoapps_io_posix_FileHandleCache
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef com_aoapps_io_posix_FileHandleCache_OVERFLOW
+#define com_aoapps_io_posix_FileHandleCache_OVERFLOW -1L
+#undef com_aoapps_io_posix_FileHandleCache_DRAIN_INTERVAL
+#define com_aoapps_io_posix_FileHandleCache_DRAIN_INTERVAL 10000000LL
+#undef com_aoapps_io_posix_FileHandleCache_ID_DEV
+#define com_aoapps_io_posix_FileHandleCache_ID_DEV 0L
+#undef com_aoapps_io_posix_FileHandleCache_ID_INO
+#define com_aoapps_io_posix_FileHandleCache_ID_INO 1L
+#undef com_aoapps_io_posix_FileHandleCache_ID_SIZE
+#define com_aoapps_io_posix_FileHandleCache_ID_SIZE 2L
+#undef com_aoapps_io_posix_FileHandleCache_ID_CTIME
+#define com_aoapps_io_posix_FileHandleCache_ID_CTIME 3L
+#undef com_aoapps_io_posix_FileHandleCache_ID_NLINK
+#define com_aoapps_io_posix_FileHandleCache_ID_NLINK 4L
+#undef com_aoapps_io_posix_FileHandleCache_ID_MODE
+#define com_aoapps_io_posix_FileHandleCache_ID_MODE 5L
+#undef com_aoapps_io_posix_FileHandleCache_ID_LENGTH
+#define com_aoapps_io_posix_FileHandleCache_ID_LENGTH 6L
+#undef com_aoapps_io_posix_FileHandleCache_S_IFMT
+#define com_aoapps_io_posix_FileHandleCache_S_IFMT 61440LL
+#undef com_aoapps_io_posix_FileHandleCache_S_IFREG
+#define com_aoapps_io_posix_FileHandleCache_S_IFREG 32768LL
+/*
+ * Class:     com_aoapps_io_posix_FileHandleCache
+ * Method:    getOpenFileLimit0
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_com_aoapps_io_posix_FileHandleCache_getOpenFileLimit0
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     com_aoapps_io_posix_FileHandleCache
+ * Method:    inotifyInit0
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_com_aoapps_io_posix_FileHandleCache_inotifyInit0
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     com_aoapps_io_posix_FileHandleCache
+ * Method:    addWatch0
+ * Signature: (II)I
+ */
+JNIEXPORT jint JNICALL Java_com_aoapps_io_posix_FileHandleCache_addWatch0
+  (JNIEnv *, jclass, jint, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_FileHandleCache
+ * Method:    removeWatch0
+ * Signature: (II)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_FileHandleCache_removeWatch0
+  (JNIEnv *, jclass, jint, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_FileHandleCache
+ * Method:    readEvents0
+ * Signature: (I)[I
+ */
+JNIEXPORT jintArray JNICALL Java_com_aoapps_io_posix_FileHandleCache_readEvents0
+  (JNIEnv *, jclass, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_FileHandleCache
+ * Method:    getFileId0
+ * Signature: (I[J)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_FileHandleCache_getFileId0
+  (JNIEnv *, jclass, jint, jlongArray);
+
+/*
+ * Class:     com_aoapps_io_posix_FileHandleCache
+ * Method:    getPathId0
+ * Signature: (Ljava/lang/String;[J)Z
+ */
+JNIEXPORT jboolean JNICALL Java_com_aoapps_io_posix_FileHandleCache_getPathId0
+  (JNIEnv *, jclass, jstring, jlongArray);
+
+/*
+ * Class:     com_aoapps_io_posix_FileHandleCache
+ * Method:    close0
+ * Signature: (I)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_FileHandleCache_close0
+  (JNIEnv *, jclass, jint);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
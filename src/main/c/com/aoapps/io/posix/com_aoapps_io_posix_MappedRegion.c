@@ -0,0 +1,87 @@
+#define _GNU_SOURCE
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <jni.h>
+#include "aocode_shared.h"
+#include "com_aoapps_io_posix_MappedRegion.h"
+#include <errno.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/*
+ * Class:     com_aoapps_io_posix_MappedRegion
+ * Method:    getPageSize0
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_com_aoapps_io_posix_MappedRegion_getPageSize0(JNIEnv* env, jclass cls) {
+  return (jlong)sysconf(_SC_PAGESIZE);
+}
+
+/*
+ * Class:     com_aoapps_io_posix_MappedRegion
+ * Method:    newBuffer0
+ * Signature: (JI)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_com_aoapps_io_posix_MappedRegion_newBuffer0(JNIEnv* env, jclass cls, jlong address, jint length) {
+  return (*env)->NewDirectByteBuffer(env, (void*)(uintptr_t)address, length);
+}
+
+/*
+ * Class:     com_aoapps_io_posix_MappedRegion
+ * Method:    advise0
+ * Signature: (JJI)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_MappedRegion_advise0(JNIEnv* env, jclass cls, jlong address, jlong length, jint advice) {
+  if (madvise((void*)(uintptr_t)address, (size_t)length, advice)!=0) throwErrno(env, errno, NULL);
+}
+
+/*
+ * Class:     com_aoapps_io_posix_MappedRegion
+ * Method:    sync0
+ * Signature: (JJZ)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_MappedRegion_sync0(JNIEnv* env, jclass cls, jlong address, jlong length, jboolean async) {
+  if (msync((void*)(uintptr_t)address, (size_t)length, async==JNI_TRUE ? MS_ASYNC : MS_SYNC)!=0) throwErrno(env, errno, NULL);
+}
+
+/*
+ * Class:     com_aoapps_io_posix_MappedRegion
+ * Method:    unmap0
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_MappedRegion_unmap0(JNIEnv* env, jclass cls, jlong address, jlong length) {
+  if (munmap((void*)(uintptr_t)address, (size_t)length)!=0) throwErrno(env, errno, NULL);
+}
+
+static const JNINativeMethod methods[]={
+  {"getPageSize0", "()J", (void*)Java_com_aoapps_io_posix_MappedRegion_getPageSize0},
+  {"newBuffer0", "(JI)Ljava/nio/ByteBuffer;", (void*)Java_com_aoapps_io_posix_MappedRegion_newBuffer0},
+  {"advise0", "(JJI)V", (void*)Java_com_aoapps_io_posix_MappedRegion_advise0},
+  {"sync0", "(JJZ)V", (void*)Java_com_aoapps_io_posix_MappedRegion_sync0},
+  {"unmap0", "(JJ)V", (void*)Java_com_aoapps_io_posix_MappedRegion_unmap0}
+};
+
+jint registerMappedRegionNatives(JNIEnv* env) {
+  return registerNatives(env, "com/aoapps/io/posix/MappedRegion", methods, sizeof(methods)/sizeof(methods[0]));
+}
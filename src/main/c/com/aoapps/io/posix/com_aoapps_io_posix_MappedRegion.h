@@ -0,0 +1,73 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_aoapps_io_posix_MappedRegion */
+
+#ifndef _Included_com_aoapps_io_posix_MappedRegion
+#define _Included_com_aoapps_io_posix_MappedRegion
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef com_aoapps_io_posix_MappedRegion_MAP_PRIVATE
+#define com_aoapps_io_posix_MappedRegion_MAP_PRIVATE 2L
+#undef com_aoapps_io_posix_MappedRegion_MAP_POPULATE
+#define com_aoapps_io_posix_MappedRegion_MAP_POPULATE 32768L
+#undef com_aoapps_io_posix_MappedRegion_MAP_HUGETLB
+#define com_aoapps_io_posix_MappedRegion_MAP_HUGETLB 262144L
+#undef com_aoapps_io_posix_MappedRegion_MADV_NORMAL
+#define com_aoapps_io_posix_MappedRegion_MADV_NORMAL 0L
+#undef com_aoapps_io_posix_MappedRegion_MADV_RANDOM
+#define com_aoapps_io_posix_MappedRegion_MADV_RANDOM 1L
+#undef com_aoapps_io_posix_MappedRegion_MADV_SEQUENTIAL
+#define com_aoapps_io_posix_MappedRegion_MADV_SEQUENTIAL 2L
+#undef com_aoapps_io_posix_MappedRegion_MADV_WILLNEED
+#define com_aoapps_io_posix_MappedRegion_MADV_WILLNEED 3L
+#undef com_aoapps_io_posix_MappedRegion_MADV_DONTNEED
+#define com_aoapps_io_posix_MappedRegion_MADV_DONTNEED 4L
+#undef com_aoapps_io_posix_MappedRegion_MADV_HUGEPAGE
+#define com_aoapps_io_posix_MappedRegion_MADV_HUGEPAGE 14L
+#undef com_aoapps_io_posix_MappedRegion_MADV_NOHUGEPAGE
+#define com_aoapps_io_posix_MappedRegion_MADV_NOHUGEPAGE 15L
+/*
+ * Class:     com_aoapps_io_posix_MappedRegion
+ * Method:    getPageSize0
+ * Signature: ()J
+ */
+JNIEXPORT jlong JNICALL Java_com_aoapps_io_posix_MappedRegion_getPageSize0
+  (JNIEnv *, jclass);
+
+/*
+ * Class:     com_aoapps_io_posix_MappedRegion
+ * Method:    newBuffer0
+ * Signature: (JI)Ljava/nio/ByteBuffer;
+ */
+JNIEXPORT jobject JNICALL Java_com_aoapps_io_posix_MappedRegion_newBuffer0
+  (JNIEnv *, jclass, jlong, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_MappedRegion
+ * Method:    advise0
+ * Signature: (JJI)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_MappedRegion_advise0
+  (JNIEnv *, jclass, jlong, jlong, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_MappedRegion
+ * Method:    sync0
+ * Signature: (JJZ)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_MappedRegion_sync0
+  (JNIEnv *, jclass, jlong, jlong, jboolean);
+
+/*
+ * Class:     com_aoapps_io_posix_MappedRegion
+ * Method:    unmap0
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_MappedRegion_unmap0
+  (JNIEnv *, jclass, jlong, jlong);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -1,6 +1,6 @@
 /*
  * ao-io-posix - Java interface to native POSIX filesystem objects.
- * Copyright (C) 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007, 2008, 2009, 2010, 2011, 2015, 2016, 2021, 2022  AO Industries, Inc.
+ * Copyright (C) 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007, 2008, 2009, 2010, 2011, 2015, 2016, 2021, 2022, 2026  AO Industries, Inc.
  *     support@aoindustries.com
  *     7262 Bull Pen Cir
  *     Mobile, AL 36695
@@ -20,18 +20,33 @@
  * You should have received a copy of the GNU Lesser General Public License
  * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
  */
+#define _GNU_SOURCE
 #include <crypt.h>
 #include <jni.h>
 #include "aocode_shared.h"
+#include "aocode_copy.h"
+#include "aocode_pool.h"
+#include "aocode_range.h"
+#include "aocode_search.h"
+#include "aocode_symlink.h"
+#include "aocode_walk.h"
 #include "jni_util.h"
 #include "com_aoapps_io_posix_PosixFile.h"
 #include <errno.h>
 #include <fcntl.h>
+#include <limits.h>
+#include <linux/fs.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
+#include <time.h>
 #include <unistd.h>
 #include <utime.h>
 
@@ -59,99 +74,26 @@ JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFile_chown0(JNIEnv* env, jc
  * Signature: (Ljava/lang/String;)Lcom/aoapps/io/posix/Stat;
  */
 JNIEXPORT jobject JNICALL Java_com_aoapps_io_posix_PosixFile_getStat0(JNIEnv* env, jobject jthis, jstring jfilename) {
-  jclass newExcCls=NULL;
   jobject stat=NULL;
   const char* filename=getString8859_1Chars(env, jfilename);
   if (filename!=NULL) {
-    // Perform the stat into the stat buffer
-    struct stat* buff=(struct stat*)malloc(sizeof(struct stat));
-    if (buff!=NULL) {
-      jboolean exists;
-      jlong device;
-      jlong inode;
-      jlong mode;
-      jint numberLinks;
-      jint uid;
-      jint gid;
-      jlong deviceIdentifier;
-      jlong size;
-      jint blockSize;
-      jlong blockCount;
-      jlong accessTime;
-      jlong modifyTime;
-      jlong changeTime;
-      if (lstat(filename, buff)==0) {
-        exists           = JNI_TRUE;
-        device           = (jlong)buff->st_dev;
-        inode            = (jlong)buff->st_ino;
-        mode             = (jlong)buff->st_mode;
-        numberLinks      = (jint)buff->st_nlink;
-        uid              = (jint)buff->st_uid;
-        gid              = (jint)buff->st_gid;
-        deviceIdentifier = (jlong)buff->st_rdev;
-        size             = (jlong)buff->st_size;
-        blockSize        = (jint)buff->st_blksize;
-        blockCount       = (jlong)buff->st_blocks;
-        accessTime       = ((jlong)(buff->st_atime))*1000;
-        modifyTime       = ((jlong)(buff->st_mtime))*1000;
-        changeTime       = ((jlong)(buff->st_ctime))*1000;
-      } else if (errno==ENOENT || errno==ENOTDIR) {
-        exists           = JNI_FALSE;
-        // Unused: device           = 0;
-        // Unused: inode            = 0;
-        // Unused: mode             = 0;
-        // Unused: numberLinks      = 0;
-        // Unused: uid              = 0;
-        // Unused: gid              = 0;
-        // Unused: deviceIdentifier = 0;
-        // Unused: size             = 0;
-        // Unused: blockSize        = 0;
-        // Unused: blockCount       = 0;
-        // Unused: accessTime       = 0;
-        // Unused: modifyTime       = 0;
-        // Unused: changeTime       = 0;
-      } else newExcCls=(*env)->FindClass(env, getErrorType(errno));
-      free(buff);
-      if (newExcCls==NULL) {
-        jclass statClass=(*env)->FindClass(env, "com/aoapps/io/posix/Stat");
-        if (statClass!=NULL) {
-          if (exists == JNI_FALSE) {
-            // not exists, return the static field
-            jfieldID field = (*env)->GetStaticFieldID(env, statClass, "NOT_EXISTS", "Lcom/aoapps/io/posix/Stat;");
-            if (field!=NULL) {
-              stat = (*env)->GetStaticObjectField(env, statClass, field);
-            }
-          } else {
-            // exists, return a new object
-            jmethodID constructor = (*env)->GetMethodID(env, statClass, "<init>", "(ZJJJIIIJJIJJJJ)V");
-            if (constructor!=NULL) {
-              stat = (*env)->NewObject(
-                env,
-                statClass,
-                constructor,
-                exists,
-                device,
-                inode,
-                mode,
-                numberLinks,
-                uid,
-                gid,
-                deviceIdentifier,
-                size,
-                blockSize,
-                blockCount,
-                accessTime,
-                modifyTime,
-                changeTime
-              );
-            }
-          }
+    // Perform the stat into the stat buffer, including the statx attributes
+    aocode_stat buff;
+    if (aocode_fstatat(AT_FDCWD, filename, &buff, AT_SYMLINK_NOFOLLOW|AT_NO_AUTOMOUNT)==0) {
+      // exists, return a new object
+      stat=newStat(env, &buff);
+    } else if (errno==ENOENT || errno==ENOTDIR) {
+      // not exists, return the static field
+      jclass statClass=(*env)->FindClass(env, "com/aoapps/io/posix/Stat");
+      if (statClass!=NULL) {
+        jfieldID field = (*env)->GetStaticFieldID(env, statClass, "NOT_EXISTS", "Lcom/aoapps/io/posix/Stat;");
+        if (field!=NULL) {
+          stat = (*env)->GetStaticObjectField(env, statClass, field);
         }
       }
-    } else newExcCls=(*env)->FindClass(env, getErrorType(errno));
+    } else throwErrno(env, errno, NULL);
     releaseString8859_1Chars(filename);
   }
-  if (newExcCls!=NULL) (*env)->ThrowNew(env, newExcCls, strerror(errno));
   return stat;
 }
 
@@ -342,3 +284,1520 @@ JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFile_utime0(JNIEnv* env, jc
   if (newExcCls!=NULL) (*env)->ThrowNew(env, newExcCls, strerror(errno));
   return;
 }
+
+// The inode flags that may be changed by FS_IOC_SETFLAGS, matching chattr
+#define AOCODE_USER_MODIFIABLE_FL ( \
+  FS_SECRM_FL | FS_UNRM_FL | FS_COMPR_FL | FS_SYNC_FL | FS_IMMUTABLE_FL | FS_APPEND_FL | FS_NODUMP_FL \
+  | FS_NOATIME_FL | FS_JOURNAL_DATA_FL | FS_NOTAIL_FL | FS_DIRSYNC_FL | FS_TOPDIR_FL | FS_NOCOW_FL \
+  | FS_PROJINHERIT_FL \
+)
+
+// Opens a file for FS_IOC_GETFLAGS and FS_IOC_SETFLAGS without following a final symbolic link or blocking on FIFOs
+static int openForFlags(int dirfd, const char* name) {
+  return openat(dirfd, name, O_RDONLY|O_NONBLOCK|O_NOFOLLOW|O_NOCTTY|O_CLOEXEC);
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    getFlags0
+ * Signature: (Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_com_aoapps_io_posix_PosixFile_getFlags0(JNIEnv* env, jclass cls, jstring jfilename) {
+  jint flags=0;
+  const char* filename=getString8859_1Chars(env, jfilename);
+  if (filename!=NULL) {
+    int fd=openForFlags(AT_FDCWD, filename);
+    if (fd!=-1) {
+      int fsFlags;
+      if (ioctl(fd, FS_IOC_GETFLAGS, &fsFlags)==0) flags=fsFlags;
+      else throwErrno(env, errno, NULL);
+      close(fd);
+    } else throwErrno(env, errno, NULL);
+    releaseString8859_1Chars(filename);
+  }
+  return flags;
+}
+
+// Identifies the operation written to a walk checkpoint
+#define CHECKPOINT_CHATTR 1
+#define CHECKPOINT_DELETE 2
+#define CHECKPOINT_SECURE_DELETE 3
+
+typedef struct chattr_ctx {
+  int addFlags;
+  int removeFlags;
+  int recursive;
+} chattr_ctx;
+
+// Applies the flags to regular files and directories, other types are skipped when recursive
+static int chattr_visit(aocode_walk_entry* entry, void* ctx) {
+  chattr_ctx* chattr=(chattr_ctx*)ctx;
+  mode_t mode=entry->stat.st.st_mode;
+  if (S_ISREG(mode) || S_ISDIR(mode)) {
+    int err=0;
+    int fd=openForFlags(entry->dirfd, entry->name);
+    if (fd==-1) return errno==ENOENT && entry->depth>0 ? 0 : errno;
+    int oldFlags;
+    if (ioctl(fd, FS_IOC_GETFLAGS, &oldFlags)==0) {
+      int newFlags=(oldFlags | chattr->addFlags) & ~chattr->removeFlags;
+      if (newFlags!=oldFlags && ioctl(fd, FS_IOC_SETFLAGS, &newFlags)!=0) err=errno;
+    } else err=errno;
+    close(fd);
+    if (err!=0) return err;
+  } else if (!chattr->recursive) {
+    return EOPNOTSUPP;
+  }
+  return chattr->recursive ? 0 : AOCODE_WALK_SKIP;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    chattr0
+ * Signature: (Ljava/lang/String;IIZLjava/lang/String;I)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFile_chattr0(JNIEnv* env, jclass cls, jstring jfilename, jint addFlags, jint removeFlags, jboolean recursive, jstring jcheckpoint, jint flags) {
+  const char* filename=getString8859_1Chars(env, jfilename);
+  if (filename!=NULL) {
+    const char* checkpoint=jcheckpoint==NULL ? NULL : getString8859_1Chars(env, jcheckpoint);
+    if (jcheckpoint==NULL || checkpoint!=NULL) {
+      chattr_ctx chattr;
+      chattr.addFlags=addFlags & AOCODE_USER_MODIFIABLE_FL;
+      chattr.removeFlags=removeFlags & AOCODE_USER_MODIFIABLE_FL;
+      chattr.recursive=recursive==JNI_TRUE;
+      aocode_walk walk;
+      aocode_walk_init(&walk, chattr_visit, NULL, &chattr, flags);
+      walk.checkpoint=checkpoint;
+      walk.checkpointOp[0]=CHECKPOINT_CHATTR;
+      walk.checkpointOp[1]=chattr.addFlags;
+      walk.checkpointOp[2]=chattr.removeFlags;
+      if (aocode_walk_tree(&walk, filename)!=0) aocode_walk_throw(env, &walk);
+      aocode_walk_destroy(&walk);
+      if (checkpoint!=NULL) releaseString8859_1Chars(checkpoint);
+    }
+    releaseString8859_1Chars(filename);
+  }
+  return;
+}
+
+// Removes each entry after the contents of directories have been removed
+static int delete_visit(aocode_walk_entry* entry, void* ctx) {
+  aocode_walk* walk=(aocode_walk*)ctx;
+  if (unlinkat(entry->dirfd, entry->name, S_ISDIR(entry->stat.st.st_mode) ? AT_REMOVEDIR : 0)!=0) {
+    // OK if it was deleted while we're trying to delete it
+    if (errno==ENOENT && entry->depth>0) return 0;
+    // Directories containing skipped mount points cannot be removed
+    if ((errno==ENOTEMPTY || errno==EBUSY) && entry->skippedMount) return 0;
+    return errno;
+  }
+  return 0;
+}
+
+// Secures each directory before its contents are listed
+static int secureDelete_visit(aocode_walk_entry* entry, void* ctx) {
+  const struct stat* st=&entry->stat.st;
+  // Race condition does not exist because the parents have been secured already
+  if (S_ISDIR(st->st_mode)) {
+    if (
+      (st->st_uid!=0 || st->st_gid!=0)
+      && fchownat(entry->dirfd, entry->name, 0, 0, AT_SYMLINK_NOFOLLOW)!=0
+    ) return errno;
+    if (
+      (st->st_mode & 07777)!=0700
+      && fchmodat(entry->dirfd, entry->name, 0700, 0)!=0
+    ) return errno;
+  }
+  return 0;
+}
+
+// Deletes a tree, throwing an exception on failure
+static void deleteTree(JNIEnv* env, jstring jfilename, jstring jcheckpoint, jint flags, jboolean secure) {
+  const char* filename=getString8859_1Chars(env, jfilename);
+  if (filename==NULL) return;
+  const char* checkpoint=jcheckpoint==NULL ? NULL : getString8859_1Chars(env, jcheckpoint);
+  if (jcheckpoint==NULL || checkpoint!=NULL) {
+    aocode_walk walk;
+    aocode_walk_init(&walk, secure ? secureDelete_visit : NULL, delete_visit, NULL, flags);
+    walk.ctx=&walk;
+    walk.checkpoint=checkpoint;
+    walk.checkpointOp[0]=secure ? CHECKPOINT_SECURE_DELETE : CHECKPOINT_DELETE;
+    if (aocode_walk_tree(&walk, filename)!=0) {
+      // OK if it does not exist, unless securely deleting
+      if (
+        secure
+        || walk.err!=ENOENT
+        || walk.errPath==NULL
+        || strcmp(walk.errPath, filename)!=0
+      ) {
+        aocode_walk_throw(env, &walk);
+      } else if (checkpoint!=NULL && unlink(checkpoint)!=0 && errno!=ENOENT) {
+        // Already deleted, the checkpoint is no longer needed
+        throwErrno(env, errno, checkpoint);
+      }
+    } else if (walk.skippedMounts>0) {
+      // Report the mount points left behind
+      char message[256];
+      snprintf(
+        message,
+        sizeof(message),
+        "Mount point not removed (%zu total): %s",
+        walk.skippedMounts,
+        walk.skippedPath==NULL ? "" : walk.skippedPath
+      );
+      JNU_ThrowByName(env, IO_EXCEPTION, message);
+    }
+    aocode_walk_destroy(&walk);
+    if (checkpoint!=NULL) releaseString8859_1Chars(checkpoint);
+  }
+  releaseString8859_1Chars(filename);
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    deleteRecursive0
+ * Signature: (Ljava/lang/String;Ljava/lang/String;I)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFile_deleteRecursive0(JNIEnv* env, jclass cls, jstring jfilename, jstring jcheckpoint, jint flags) {
+  deleteTree(env, jfilename, jcheckpoint, flags, JNI_FALSE);
+  return;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    secureDeleteRecursive0
+ * Signature: (Ljava/lang/String;Ljava/lang/String;I)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFile_secureDeleteRecursive0(JNIEnv* env, jclass cls, jstring jfilename, jstring jcheckpoint, jint flags) {
+  deleteTree(env, jfilename, jcheckpoint, flags, JNI_TRUE);
+  return;
+}
+
+// The encoded form of a file handle: big-endian handle type and mount id followed by the handle bytes
+#define FILE_HANDLE_HEADER 8
+
+static void putInt(unsigned char* buff, int value) {
+  buff[0]=(unsigned char)(value>>24);
+  buff[1]=(unsigned char)(value>>16);
+  buff[2]=(unsigned char)(value>>8);
+  buff[3]=(unsigned char)value;
+}
+
+static int getInt(const unsigned char* buff) {
+  return (int)(((unsigned int)buff[0]<<24) | ((unsigned int)buff[1]<<16) | ((unsigned int)buff[2]<<8) | (unsigned int)buff[3]);
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    getFileHandle0
+ * Signature: (Ljava/lang/String;)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_com_aoapps_io_posix_PosixFile_getFileHandle0(JNIEnv* env, jclass cls, jstring jfilename) {
+  jbyteArray encoded=NULL;
+  const char* filename=getString8859_1Chars(env, jfilename);
+  if (filename!=NULL) {
+    struct file_handle* handle=(struct file_handle*)malloc(sizeof(struct file_handle)+MAX_HANDLE_SZ);
+    if (handle!=NULL) {
+      int mountId;
+      handle->handle_bytes=MAX_HANDLE_SZ;
+      if (name_to_handle_at(AT_FDCWD, filename, handle, &mountId, 0)==0) {
+        unsigned char header[FILE_HANDLE_HEADER];
+        putInt(header, handle->handle_type);
+        putInt(header+4, mountId);
+        encoded=(*env)->NewByteArray(env, FILE_HANDLE_HEADER+handle->handle_bytes);
+        if (encoded!=NULL) {
+          (*env)->SetByteArrayRegion(env, encoded, 0, FILE_HANDLE_HEADER, (const jbyte*)header);
+          (*env)->SetByteArrayRegion(env, encoded, FILE_HANDLE_HEADER, handle->handle_bytes, (const jbyte*)handle->f_handle);
+        }
+      } else throwErrno(env, errno, NULL);
+      free(handle);
+    } else throwErrno(env, errno, NULL);
+    releaseString8859_1Chars(filename);
+  }
+  return encoded;
+}
+
+// The least time between checking whether a mount id has been reused, in seconds
+#define MOUNT_RECHECK_INTERVAL 1
+
+/*
+ * An open mount point used by open_by_handle_at.  The descriptor is shared by concurrent callers, so it is only
+ * closed once it is no longer cached and the last caller has released it.
+ */
+typedef struct mount_fd {
+  int mountId;
+  int fd;
+  int refs;       // The callers using fd, plus one while cached
+  time_t checked; // When the mount was last opened or checked, in monotonic seconds
+} mount_fd;
+
+static pthread_mutex_t mountFdsLock=PTHREAD_MUTEX_INITIALIZER;
+static mount_fd** mountFds=NULL;
+static size_t mountFdCount=0;
+static size_t mountFdCap=0;
+
+// Finds the mount point for a mount id from /proc/self/mountinfo, returns a new string or NULL with errno set
+static char* findMountPoint(int mountId) {
+  FILE* mountinfo=fopen("/proc/self/mountinfo", "re");
+  if (mountinfo==NULL) return NULL;
+  char* mountPoint=NULL;
+  char* line=NULL;
+  size_t lineCap=0;
+  while (mountPoint==NULL && getline(&line, &lineCap, mountinfo)!=-1) {
+    char* saveptr;
+    char* field=strtok_r(line, " ", &saveptr);
+    if (field==NULL || atoi(field)!=mountId) continue;
+    int c;
+    for (c=1; c<5 && field!=NULL; c++) field=strtok_r(NULL, " ", &saveptr);
+    if (field==NULL) continue;
+    // Decode the octal escapes
+    char* out=field;
+    char* in=field;
+    while (*in!='\0') {
+      if (in[0]=='\\' && in[1]>='0' && in[1]<='7' && in[2]>='0' && in[2]<='7' && in[3]>='0' && in[3]<='7') {
+        *out++=(char)(((in[1]-'0')<<6) | ((in[2]-'0')<<3) | (in[3]-'0'));
+        in+=4;
+      } else {
+        *out++=*in++;
+      }
+    }
+    *out='\0';
+    mountPoint=strdup(field);
+    if (mountPoint==NULL) errno=ENOMEM;
+  }
+  free(line);
+  fclose(mountinfo);
+  if (mountPoint==NULL && errno==0) errno=ESTALE;
+  return mountPoint;
+}
+
+static time_t mountNow() {
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return now.tv_sec;
+}
+
+/*
+ * Opens the mount point of a mount id, verifying the opened directory is on that mount, since another mount may
+ * be stacked over the same path.  Returns the descriptor or -1 with errno set, ESTALE when the mount is gone or
+ * EXDEV when its mount point is covered by another mount.
+ */
+static int openMountFd(int mountId) {
+  errno=0;
+  char* mountPoint=findMountPoint(mountId);
+  if (mountPoint==NULL) return -1;
+  int fd=open(mountPoint, O_PATH|O_DIRECTORY|O_CLOEXEC);
+  free(mountPoint);
+  if (fd==-1) return -1;
+  struct file_handle* handle=(struct file_handle*)malloc(sizeof(struct file_handle)+MAX_HANDLE_SZ);
+  if (handle==NULL) {
+    close(fd);
+    errno=ENOMEM;
+    return -1;
+  }
+  handle->handle_bytes=MAX_HANDLE_SZ;
+  int fdMountId;
+  int ok=name_to_handle_at(fd, "", handle, &fdMountId, AT_EMPTY_PATH)==0;
+  int err=errno;
+  free(handle);
+  if (!ok || fdMountId!=mountId) {
+    close(fd);
+    errno=ok ? EXDEV : err;
+    return -1;
+  }
+  return fd;
+}
+
+// Finds the cached mount, returns its index or -1, must hold mountFdsLock
+static ssize_t findMountFd(int mountId) {
+  size_t c;
+  for (c=0; c<mountFdCount; c++) {
+    if (mountFds[c]->mountId==mountId) return (ssize_t)c;
+  }
+  return -1;
+}
+
+// Releases one reference, closing the descriptor after the last, must hold mountFdsLock
+static void unrefMountFd(mount_fd* mount) {
+  if (--mount->refs==0) {
+    close(mount->fd);
+    free(mount);
+  }
+}
+
+/*
+ * Caches a newly opened mount unless another thread cached the same mount id first, must hold mountFdsLock.
+ * Returns the cached mount with a reference for the caller, or NULL with errno set, closing fd unless cached.
+ */
+static mount_fd* cacheMountFd(int mountId, int fd) {
+  ssize_t index=findMountFd(mountId);
+  if (index!=-1) {
+    mount_fd* mount=mountFds[index];
+    mount->refs++;
+    close(fd);
+    return mount;
+  }
+  if (mountFdCount==mountFdCap) {
+    size_t newCap=mountFdCap==0 ? 16 : mountFdCap<<1;
+    mount_fd** newMountFds=(mount_fd**)realloc(mountFds, newCap*sizeof(mount_fd*));
+    if (newMountFds!=NULL) {
+      mountFds=newMountFds;
+      mountFdCap=newCap;
+    }
+  }
+  mount_fd* mount=mountFdCount<mountFdCap ? (mount_fd*)malloc(sizeof(mount_fd)) : NULL;
+  if (mount==NULL) {
+    close(fd);
+    errno=ENOMEM;
+    return NULL;
+  }
+  mount->mountId=mountId;
+  mount->fd=fd;
+  mount->refs=2;
+  mount->checked=mountNow();
+  mountFds[mountFdCount++]=mount;
+  return mount;
+}
+
+/*
+ * Gets the cached mount, opening it on first use, returns NULL with errno set on failure.
+ * The mount must be released with releaseMountFd.
+ *
+ * The mount point is opened without holding mountFdsLock, since opening a hung remote mount blocks, and must not
+ * stall the callers using other mounts.
+ */
+static mount_fd* acquireMountFd(int mountId) {
+  pthread_mutex_lock(&mountFdsLock);
+  ssize_t index=findMountFd(mountId);
+  if (index!=-1) {
+    mount_fd* mount=mountFds[index];
+    mount->refs++;
+    pthread_mutex_unlock(&mountFdsLock);
+    return mount;
+  }
+  pthread_mutex_unlock(&mountFdsLock);
+  int fd=openMountFd(mountId);
+  if (fd==-1) return NULL;
+  pthread_mutex_lock(&mountFdsLock);
+  mount_fd* mount=cacheMountFd(mountId, fd);
+  int err=errno;
+  pthread_mutex_unlock(&mountFdsLock);
+  errno=err;
+  return mount;
+}
+
+static void releaseMountFd(mount_fd* mount) {
+  pthread_mutex_lock(&mountFdsLock);
+  unrefMountFd(mount);
+  pthread_mutex_unlock(&mountFdsLock);
+}
+
+/*
+ * Checks whether a mount id has been reused by a new mount after open_by_handle_at failed with ESTALE, which is
+ * also the normal result for a deleted file.  Checks at most once per MOUNT_RECHECK_INTERVAL for each mount.
+ * The cached mount is replaced only when its mount id now names a different mount, or forgotten when the mount is
+ * gone.  Returns whether a different mount is now cached, so the call should be retried.
+ *
+ * The caller holds a reference to mount.  As in acquireMountFd, the mount point is opened without the lock.
+ */
+static int recheckMountFd(mount_fd* mount) {
+  pthread_mutex_lock(&mountFdsLock);
+  ssize_t index=findMountFd(mount->mountId);
+  if (index==-1 || mountFds[index]!=mount) {
+    // Already replaced by another thread
+    pthread_mutex_unlock(&mountFdsLock);
+    return index!=-1;
+  }
+  time_t now=mountNow();
+  if (now-mount->checked<MOUNT_RECHECK_INTERVAL) {
+    pthread_mutex_unlock(&mountFdsLock);
+    return 0;
+  }
+  // Claims the check, so concurrent callers do not repeat it
+  mount->checked=now;
+  pthread_mutex_unlock(&mountFdsLock);
+  int fd=openMountFd(mount->mountId);
+  int gone=fd==-1 && errno==ESTALE;
+  int different=0;
+  if (fd!=-1) {
+    struct stat oldSt;
+    struct stat newSt;
+    different=
+      fstat(mount->fd, &oldSt)==0 && fstat(fd, &newSt)==0
+      && (oldSt.st_dev!=newSt.st_dev || oldSt.st_ino!=newSt.st_ino);
+  }
+  mount_fd* newMount=different ? (mount_fd*)malloc(sizeof(mount_fd)) : NULL;
+  int replaced=0;
+  pthread_mutex_lock(&mountFdsLock);
+  index=findMountFd(mount->mountId);
+  if (index==-1 || mountFds[index]!=mount) {
+    // Replaced or forgotten by another thread meanwhile
+    replaced=index!=-1;
+  } else if (gone) {
+    // Forgets a mount that is gone, but not one that could not be checked
+    mountFds[index]=mountFds[--mountFdCount];
+    unrefMountFd(mount);
+  } else if (newMount!=NULL) {
+    newMount->mountId=mount->mountId;
+    newMount->fd=fd;
+    newMount->refs=1;
+    newMount->checked=now;
+    mountFds[index]=newMount;
+    unrefMountFd(mount);
+    newMount=NULL;
+    fd=-1;
+    replaced=1;
+  }
+  pthread_mutex_unlock(&mountFdsLock);
+  free(newMount);
+  if (fd!=-1) close(fd);
+  return replaced;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    openByHandle0
+ * Signature: ([BI)Ljava/io/FileDescriptor;
+ */
+JNIEXPORT jobject JNICALL Java_com_aoapps_io_posix_PosixFile_openByHandle0(JNIEnv* env, jclass cls, jbyteArray jencoded, jint flags) {
+  jobject fileDescriptor=NULL;
+  jsize len=(*env)->GetArrayLength(env, jencoded);
+  if (len<FILE_HANDLE_HEADER || len>FILE_HANDLE_HEADER+MAX_HANDLE_SZ) {
+    JNU_ThrowByName(env, ILLEGAL_ARGUMENT_EXCEPTION, "Invalid file handle");
+    return NULL;
+  }
+  struct file_handle* handle=(struct file_handle*)malloc(sizeof(struct file_handle)+MAX_HANDLE_SZ);
+  if (handle!=NULL) {
+    unsigned char header[FILE_HANDLE_HEADER];
+    (*env)->GetByteArrayRegion(env, jencoded, 0, FILE_HANDLE_HEADER, (jbyte*)header);
+    (*env)->GetByteArrayRegion(env, jencoded, FILE_HANDLE_HEADER, len-FILE_HANDLE_HEADER, (jbyte*)handle->f_handle);
+    handle->handle_type=getInt(header);
+    handle->handle_bytes=len-FILE_HANDLE_HEADER;
+    int mountId=getInt(header+4);
+    int fd=-1;
+    int retry;
+    for (retry=0; retry<2; retry++) {
+      mount_fd* mount=acquireMountFd(mountId);
+      if (mount==NULL) break;
+      fd=open_by_handle_at(mount->fd, handle, flags|O_CLOEXEC);
+      int err=errno;
+      // The mount id may have been reused by a new mount
+      int again=fd==-1 && err==ESTALE && retry==0 && recheckMountFd(mount);
+      releaseMountFd(mount);
+      errno=err;
+      if (!again) break;
+    }
+    if (fd!=-1) {
+      fileDescriptor=newFileDescriptor(env, fd);
+      if (fileDescriptor==NULL) close(fd);
+    } else throwErrno(env, errno, NULL);
+    free(handle);
+  } else throwErrno(env, errno, NULL);
+  return fileDescriptor;
+}
+
+// One copy or comparison run on the worker pool
+typedef struct bulk_task {
+  aocode_pool_task task;
+  const char* path1;
+  const char* path2;
+  int overwrite;
+  off_t maxDirty;
+  int equal;
+  const char* errPath;
+} bulk_task;
+
+static int bulk_copy_run(aocode_pool_task* task, char* buff, size_t buffSize) {
+  bulk_task* bulk=(bulk_task*)task;
+  return aocode_copy_file(bulk->path1, bulk->path2, bulk->overwrite, bulk->maxDirty, buff, buffSize, &bulk->errPath);
+}
+
+static int bulk_compare_run(aocode_pool_task* task, char* buff, size_t buffSize) {
+  bulk_task* bulk=(bulk_task*)task;
+  return aocode_compare_files(bulk->path1, bulk->path2, buff, buffSize, &bulk->equal, &bulk->errPath);
+}
+
+// The node of one parent directory of a bulk run, so each distinct directory is only stat'ed once
+typedef struct bulk_parent {
+  const char* path; // Points into the first path of a task, NULL when unused
+  size_t len;
+  int node;
+} bulk_parent;
+
+// Finds the node of the parent directory of path in the open-addressed table
+static int bulk_parent_node(bulk_parent* parents, size_t mask, const char* path) {
+  const char* slash=strrchr(path, '/');
+  size_t len=slash==NULL ? 0 : slash==path ? 1 : (size_t)(slash-path);
+  size_t hash=2166136261u;
+  size_t i;
+  for (i=0; i<len; i++) hash=(hash^(unsigned char)path[i])*16777619u;
+  for (i=hash&mask; parents[i].path!=NULL; i=(i+1)&mask) {
+    if (parents[i].len==len && memcmp(parents[i].path, path, len)==0) return parents[i].node;
+  }
+  int node=-1;
+  char dir[PATH_MAX];
+  struct stat st;
+  if (len<sizeof(dir)) {
+    if (len==0) {
+      dir[0]='.';
+      dir[1]=0;
+    } else {
+      memcpy(dir, path, len);
+      dir[len]=0;
+    }
+    if (stat(dir, &st)==0) node=aocode_pool_node_of_dev(st.st_dev);
+  }
+  parents[i].path=path;
+  parents[i].len=len;
+  parents[i].node=node;
+  return node;
+}
+
+/*
+ * Runs one task per pair of paths on the worker pool, each on the node closest to the device of the directory
+ * of its first path.  Returns the equal results of comparisons, or NULL with an exception pending on failure,
+ * which is the failure that happened first.
+ */
+static jbooleanArray bulk_run(JNIEnv* env, jobjectArray jpaths1, jobjectArray jpaths2, int compare, int overwrite, off_t maxDirty) {
+  jsize count=(*env)->GetArrayLength(env, jpaths1);
+  if ((*env)->GetArrayLength(env, jpaths2)!=count) {
+    JNU_ThrowByName(env, ILLEGAL_ARGUMENT_EXCEPTION, "Different number of paths");
+    return NULL;
+  }
+  bulk_task* tasks=(bulk_task*)calloc(count==0 ? 1 : count, sizeof(bulk_task));
+  aocode_pool_task** taskPtrs=(aocode_pool_task**)malloc((count==0 ? 1 : count)*sizeof(aocode_pool_task*));
+  if (tasks==NULL || taskPtrs==NULL) {
+    free(tasks);
+    free(taskPtrs);
+    JNU_ThrowOutOfMemoryError(env, NULL);
+    return NULL;
+  }
+  size_t parentCap=1;
+  while (parentCap<(size_t)count*2) parentCap<<=1;
+  // Without the table every task may run on any node
+  bulk_parent* parents=(bulk_parent*)calloc(parentCap, sizeof(bulk_parent));
+  jsize converted=0;
+  int ok=1;
+  while (ok && converted<count) {
+    bulk_task* task=&tasks[converted];
+    jstring jpath1=(jstring)(*env)->GetObjectArrayElement(env, jpaths1, converted);
+    jstring jpath2=(jstring)(*env)->GetObjectArrayElement(env, jpaths2, converted);
+    task->path1=jpath1==NULL ? NULL : getString8859_1Chars(env, jpath1);
+    task->path2=task->path1==NULL || jpath2==NULL ? NULL : getString8859_1Chars(env, jpath2);
+    if (jpath1!=NULL) (*env)->DeleteLocalRef(env, jpath1);
+    if (jpath2!=NULL) (*env)->DeleteLocalRef(env, jpath2);
+    if (task->path2==NULL) {
+      if (task->path1!=NULL) releaseString8859_1Chars(task->path1);
+      if (!(*env)->ExceptionCheck(env)) JNU_ThrowByName(env, ILLEGAL_ARGUMENT_EXCEPTION, "Null path");
+      ok=0;
+      break;
+    }
+    task->task.run=compare ? bulk_compare_run : bulk_copy_run;
+    task->task.node=parents==NULL ? -1 : bulk_parent_node(parents, parentCap-1, task->path1);
+    task->overwrite=overwrite;
+    task->maxDirty=maxDirty;
+    taskPtrs[converted]=&task->task;
+    converted++;
+  }
+  free(parents);
+  jbooleanArray results=NULL;
+  if (ok) {
+    if (aocode_pool_run(taskPtrs, count)!=0) {
+      jsize c;
+      for (c=0; c<count; c++) {
+        int err=tasks[c].task.err;
+        if (tasks[c].task.first) {
+          if (err==AOCODE_NOT_REGULAR_FILE) {
+            char message[PATH_MAX+32];
+            snprintf(message, sizeof(message), "Not a regular file: %s", tasks[c].errPath);
+            JNU_ThrowByName(env, IO_EXCEPTION, message);
+          } else {
+            throwErrno(env, err, tasks[c].errPath);
+          }
+          break;
+        }
+      }
+    } else if (compare) {
+      results=(*env)->NewBooleanArray(env, count);
+      if (results!=NULL) {
+        jsize c;
+        for (c=0; c<count; c++) {
+          jboolean equal=tasks[c].equal ? JNI_TRUE : JNI_FALSE;
+          (*env)->SetBooleanArrayRegion(env, results, c, 1, &equal);
+        }
+      }
+    }
+  }
+  jsize c;
+  for (c=0; c<converted; c++) {
+    releaseString8859_1Chars(tasks[c].path1);
+    releaseString8859_1Chars(tasks[c].path2);
+  }
+  free(taskPtrs);
+  free(tasks);
+  return results;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    copyFiles0
+ * Signature: ([Ljava/lang/String;[Ljava/lang/String;ZJ)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFile_copyFiles0(JNIEnv* env, jclass cls, jobjectArray jfrom, jobjectArray jto, jboolean overwrite, jlong maxDirty) {
+  bulk_run(env, jfrom, jto, 0, overwrite==JNI_TRUE, (off_t)maxDirty);
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    contentEquals0
+ * Signature: ([Ljava/lang/String;[Ljava/lang/String;)[Z
+ */
+JNIEXPORT jbooleanArray JNICALL Java_com_aoapps_io_posix_PosixFile_contentEquals0(JNIEnv* env, jclass cls, jobjectArray jpaths1, jobjectArray jpaths2) {
+  return bulk_run(env, jpaths1, jpaths2, 1, 0, 0);
+}
+
+// Compiles the Java patterns, returns NULL with an exception pending on failure
+static aocode_match* compilePatterns(JNIEnv* env, jobjectArray jpatterns) {
+  jsize count=(*env)->GetArrayLength(env, jpatterns);
+  unsigned char** patterns=(unsigned char**)calloc(count==0 ? 1 : count, sizeof(unsigned char*));
+  uint32_t* lengths=(uint32_t*)malloc((count==0 ? 1 : count)*sizeof(uint32_t));
+  aocode_match* match=NULL;
+  jsize c;
+  if (patterns==NULL || lengths==NULL) {
+    JNU_ThrowOutOfMemoryError(env, NULL);
+  } else {
+    for (c=0; c<count; c++) {
+      jbyteArray jpattern=(jbyteArray)(*env)->GetObjectArrayElement(env, jpatterns, c);
+      if (jpattern==NULL) break;
+      jsize len=(*env)->GetArrayLength(env, jpattern);
+      patterns[c]=(unsigned char*)malloc(len==0 ? 1 : len);
+      if (patterns[c]==NULL) {
+        (*env)->DeleteLocalRef(env, jpattern);
+        JNU_ThrowOutOfMemoryError(env, NULL);
+        break;
+      }
+      (*env)->GetByteArrayRegion(env, jpattern, 0, len, (jbyte*)patterns[c]);
+      (*env)->DeleteLocalRef(env, jpattern);
+      lengths[c]=len;
+    }
+    if (c==count) {
+      match=aocode_match_compile((const unsigned char* const*)patterns, lengths, count);
+      if (match==NULL) {
+        if (errno==E2BIG) {
+          char message[128];
+          snprintf(message, sizeof(message), "Patterns too large, their automaton would be over %d MiB", AOCODE_MATCH_MAX_TABLE>>20);
+          JNU_ThrowByName(env, ILLEGAL_ARGUMENT_EXCEPTION, message);
+        } else {
+          throwErrno(env, errno, NULL);
+        }
+      }
+    } else if (!(*env)->ExceptionCheck(env)) {
+      JNU_ThrowByName(env, ILLEGAL_ARGUMENT_EXCEPTION, "Null pattern");
+    }
+  }
+  if (patterns!=NULL) {
+    for (c=0; c<count; c++) free(patterns[c]);
+  }
+  free(patterns);
+  free(lengths);
+  return match;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    search0
+ * Signature: (Ljava/lang/String;[[BJLcom/aoapps/io/posix/SearchHandler;I)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFile_search0(JNIEnv* env, jclass cls, jstring jfilename, jobjectArray jpatterns, jlong maxSize, jobject handler, jint flags) {
+  jclass handlerClass=(*env)->FindClass(env, "com/aoapps/io/posix/SearchHandler");
+  if (handlerClass==NULL) return;
+  jmethodID hitMethod=(*env)->GetMethodID(env, handlerClass, "hit", "(Ljava/lang/String;JI)V");
+  if (hitMethod==NULL) return;
+  jmethodID failedMethod=(*env)->GetMethodID(env, handlerClass, "failed", "(Ljava/lang/String;Ljava/io/IOException;)V");
+  if (failedMethod==NULL) return;
+  jclass ioExceptionClass=(*env)->FindClass(env, IO_EXCEPTION);
+  if (ioExceptionClass==NULL) return;
+  jmethodID ioExceptionInit=(*env)->GetMethodID(env, ioExceptionClass, "<init>", "(Ljava/lang/String;)V");
+  if (ioExceptionInit==NULL) return;
+  aocode_match* match=compilePatterns(env, jpatterns);
+  if (match==NULL) return;
+  const char* filename=getString8859_1Chars(env, jfilename);
+  if (filename!=NULL) {
+    aocode_search search;
+    int err=aocode_search_start(&search, filename, match, maxSize<0 ? -1 : (off_t)maxSize, flags);
+    if (err!=0) {
+      throwErrno(env, err, NULL);
+    } else {
+      // Only this thread calls the handler, the hits of each file are delivered together and in order
+      aocode_search_result* results;
+      while ((results=aocode_search_next(&search))!=NULL) {
+        aocode_search_result* result;
+        for (result=results; result!=NULL; result=result->next) {
+          jstring jpath=newString8859_1(env, result->path);
+          if (jpath==NULL) break;
+          if (result->err!=0) {
+            // Reported with the path like the exceptions thrown for a single file
+            size_t len=strlen(result->path)+strlen(strerror(result->err))+3;
+            char* message=(char*)malloc(len);
+            jstring jmessage=NULL;
+            if (message==NULL) {
+              JNU_ThrowOutOfMemoryError(env, NULL);
+            } else {
+              snprintf(message, len, "%s: %s", result->path, strerror(result->err));
+              jmessage=newString8859_1(env, message);
+              free(message);
+            }
+            jobject cause=jmessage==NULL ? NULL : (*env)->NewObject(env, ioExceptionClass, ioExceptionInit, jmessage);
+            if (cause!=NULL) (*env)->CallVoidMethod(env, handler, failedMethod, jpath, cause);
+            if (jmessage!=NULL) (*env)->DeleteLocalRef(env, jmessage);
+            if (cause!=NULL) (*env)->DeleteLocalRef(env, cause);
+          }
+          size_t h;
+          for (h=0; h<result->count; h++) {
+            (*env)->CallVoidMethod(env, handler, hitMethod, jpath, (jlong)result->hits[h].offset, (jint)result->hits[h].pattern);
+            if ((*env)->ExceptionCheck(env)) break;
+          }
+          (*env)->DeleteLocalRef(env, jpath);
+          if ((*env)->ExceptionCheck(env)) break;
+        }
+        aocode_search_free_results(results);
+        if ((*env)->ExceptionCheck(env)) {
+          aocode_search_cancel(&search);
+          break;
+        }
+      }
+    }
+    aocode_search_end(&search);
+    if (search.err!=0 && !(*env)->ExceptionCheck(env)) throwErrno(env, search.err, search.errPath);
+    aocode_search_destroy(&search);
+    releaseString8859_1Chars(filename);
+  }
+  aocode_match_free(match);
+}
+
+// The most links delivered to the handler in one call
+#define SYMLINK_BATCH 1024
+
+typedef struct symlink_ctx {
+  JNIEnv* env;
+  jobject handler;
+  jmethodID linksMethod;
+  jclass stringClass;
+  aocode_symlink symlink;
+  size_t walkPathLen;     // The length of the starting path as given, which prefixes every entry path
+  char* walkRoot;         // The canonical starting path
+  size_t walkRootLen;
+  char* canonical;        // The canonical path of the current entry
+  size_t canonicalCap;
+  size_t count;           // The links waiting to be delivered
+  char* paths[SYMLINK_BATCH];
+  char* targets[SYMLINK_BATCH];
+  jint statuses[SYMLINK_BATCH];
+} symlink_ctx;
+
+// Delivers the waiting links to the handler, returns 0 or -1 with an exception pending
+static int symlink_flush(symlink_ctx* symlink) {
+  JNIEnv* env=symlink->env;
+  jsize count=(jsize)symlink->count;
+  int ret=-1;
+  jobjectArray jpaths=(*env)->NewObjectArray(env, count, symlink->stringClass, NULL);
+  jobjectArray jtargets=jpaths==NULL ? NULL : (*env)->NewObjectArray(env, count, symlink->stringClass, NULL);
+  jintArray jstatuses=jtargets==NULL ? NULL : (*env)->NewIntArray(env, count);
+  if (jstatuses!=NULL) {
+    jsize c;
+    for (c=0; c<count; c++) {
+      jstring jpath=newString8859_1(env, symlink->paths[c]);
+      if (jpath==NULL) break;
+      (*env)->SetObjectArrayElement(env, jpaths, c, jpath);
+      (*env)->DeleteLocalRef(env, jpath);
+      jstring jtarget=newString8859_1(env, symlink->targets[c]);
+      if (jtarget==NULL) break;
+      (*env)->SetObjectArrayElement(env, jtargets, c, jtarget);
+      (*env)->DeleteLocalRef(env, jtarget);
+    }
+    if (c==count) {
+      (*env)->SetIntArrayRegion(env, jstatuses, 0, count, symlink->statuses);
+      (*env)->CallVoidMethod(env, symlink->handler, symlink->linksMethod, jpaths, jtargets, jstatuses);
+      if (!(*env)->ExceptionCheck(env)) ret=0;
+    }
+  }
+  if (jstatuses!=NULL) (*env)->DeleteLocalRef(env, jstatuses);
+  if (jtargets!=NULL) (*env)->DeleteLocalRef(env, jtargets);
+  if (jpaths!=NULL) (*env)->DeleteLocalRef(env, jpaths);
+  size_t i;
+  for (i=0; i<symlink->count; i++) {
+    free(symlink->paths[i]);
+    free(symlink->targets[i]);
+  }
+  symlink->count=0;
+  return ret;
+}
+
+// Classifies each symbolic link, batching them for the handler
+static int symlink_visit(aocode_walk_entry* entry, void* ctx) {
+  symlink_ctx* symlink=(symlink_ctx*)ctx;
+  if (!S_ISLNK(entry->stat.st.st_mode)) return 0;
+  // Directories are never followed by the walk, so the path below the canonical start is canonical
+  const char* suffix=entry->path+symlink->walkPathLen;
+  while (*suffix=='/') suffix++;
+  size_t suffixLen=strlen(suffix);
+  size_t len=symlink->walkRootLen+1+suffixLen;
+  if (len+1>symlink->canonicalCap) {
+    char* canonical=(char*)realloc(symlink->canonical, len+1);
+    if (canonical==NULL) return ENOMEM;
+    symlink->canonical=canonical;
+    symlink->canonicalCap=len+1;
+  }
+  memcpy(symlink->canonical, symlink->walkRoot, symlink->walkRootLen);
+  len=symlink->walkRootLen;
+  if (suffixLen>0) {
+    if (len>1) symlink->canonical[len++]='/';
+    memcpy(symlink->canonical+len, suffix, suffixLen);
+    len+=suffixLen;
+  }
+  symlink->canonical[len]='\0';
+  const char* target;
+  int status=aocode_symlink_classify(&symlink->symlink, symlink->canonical, &entry->stat.st, &target);
+  if (status==-1) {
+    // OK if removed during the walk
+    return errno==ENOENT && entry->depth>0 ? 0 : errno;
+  }
+  char* path=strdup(entry->path);
+  char* targetCopy=path==NULL ? NULL : strdup(target);
+  if (targetCopy==NULL) {
+    free(path);
+    return ENOMEM;
+  }
+  symlink->paths[symlink->count]=path;
+  symlink->targets[symlink->count]=targetCopy;
+  symlink->statuses[symlink->count]=status;
+  if (++symlink->count==SYMLINK_BATCH && symlink_flush(symlink)!=0) return ECANCELED;
+  return 0;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    analyzeSymlinks0
+ * Signature: (Ljava/lang/String;Ljava/lang/String;Lcom/aoapps/io/posix/SymlinkHandler;I)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFile_analyzeSymlinks0(JNIEnv* env, jclass cls, jstring jfilename, jstring jroot, jobject handler, jint flags) {
+  jclass handlerClass=(*env)->FindClass(env, "com/aoapps/io/posix/SymlinkHandler");
+  if (handlerClass==NULL) return;
+  jmethodID linksMethod=(*env)->GetMethodID(env, handlerClass, "links", "([Ljava/lang/String;[Ljava/lang/String;[I)V");
+  if (linksMethod==NULL) return;
+  jclass stringClass=(*env)->FindClass(env, "java/lang/String");
+  if (stringClass==NULL) return;
+  const char* filename=getString8859_1Chars(env, jfilename);
+  if (filename!=NULL) {
+    const char* root=getString8859_1Chars(env, jroot);
+    if (root!=NULL) {
+      symlink_ctx* symlink=(symlink_ctx*)calloc(1, sizeof(symlink_ctx));
+      if (symlink==NULL) {
+        JNU_ThrowOutOfMemoryError(env, NULL);
+      } else {
+        symlink->env=env;
+        symlink->handler=handler;
+        symlink->linksMethod=linksMethod;
+        symlink->stringClass=stringClass;
+        symlink->walkPathLen=strlen(filename);
+        int err=aocode_symlink_init(&symlink->symlink, root);
+        if (err!=0) {
+          throwErrno(env, err, root);
+        } else if ((symlink->walkRoot=realpath(filename, NULL))==NULL) {
+          throwErrno(env, errno, filename);
+        } else {
+          symlink->walkRootLen=strlen(symlink->walkRoot);
+          aocode_walk walk;
+          aocode_walk_init(&walk, symlink_visit, NULL, symlink, flags);
+          int failed=aocode_walk_tree(&walk, filename);
+          if ((*env)->ExceptionCheck(env)) {
+            // Stopped by the handler
+          } else if (failed!=0) {
+            aocode_walk_throw(env, &walk);
+          } else if (symlink->count>0) {
+            symlink_flush(symlink);
+          }
+          aocode_walk_destroy(&walk);
+        }
+        size_t i;
+        for (i=0; i<symlink->count; i++) {
+          free(symlink->paths[i]);
+          free(symlink->targets[i]);
+        }
+        free(symlink->canonical);
+        free(symlink->walkRoot);
+        aocode_symlink_destroy(&symlink->symlink);
+        free(symlink);
+      }
+      releaseString8859_1Chars(root);
+    }
+    releaseString8859_1Chars(filename);
+  }
+}
+
+// The largest Java array, as limited by most JVMs
+#define MAX_ARRAY_SIZE (0x7fffffff-8)
+
+/*
+ * Opens a regular file without following a final symbolic link or blocking on a FIFO.
+ * Returns the file descriptor, or -1 with err set to an errno or AOCODE_NOT_REGULAR_FILE.
+ */
+static int openRegular(const char* path, struct stat* st, int* err) {
+  int fd=open(path, O_RDONLY|O_NOFOLLOW|O_NOCTTY|O_NONBLOCK|O_CLOEXEC);
+  if (fd==-1) {
+    *err=errno;
+    return -1;
+  }
+  if (fstat(fd, st)!=0) {
+    *err=errno;
+    close(fd);
+    return -1;
+  }
+  if (!S_ISREG(st->st_mode)) {
+    *err=AOCODE_NOT_REGULAR_FILE;
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+// Throws the exception for an error from openRegular or readAll
+static void throwReadError(JNIEnv* env, int err, const char* path) {
+  if (err==AOCODE_NOT_REGULAR_FILE || err==EFBIG) {
+    char message[PATH_MAX+32];
+    snprintf(message, sizeof(message), err==EFBIG ? "File too large: %s" : "Not a regular file: %s", path);
+    JNU_ThrowByName(env, IO_EXCEPTION, message);
+  } else {
+    throwErrno(env, err, path);
+  }
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    openRegular0
+ * Signature: (Ljava/lang/String;)Ljava/io/FileDescriptor;
+ */
+JNIEXPORT jobject JNICALL Java_com_aoapps_io_posix_PosixFile_openRegular0(JNIEnv* env, jclass cls, jstring jfilename) {
+  jobject fileDescriptor=NULL;
+  const char* filename=getString8859_1Chars(env, jfilename);
+  if (filename!=NULL) {
+    struct stat st;
+    int err;
+    int fd=openRegular(filename, &st, &err);
+    if (fd==-1) {
+      throwReadError(env, err, filename);
+    } else {
+      int flags=fcntl(fd, F_GETFL);
+      if (flags==-1 || fcntl(fd, F_SETFL, flags & ~O_NONBLOCK)==-1) throwErrno(env, errno, filename);
+      else fileDescriptor=newFileDescriptor(env, fd);
+      if (fileDescriptor==NULL) close(fd);
+    }
+    releaseString8859_1Chars(filename);
+  }
+  return fileDescriptor;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    transfer0
+ * Signature: (Ljava/io/FileDescriptor;Ljava/io/FileDescriptor;JJ)J
+ */
+JNIEXPORT jlong JNICALL Java_com_aoapps_io_posix_PosixFile_transfer0(JNIEnv* env, jclass cls, jobject jin, jobject jout, jlong offset, jlong length) {
+  int in=getFileDescriptor(env, jin);
+  if (in==-1) return 0;
+  int out=getFileDescriptor(env, jout);
+  if (out==-1) return 0;
+  off_t transferred;
+  int err=aocode_transfer(in, out, (off_t)offset, length<0 ? -1 : (off_t)length, &transferred);
+  if (err!=0) throwErrno(env, err, NULL);
+  return transferred;
+}
+
+/*
+ * Reads up to len bytes from the current position, stopping early only at the end of the file.
+ * Returns the number of bytes read, or -1 with err set.
+ */
+static ssize_t readFully(int fd, char* buff, size_t len, int* err) {
+  size_t total=0;
+  while (total<len) {
+    ssize_t count=read(fd, buff+total, len-total);
+    if (count==-1) {
+      if (errno==EINTR) continue;
+      *err=errno;
+      return -1;
+    }
+    if (count==0) break;
+    total+=count;
+  }
+  return total;
+}
+
+/*
+ * Reads an entire regular file in one pass sized by fstat, following any growth since the fstat.
+ * Returns the new Java array, or NULL with err set.  Sets err to 0 with an exception pending when the array
+ * cannot be allocated.
+ */
+static jbyteArray readAll(JNIEnv* env, const char* path, int* err) {
+  struct stat st;
+  int fd=openRegular(path, &st, err);
+  if (fd==-1) return NULL;
+  jbyteArray result=NULL;
+  // One extra byte so the end of the file is seen by the same read when its size is unchanged
+  size_t cap=st.st_size<0 ? 1 : st.st_size>=MAX_ARRAY_SIZE ? MAX_ARRAY_SIZE : (size_t)st.st_size+1;
+  char stackBuff[8192];
+  char* buff=cap<=sizeof(stackBuff) ? stackBuff : (char*)malloc(cap);
+  if (buff==NULL) {
+    *err=ENOMEM;
+  } else {
+    size_t len=0;
+    *err=0;
+    while (1) {
+      ssize_t count=readFully(fd, buff+len, cap-len, err);
+      if (count==-1) break;
+      len+=count;
+      if (len<cap) {
+        result=(*env)->NewByteArray(env, len);
+        if (result!=NULL) (*env)->SetByteArrayRegion(env, result, 0, len, (const jbyte*)buff);
+        break;
+      }
+      // Grew since fstat
+      if (cap>=MAX_ARRAY_SIZE) {
+        *err=EFBIG;
+        break;
+      }
+      size_t newCap=cap<(MAX_ARRAY_SIZE>>1) ? cap<<1 : MAX_ARRAY_SIZE;
+      char* newBuff;
+      if (buff==stackBuff) {
+        newBuff=(char*)malloc(newCap);
+        if (newBuff!=NULL) memcpy(newBuff, buff, len);
+      } else {
+        newBuff=(char*)realloc(buff, newCap);
+      }
+      if (newBuff==NULL) {
+        *err=ENOMEM;
+        break;
+      }
+      buff=newBuff;
+      cap=newCap;
+    }
+    if (buff!=stackBuff) free(buff);
+  }
+  close(fd);
+  return result;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    readAllBytes0
+ * Signature: (Ljava/lang/String;)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_com_aoapps_io_posix_PosixFile_readAllBytes0(JNIEnv* env, jclass cls, jstring jfilename) {
+  jbyteArray result=NULL;
+  const char* filename=getString8859_1Chars(env, jfilename);
+  if (filename!=NULL) {
+    int err;
+    result=readAll(env, filename, &err);
+    if (result==NULL && err!=0) throwReadError(env, err, filename);
+    releaseString8859_1Chars(filename);
+  }
+  return result;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    readAllBytesInto0
+ * Signature: (Ljava/lang/String;[BII)J
+ */
+JNIEXPORT jlong JNICALL Java_com_aoapps_io_posix_PosixFile_readAllBytesInto0(JNIEnv* env, jclass cls, jstring jfilename, jbyteArray jbuff, jint off, jint len) {
+  jlong size=-1;
+  const char* filename=getString8859_1Chars(env, jfilename);
+  if (filename!=NULL) {
+    struct stat st;
+    int err;
+    int fd=openRegular(filename, &st, &err);
+    if (fd==-1) {
+      throwReadError(env, err, filename);
+    } else {
+      char stackBuff[8192];
+      char* buff=(size_t)len<=sizeof(stackBuff) ? stackBuff : (char*)malloc(len);
+      if (buff==NULL) {
+        throwErrno(env, ENOMEM, filename);
+      } else {
+        ssize_t count=readFully(fd, buff, len, &err);
+        if (count==-1) {
+          throwErrno(env, err, filename);
+        } else {
+          (*env)->SetByteArrayRegion(env, jbuff, off, count, (const jbyte*)buff);
+          // Reports the full size when the buffer was too small
+          size=count==len && st.st_size>len ? st.st_size : count;
+        }
+        if (buff!=stackBuff) free(buff);
+      }
+      close(fd);
+    }
+    releaseString8859_1Chars(filename);
+  }
+  return size;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    readAllBytesBatch0
+ * Signature: ([Ljava/lang/String;)[[B
+ */
+JNIEXPORT jobjectArray JNICALL Java_com_aoapps_io_posix_PosixFile_readAllBytesBatch0(JNIEnv* env, jclass cls, jobjectArray jpaths) {
+  jsize count=(*env)->GetArrayLength(env, jpaths);
+  jclass byteArrayClass=(*env)->FindClass(env, "[B");
+  if (byteArrayClass==NULL) return NULL;
+  jobjectArray results=(*env)->NewObjectArray(env, count, byteArrayClass, NULL);
+  (*env)->DeleteLocalRef(env, byteArrayClass);
+  if (results==NULL) return NULL;
+  jsize c;
+  for (c=0; c<count; c++) {
+    jstring jpath=(jstring)(*env)->GetObjectArrayElement(env, jpaths, c);
+    if (jpath==NULL) {
+      JNU_ThrowByName(env, ILLEGAL_ARGUMENT_EXCEPTION, "Null path");
+      return NULL;
+    }
+    const char* path=getString8859_1Chars(env, jpath);
+    (*env)->DeleteLocalRef(env, jpath);
+    if (path==NULL) return NULL;
+    int err;
+    jbyteArray result=readAll(env, path, &err);
+    if (result!=NULL) {
+      (*env)->SetObjectArrayElement(env, results, c, result);
+      (*env)->DeleteLocalRef(env, result);
+    } else if (err!=ENOENT) {
+      // Missing files are left null
+      if (err!=0) throwReadError(env, err, path);
+      releaseString8859_1Chars(path);
+      return NULL;
+    }
+    releaseString8859_1Chars(path);
+  }
+  return results;
+}
+
+// One file written on the worker pool
+typedef struct write_task {
+  aocode_pool_task task;
+  const char* path;
+  char* data;
+  size_t len;
+  mode_t mode;
+  uid_t uid;
+  gid_t gid;
+  int sync;
+} write_task;
+
+static int write_run(aocode_pool_task* task, char* buff, size_t buffSize) {
+  write_task* write=(write_task*)task;
+  return aocode_write_file(write->path, write->data, write->len, write->mode, write->uid, write->gid, write->sync);
+}
+
+static int compareStrings(const void* a, const void* b) {
+  return strcmp(*(char* const*)a, *(char* const*)b);
+}
+
+// Flushes each distinct parent directory once so the renames are durable, throws on failure
+static void syncParents(JNIEnv* env, write_task* tasks, jsize count) {
+  char** dirs=(char**)malloc((count==0 ? 1 : count)*sizeof(char*));
+  if (dirs==NULL) {
+    JNU_ThrowOutOfMemoryError(env, NULL);
+    return;
+  }
+  jsize dirCount=0;
+  jsize c;
+  for (c=0; c<count; c++) {
+    const char* path=tasks[c].path;
+    const char* slash=strrchr(path, '/');
+    size_t len=slash==NULL || slash==path ? 1 : (size_t)(slash-path);
+    char* dir=(char*)malloc(len+1);
+    if (dir==NULL) break;
+    if (slash==NULL) dir[0]='.';
+    else memcpy(dir, path, len);
+    dir[len]='\0';
+    dirs[dirCount++]=dir;
+  }
+  if (dirCount<count) {
+    JNU_ThrowOutOfMemoryError(env, NULL);
+  } else {
+    qsort(dirs, dirCount, sizeof(char*), compareStrings);
+    for (c=0; c<dirCount; c++) {
+      if (c>0 && strcmp(dirs[c], dirs[c-1])==0) continue;
+      int fd=open(dirs[c], O_RDONLY|O_DIRECTORY|O_CLOEXEC);
+      if (fd==-1 || fsync(fd)!=0) {
+        throwErrno(env, errno, dirs[c]);
+        if (fd!=-1) close(fd);
+        break;
+      }
+      close(fd);
+    }
+  }
+  for (c=0; c<dirCount; c++) free(dirs[c]);
+  free(dirs);
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    writeFiles0
+ * Signature: ([Ljava/lang/String;[[B[J[I[IZ)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFile_writeFiles0(JNIEnv* env, jclass cls, jobjectArray jpaths, jobjectArray jcontents, jlongArray jmodes, jintArray juids, jintArray jgids, jboolean sync) {
+  jsize count=(*env)->GetArrayLength(env, jpaths);
+  write_task* tasks=(write_task*)calloc(count==0 ? 1 : count, sizeof(write_task));
+  aocode_pool_task** taskPtrs=(aocode_pool_task**)malloc((count==0 ? 1 : count)*sizeof(aocode_pool_task*));
+  jlong* modes=(jlong*)malloc((count==0 ? 1 : count)*sizeof(jlong));
+  jint* uids=(jint*)malloc((count==0 ? 1 : count)*sizeof(jint));
+  jint* gids=(jint*)malloc((count==0 ? 1 : count)*sizeof(jint));
+  if (tasks==NULL || taskPtrs==NULL || modes==NULL || uids==NULL || gids==NULL) {
+    JNU_ThrowOutOfMemoryError(env, NULL);
+  } else {
+    (*env)->GetLongArrayRegion(env, jmodes, 0, count, modes);
+    (*env)->GetIntArrayRegion(env, juids, 0, count, uids);
+    (*env)->GetIntArrayRegion(env, jgids, 0, count, gids);
+    // Copy everything out of the JVM first so the workers never touch Java objects
+    jsize converted=0;
+    while (converted<count && !(*env)->ExceptionCheck(env)) {
+      write_task* task=&tasks[converted];
+      jstring jpath=(jstring)(*env)->GetObjectArrayElement(env, jpaths, converted);
+      jbyteArray jcontent=(jbyteArray)(*env)->GetObjectArrayElement(env, jcontents, converted);
+      if (jpath==NULL || jcontent==NULL) {
+        JNU_ThrowByName(env, ILLEGAL_ARGUMENT_EXCEPTION, "Null path or contents");
+      } else {
+        task->len=(*env)->GetArrayLength(env, jcontent);
+        task->data=(char*)malloc(task->len==0 ? 1 : task->len);
+        if (task->data==NULL) {
+          JNU_ThrowOutOfMemoryError(env, NULL);
+        } else {
+          (*env)->GetByteArrayRegion(env, jcontent, 0, task->len, (jbyte*)task->data);
+          task->path=getString8859_1Chars(env, jpath);
+          if (task->path==NULL) {
+            free(task->data);
+            task->data=NULL;
+          } else {
+            task->task.run=write_run;
+            task->task.node=-1;
+            task->mode=(mode_t)modes[converted];
+            task->uid=(uid_t)uids[converted];
+            task->gid=(gid_t)gids[converted];
+            task->sync=sync==JNI_TRUE;
+            taskPtrs[converted]=&task->task;
+            converted++;
+          }
+        }
+      }
+      if (jpath!=NULL) (*env)->DeleteLocalRef(env, jpath);
+      if (jcontent!=NULL) (*env)->DeleteLocalRef(env, jcontent);
+    }
+    if (!(*env)->ExceptionCheck(env)) {
+      if (aocode_pool_run(taskPtrs, count)!=0) {
+        jsize c;
+        for (c=0; c<count; c++) {
+          if (tasks[c].task.first) {
+            throwErrno(env, tasks[c].task.err, tasks[c].path);
+            break;
+          }
+        }
+      } else if (sync==JNI_TRUE) {
+        syncParents(env, tasks, count);
+      }
+    }
+    jsize c;
+    for (c=0; c<converted; c++) {
+      releaseString8859_1Chars(tasks[c].path);
+      free(tasks[c].data);
+    }
+  }
+  free(gids);
+  free(uids);
+  free(modes);
+  free(taskPtrs);
+  free(tasks);
+}
+
+#ifndef __NR_cachestat
+#define __NR_cachestat 451
+#endif
+
+// The range and result of cachestat(2), which is too new for most C libraries to declare
+struct aocode_cachestat_range {
+  uint64_t off;
+  uint64_t len;
+};
+
+struct aocode_cachestat {
+  uint64_t nr_cache;
+  uint64_t nr_dirty;
+  uint64_t nr_writeback;
+  uint64_t nr_evicted;
+  uint64_t nr_recently_evicted;
+};
+
+// The most mapped at once by the mincore fallback, so huge files do not need a huge vector
+#define RESIDENCY_CHUNK ((off_t)1<<30)
+
+/*
+ * Counts the resident pages of a range with mmap and mincore, for kernels without cachestat.
+ * Returns 0 or an errno.
+ */
+static int mincoreResidency(int fd, off_t start, off_t end, long pageSize, jlong* cached) {
+  unsigned char* vec=(unsigned char*)malloc((size_t)(RESIDENCY_CHUNK/pageSize));
+  if (vec==NULL) return ENOMEM;
+  int err=0;
+  *cached=0;
+  while (start<end) {
+    size_t len=(size_t)(end-start<RESIDENCY_CHUNK ? end-start : RESIDENCY_CHUNK);
+    void* addr=mmap(NULL, len, PROT_READ, MAP_SHARED, fd, start);
+    if (addr==MAP_FAILED) {
+      err=errno;
+      break;
+    }
+    if (mincore(addr, len, vec)!=0) {
+      err=errno;
+      munmap(addr, len);
+      break;
+    }
+    size_t pages=(len+pageSize-1)/pageSize;
+    size_t i;
+    for (i=0; i<pages; i++) if (vec[i]&1) (*cached)++;
+    munmap(addr, len);
+    start+=len;
+  }
+  free(vec);
+  return err;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    getCacheResidency0
+ * Signature: (Ljava/lang/String;JJ)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_com_aoapps_io_posix_PosixFile_getCacheResidency0(JNIEnv* env, jclass cls, jstring jfilename, jlong offset, jlong length) {
+  jlongArray result=NULL;
+  const char* filename=getString8859_1Chars(env, jfilename);
+  if (filename!=NULL) {
+    struct stat st;
+    int err;
+    int fd=openRegular(filename, &st, &err);
+    if (fd==-1) {
+      throwReadError(env, err, filename);
+    } else {
+      // Only whole pages within the file are counted, so the range is page aligned and limited to the file
+      long pageSize=sysconf(_SC_PAGESIZE);
+      off_t start=(off_t)offset-(off_t)offset%pageSize;
+      off_t end=length==0 || (off_t)length>st.st_size-(off_t)offset ? st.st_size : (off_t)offset+(off_t)length;
+      end=(end+pageSize-1)/pageSize*pageSize;
+      if (end<start) end=start;
+      // Unknown counts are -1
+      jlong counts[6]={(end-start)/pageSize, 0, -1, -1, -1, -1};
+      if (end>start) {
+        struct aocode_cachestat_range range={(uint64_t)start, (uint64_t)(end-start)};
+        struct aocode_cachestat cs;
+        if (syscall(__NR_cachestat, fd, &range, &cs, 0)==0) {
+          counts[1]=(jlong)cs.nr_cache;
+          counts[2]=(jlong)cs.nr_dirty;
+          counts[3]=(jlong)cs.nr_writeback;
+          counts[4]=(jlong)cs.nr_evicted;
+          counts[5]=(jlong)cs.nr_recently_evicted;
+          err=0;
+        } else if (errno==ENOSYS || errno==EPERM || errno==EOPNOTSUPP) {
+          err=mincoreResidency(fd, start, end, pageSize, &counts[1]);
+        } else {
+          err=errno;
+        }
+      } else {
+        err=0;
+      }
+      if (err!=0) {
+        throwErrno(env, err, filename);
+      } else {
+        result=(*env)->NewLongArray(env, 6);
+        if (result!=NULL) (*env)->SetLongArrayRegion(env, result, 0, 6, counts);
+      }
+      close(fd);
+    }
+    releaseString8859_1Chars(filename);
+  }
+  return result;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    contentEqualsParallel0
+ * Signature: (Ljava/lang/String;Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_com_aoapps_io_posix_PosixFile_contentEqualsParallel0(JNIEnv* env, jclass cls, jstring jpath1, jstring jpath2) {
+  jboolean result=JNI_FALSE;
+  const char* path1=getString8859_1Chars(env, jpath1);
+  if (path1!=NULL) {
+    const char* path2=getString8859_1Chars(env, jpath2);
+    if (path2!=NULL) {
+      int equal=0;
+      const char* errPath;
+      int err=aocode_range_compare(path1, path2, &equal, &errPath);
+      if (err!=0) throwReadError(env, err, errPath);
+      else result=equal ? JNI_TRUE : JNI_FALSE;
+      releaseString8859_1Chars(path2);
+    }
+    releaseString8859_1Chars(path1);
+  }
+  return result;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    getBlake3Hash0
+ * Signature: (Ljava/lang/String;)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_com_aoapps_io_posix_PosixFile_getBlake3Hash0(JNIEnv* env, jclass cls, jstring jfilename) {
+  jbyteArray result=NULL;
+  const char* filename=getString8859_1Chars(env, jfilename);
+  if (filename!=NULL) {
+    uint8_t hash[AOCODE_BLAKE3_OUT_LEN];
+    int err=aocode_range_hash(filename, hash);
+    if (err!=0) {
+      throwReadError(env, err, filename);
+    } else {
+      result=(*env)->NewByteArray(env, AOCODE_BLAKE3_OUT_LEN);
+      if (result!=NULL) (*env)->SetByteArrayRegion(env, result, 0, AOCODE_BLAKE3_OUT_LEN, (const jbyte*)hash);
+    }
+    releaseString8859_1Chars(filename);
+  }
+  return result;
+}
+
+static const JNINativeMethod methods[]={
+  {"chown0", "(Ljava/lang/String;II)V", (void*)Java_com_aoapps_io_posix_PosixFile_chown0},
+  {"getStat0", "(Ljava/lang/String;)Lcom/aoapps/io/posix/Stat;", (void*)Java_com_aoapps_io_posix_PosixFile_getStat0},
+  {"getFlags0", "(Ljava/lang/String;)I", (void*)Java_com_aoapps_io_posix_PosixFile_getFlags0},
+  {"chattr0", "(Ljava/lang/String;IIZLjava/lang/String;I)V", (void*)Java_com_aoapps_io_posix_PosixFile_chattr0},
+  {"getFileHandle0", "(Ljava/lang/String;)[B", (void*)Java_com_aoapps_io_posix_PosixFile_getFileHandle0},
+  {"openByHandle0", "([BI)Ljava/io/FileDescriptor;", (void*)Java_com_aoapps_io_posix_PosixFile_openByHandle0},
+  {"copyFiles0", "([Ljava/lang/String;[Ljava/lang/String;ZJ)V", (void*)Java_com_aoapps_io_posix_PosixFile_copyFiles0},
+  {"contentEquals0", "([Ljava/lang/String;[Ljava/lang/String;)[Z", (void*)Java_com_aoapps_io_posix_PosixFile_contentEquals0},
+  {"contentEqualsParallel0", "(Ljava/lang/String;Ljava/lang/String;)Z", (void*)Java_com_aoapps_io_posix_PosixFile_contentEqualsParallel0},
+  {"getBlake3Hash0", "(Ljava/lang/String;)[B", (void*)Java_com_aoapps_io_posix_PosixFile_getBlake3Hash0},
+  {"search0", "(Ljava/lang/String;[[BJLcom/aoapps/io/posix/SearchHandler;I)V", (void*)Java_com_aoapps_io_posix_PosixFile_search0},
+  {"analyzeSymlinks0", "(Ljava/lang/String;Ljava/lang/String;Lcom/aoapps/io/posix/SymlinkHandler;I)V", (void*)Java_com_aoapps_io_posix_PosixFile_analyzeSymlinks0},
+  {"crypt0", "(Ljava/lang/String;Ljava/lang/String;)Ljava/lang/String;", (void*)Java_com_aoapps_io_posix_PosixFile_crypt0},
+  {"deleteRecursive0", "(Ljava/lang/String;Ljava/lang/String;I)V", (void*)Java_com_aoapps_io_posix_PosixFile_deleteRecursive0},
+  {"secureDeleteRecursive0", "(Ljava/lang/String;Ljava/lang/String;I)V", (void*)Java_com_aoapps_io_posix_PosixFile_secureDeleteRecursive0},
+  {"openRegular0", "(Ljava/lang/String;)Ljava/io/FileDescriptor;", (void*)Java_com_aoapps_io_posix_PosixFile_openRegular0},
+  {"transfer0", "(Ljava/io/FileDescriptor;Ljava/io/FileDescriptor;JJ)J", (void*)Java_com_aoapps_io_posix_PosixFile_transfer0},
+  {"readAllBytes0", "(Ljava/lang/String;)[B", (void*)Java_com_aoapps_io_posix_PosixFile_readAllBytes0},
+  {"readAllBytesInto0", "(Ljava/lang/String;[BII)J", (void*)Java_com_aoapps_io_posix_PosixFile_readAllBytesInto0},
+  {"readAllBytesBatch0", "([Ljava/lang/String;)[[B", (void*)Java_com_aoapps_io_posix_PosixFile_readAllBytesBatch0},
+  {"writeFiles0", "([Ljava/lang/String;[[B[J[I[IZ)V", (void*)Java_com_aoapps_io_posix_PosixFile_writeFiles0},
+  {"getCacheResidency0", "(Ljava/lang/String;JJ)[J", (void*)Java_com_aoapps_io_posix_PosixFile_getCacheResidency0},
+  {"mktemp0", "(Ljava/lang/String;)Ljava/lang/String;", (void*)Java_com_aoapps_io_posix_PosixFile_mktemp0},
+  {"mknod0", "(Ljava/lang/String;JJ)V", (void*)Java_com_aoapps_io_posix_PosixFile_mknod0},
+  {"mkfifo0", "(Ljava/lang/String;J)V", (void*)Java_com_aoapps_io_posix_PosixFile_mkfifo0},
+  {"setMode0", "(Ljava/lang/String;J)V", (void*)Java_com_aoapps_io_posix_PosixFile_setMode0},
+  {"symLink0", "(Ljava/lang/String;Ljava/lang/String;)V", (void*)Java_com_aoapps_io_posix_PosixFile_symLink0},
+  {"link0", "(Ljava/lang/String;Ljava/lang/String;)V", (void*)Java_com_aoapps_io_posix_PosixFile_link0},
+  {"readLink0", "(Ljava/lang/String;)Ljava/lang/String;", (void*)Java_com_aoapps_io_posix_PosixFile_readLink0},
+  {"utime0", "(Ljava/lang/String;JJ)V", (void*)Java_com_aoapps_io_posix_PosixFile_utime0}
+};
+
+jint registerPosixFileNatives(JNIEnv* env) {
+  return registerNatives(env, "com/aoapps/io/posix/PosixFile", methods, sizeof(methods)/sizeof(methods[0]));
+}
@@ -77,6 +77,46 @@ extern "C" {
 #define com_aoapps_io_posix_PosixFile_IS_SYM_LINK 40960LL
 #undef com_aoapps_io_posix_PosixFile_IS_SOCKET
 #define com_aoapps_io_posix_PosixFile_IS_SOCKET 49152LL
+#undef com_aoapps_io_posix_PosixFile_FLAG_SECURE_DELETION
+#define com_aoapps_io_posix_PosixFile_FLAG_SECURE_DELETION 1L
+#undef com_aoapps_io_posix_PosixFile_FLAG_UNDELETE
+#define com_aoapps_io_posix_PosixFile_FLAG_UNDELETE 2L
+#undef com_aoapps_io_posix_PosixFile_FLAG_COMPRESSED
+#define com_aoapps_io_posix_PosixFile_FLAG_COMPRESSED 4L
+#undef com_aoapps_io_posix_PosixFile_FLAG_SYNC
+#define com_aoapps_io_posix_PosixFile_FLAG_SYNC 8L
+#undef com_aoapps_io_posix_PosixFile_FLAG_IMMUTABLE
+#define com_aoapps_io_posix_PosixFile_FLAG_IMMUTABLE 16L
+#undef com_aoapps_io_posix_PosixFile_FLAG_APPEND_ONLY
+#define com_aoapps_io_posix_PosixFile_FLAG_APPEND_ONLY 32L
+#undef com_aoapps_io_posix_PosixFile_FLAG_NO_DUMP
+#define com_aoapps_io_posix_PosixFile_FLAG_NO_DUMP 64L
+#undef com_aoapps_io_posix_PosixFile_FLAG_NO_ATIME
+#define com_aoapps_io_posix_PosixFile_FLAG_NO_ATIME 128L
+#undef com_aoapps_io_posix_PosixFile_FLAG_ENCRYPTED
+#define com_aoapps_io_posix_PosixFile_FLAG_ENCRYPTED 2048L
+#undef com_aoapps_io_posix_PosixFile_FLAG_JOURNAL_DATA
+#define com_aoapps_io_posix_PosixFile_FLAG_JOURNAL_DATA 16384L
+#undef com_aoapps_io_posix_PosixFile_FLAG_NO_TAIL_MERGE
+#define com_aoapps_io_posix_PosixFile_FLAG_NO_TAIL_MERGE 32768L
+#undef com_aoapps_io_posix_PosixFile_FLAG_DIRSYNC
+#define com_aoapps_io_posix_PosixFile_FLAG_DIRSYNC 65536L
+#undef com_aoapps_io_posix_PosixFile_FLAG_TOP_DIR
+#define com_aoapps_io_posix_PosixFile_FLAG_TOP_DIR 131072L
+#undef com_aoapps_io_posix_PosixFile_FLAG_EXTENTS
+#define com_aoapps_io_posix_PosixFile_FLAG_EXTENTS 524288L
+#undef com_aoapps_io_posix_PosixFile_FLAG_VERITY
+#define com_aoapps_io_posix_PosixFile_FLAG_VERITY 1048576L
+#undef com_aoapps_io_posix_PosixFile_FLAG_NO_COW
+#define com_aoapps_io_posix_PosixFile_FLAG_NO_COW 8388608L
+#undef com_aoapps_io_posix_PosixFile_FLAG_DAX
+#define com_aoapps_io_posix_PosixFile_FLAG_DAX 33554432L
+#undef com_aoapps_io_posix_PosixFile_FLAG_INLINE_DATA
+#define com_aoapps_io_posix_PosixFile_FLAG_INLINE_DATA 268435456L
+#undef com_aoapps_io_posix_PosixFile_FLAG_PROJECT_INHERIT
+#define com_aoapps_io_posix_PosixFile_FLAG_PROJECT_INHERIT 536870912L
+#undef com_aoapps_io_posix_PosixFile_FLAG_CASEFOLD
+#define com_aoapps_io_posix_PosixFile_FLAG_CASEFOLD 1073741824L
 /*
  * Class:     com_aoapps_io_posix_PosixFile
  * Method:    chown0
@@ -93,6 +133,86 @@ JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFile_chown0
 JNIEXPORT jobject JNICALL Java_com_aoapps_io_posix_PosixFile_getStat0
   (JNIEnv *, jobject, jstring);
 
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    getFlags0
+ * Signature: (Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_com_aoapps_io_posix_PosixFile_getFlags0
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    chattr0
+ * Signature: (Ljava/lang/String;IIZLjava/lang/String;I)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFile_chattr0
+  (JNIEnv *, jclass, jstring, jint, jint, jboolean, jstring, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    getFileHandle0
+ * Signature: (Ljava/lang/String;)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_com_aoapps_io_posix_PosixFile_getFileHandle0
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    openByHandle0
+ * Signature: ([BI)Ljava/io/FileDescriptor;
+ */
+JNIEXPORT jobject JNICALL Java_com_aoapps_io_posix_PosixFile_openByHandle0
+  (JNIEnv *, jclass, jbyteArray, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    copyFiles0
+ * Signature: ([Ljava/lang/String;[Ljava/lang/String;ZJ)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFile_copyFiles0
+  (JNIEnv *, jclass, jobjectArray, jobjectArray, jboolean, jlong);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    contentEquals0
+ * Signature: ([Ljava/lang/String;[Ljava/lang/String;)[Z
+ */
+JNIEXPORT jbooleanArray JNICALL Java_com_aoapps_io_posix_PosixFile_contentEquals0
+  (JNIEnv *, jclass, jobjectArray, jobjectArray);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    contentEqualsParallel0
+ * Signature: (Ljava/lang/String;Ljava/lang/String;)Z
+ */
+JNIEXPORT jboolean JNICALL Java_com_aoapps_io_posix_PosixFile_contentEqualsParallel0
+  (JNIEnv *, jclass, jstring, jstring);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    getBlake3Hash0
+ * Signature: (Ljava/lang/String;)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_com_aoapps_io_posix_PosixFile_getBlake3Hash0
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    search0
+ * Signature: (Ljava/lang/String;[[BJLcom/aoapps/io/posix/SearchHandler;I)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFile_search0
+  (JNIEnv *, jclass, jstring, jobjectArray, jlong, jobject, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    analyzeSymlinks0
+ * Signature: (Ljava/lang/String;Ljava/lang/String;Lcom/aoapps/io/posix/SymlinkHandler;I)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFile_analyzeSymlinks0
+  (JNIEnv *, jclass, jstring, jstring, jobject, jint);
+
 /*
  * Class:     com_aoapps_io_posix_PosixFile
  * Method:    crypt0
@@ -101,6 +221,78 @@ JNIEXPORT jobject JNICALL Java_com_aoapps_io_posix_PosixFile_getStat0
 JNIEXPORT jstring JNICALL Java_com_aoapps_io_posix_PosixFile_crypt0
   (JNIEnv *, jclass, jstring, jstring);
 
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    deleteRecursive0
+ * Signature: (Ljava/lang/String;Ljava/lang/String;I)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFile_deleteRecursive0
+  (JNIEnv *, jclass, jstring, jstring, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    secureDeleteRecursive0
+ * Signature: (Ljava/lang/String;Ljava/lang/String;I)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFile_secureDeleteRecursive0
+  (JNIEnv *, jclass, jstring, jstring, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    openRegular0
+ * Signature: (Ljava/lang/String;)Ljava/io/FileDescriptor;
+ */
+JNIEXPORT jobject JNICALL Java_com_aoapps_io_posix_PosixFile_openRegular0
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    transfer0
+ * Signature: (Ljava/io/FileDescriptor;Ljava/io/FileDescriptor;JJ)J
+ */
+JNIEXPORT jlong JNICALL Java_com_aoapps_io_posix_PosixFile_transfer0
+  (JNIEnv *, jclass, jobject, jobject, jlong, jlong);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    readAllBytes0
+ * Signature: (Ljava/lang/String;)[B
+ */
+JNIEXPORT jbyteArray JNICALL Java_com_aoapps_io_posix_PosixFile_readAllBytes0
+  (JNIEnv *, jclass, jstring);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    readAllBytesInto0
+ * Signature: (Ljava/lang/String;[BII)J
+ */
+JNIEXPORT jlong JNICALL Java_com_aoapps_io_posix_PosixFile_readAllBytesInto0
+  (JNIEnv *, jclass, jstring, jbyteArray, jint, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    readAllBytesBatch0
+ * Signature: ([Ljava/lang/String;)[[B
+ */
+JNIEXPORT jobjectArray JNICALL Java_com_aoapps_io_posix_PosixFile_readAllBytesBatch0
+  (JNIEnv *, jclass, jobjectArray);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    writeFiles0
+ * Signature: ([Ljava/lang/String;[[B[J[I[IZ)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFile_writeFiles0
+  (JNIEnv *, jclass, jobjectArray, jobjectArray, jlongArray, jintArray, jintArray, jboolean);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFile
+ * Method:    getCacheResidency0
+ * Signature: (Ljava/lang/String;JJ)[J
+ */
+JNIEXPORT jlongArray JNICALL Java_com_aoapps_io_posix_PosixFile_getCacheResidency0
+  (JNIEnv *, jclass, jstring, jlong, jlong);
+
 /*
  * Class:     com_aoapps_io_posix_PosixFile
  * Method:    mktemp0
@@ -0,0 +1,363 @@
+#define _GNU_SOURCE
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#include <jni.h>
+#include "aocode_shared.h"
+#include "jni_util.h"
+#include "com_aoapps_io_posix_PosixFileHandle.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    open0
+ * Signature: (Ljava/lang/String;IJ)I
+ */
+JNIEXPORT jint JNICALL Java_com_aoapps_io_posix_PosixFileHandle_open0(JNIEnv* env, jclass cls, jstring jfilename, jint flags, jlong mode) {
+  int fd=-1;
+  const char* filename=getString8859_1Chars(env, jfilename);
+  if (filename!=NULL) {
+    do {
+      fd=open(filename, flags|O_CLOEXEC, (mode_t)mode);
+    } while (fd==-1 && errno==EINTR);
+    if (fd==-1) throwErrno(env, errno, filename);
+    releaseString8859_1Chars(filename);
+  }
+  return fd;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    openNoSymlinks0
+ * Signature: (Ljava/lang/String;I)I
+ */
+JNIEXPORT jint JNICALL Java_com_aoapps_io_posix_PosixFileHandle_openNoSymlinks0(JNIEnv* env, jclass cls, jstring jfilename, jint flags) {
+  int fd=-1;
+  const char* filename=getString8859_1Chars(env, jfilename);
+  if (filename!=NULL) {
+    fd=aocode_open_nosymlinks(filename, flags);
+    if (fd==-1) {
+      if (errno==ELOOP) {
+        char message[PATH_MAX+32];
+        snprintf(message, sizeof(message), "Symbolic link found in path: %s", filename);
+        JNU_ThrowByName(env, IO_EXCEPTION, message);
+      } else {
+        throwErrno(env, errno, filename);
+      }
+    }
+    releaseString8859_1Chars(filename);
+  }
+  return fd;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    stat0
+ * Signature: (I)Lcom/aoapps/io/posix/Stat;
+ */
+JNIEXPORT jobject JNICALL Java_com_aoapps_io_posix_PosixFileHandle_stat0(JNIEnv* env, jobject jthis, jint fd) {
+  aocode_stat buff;
+  if (aocode_fstatat(fd, "", &buff, AT_EMPTY_PATH)!=0) {
+    throwErrno(env, errno, NULL);
+    return NULL;
+  }
+  return newStat(env, &buff);
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    chmod0
+ * Signature: (IJ)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFileHandle_chmod0(JNIEnv* env, jobject jthis, jint fd, jlong mode) {
+  if (fchmod(fd, (mode_t)mode)!=0) throwErrno(env, errno, NULL);
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    chown0
+ * Signature: (III)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFileHandle_chown0(JNIEnv* env, jobject jthis, jint fd, jint uid, jint gid) {
+  if (fchown(fd, (uid_t)uid, (gid_t)gid)!=0) throwErrno(env, errno, NULL);
+}
+
+// Converts nanoseconds since the epoch, or one of the special values, to a timespec for futimens
+static void toTimespec(jlong nanos, struct timespec* ts) {
+  // Long.MAX_VALUE and Long.MIN_VALUE on the Java side
+  if (nanos==INT64_MAX) {
+    ts->tv_sec=0;
+    ts->tv_nsec=UTIME_NOW;
+  } else if (nanos==INT64_MIN) {
+    ts->tv_sec=0;
+    ts->tv_nsec=UTIME_OMIT;
+  } else {
+    // Floor division so times before the epoch have a non-negative tv_nsec
+    jlong sec=nanos/1000000000;
+    jlong nsec=nanos%1000000000;
+    if (nsec<0) {
+      sec--;
+      nsec+=1000000000;
+    }
+    ts->tv_sec=(time_t)sec;
+    ts->tv_nsec=(long)nsec;
+  }
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    utimens0
+ * Signature: (IJJ)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFileHandle_utimens0(JNIEnv* env, jobject jthis, jint fd, jlong atime, jlong mtime) {
+  struct timespec times[2];
+  toTimespec(atime, &times[0]);
+  toTimespec(mtime, &times[1]);
+  if (futimens(fd, times)!=0) throwErrno(env, errno, NULL);
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    truncate0
+ * Signature: (IJ)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFileHandle_truncate0(JNIEnv* env, jobject jthis, jint fd, jlong size) {
+  int ret;
+  do {
+    ret=ftruncate(fd, (off_t)size);
+  } while (ret!=0 && errno==EINTR);
+  if (ret!=0) throwErrno(env, errno, NULL);
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    allocate0
+ * Signature: (IJJZ)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFileHandle_allocate0(JNIEnv* env, jobject jthis, jint fd, jlong offset, jlong length, jboolean keepSize) {
+  int ret;
+  do {
+    ret=fallocate(fd, keepSize==JNI_TRUE ? FALLOC_FL_KEEP_SIZE : 0, (off_t)offset, (off_t)length);
+  } while (ret!=0 && errno==EINTR);
+  if (ret!=0 && errno==EOPNOTSUPP && keepSize!=JNI_TRUE) {
+    // Emulated by writing zeros, which cannot keep the size
+    ret=posix_fallocate(fd, (off_t)offset, (off_t)length);
+    if (ret!=0) errno=ret;
+  }
+  if (ret!=0) throwErrno(env, errno, NULL);
+}
+
+// Reads up to this size use the stack
+#define READ_STACK_SIZE 8192
+// The most read by one call, the caller reads again for more
+#define READ_MAX (1024*1024)
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    read0
+ * Signature: (IJ[BII)I
+ */
+JNIEXPORT jint JNICALL Java_com_aoapps_io_posix_PosixFileHandle_read0(JNIEnv* env, jobject jthis, jint fd, jlong position, jbyteArray b, jint off, jint len) {
+  if (len>READ_MAX) len=READ_MAX;
+  // Small reads use the stack, larger reads a single heap buffer, both copied into the array after
+  char stackBuff[READ_STACK_SIZE];
+  char* buff=len<=READ_STACK_SIZE ? stackBuff : (char*)malloc(len);
+  if (buff==NULL) {
+    JNU_ThrowOutOfMemoryError(env, NULL);
+    return -1;
+  }
+  ssize_t count;
+  do {
+    count=pread(fd, buff, len, (off_t)position);
+  } while (count==-1 && errno==EINTR);
+  if (count==-1) {
+    throwErrno(env, errno, NULL);
+  } else if (count>0) {
+    (*env)->SetByteArrayRegion(env, b, off, (jsize)count, (jbyte*)buff);
+  }
+  if (buff!=stackBuff) free(buff);
+  return count==0 ? -1 : (jint)count;
+}
+
+/*
+ * Builds the vector of the direct buffers, returns the number of entries or -1 with an exception pending.
+ * The vector is limited to IOV_MAX entries, the same as the Java side.
+ */
+static int getIovec(JNIEnv* env, jobjectArray jbuffers, jintArray jpositions, jintArray jlengths, struct iovec* iov) {
+  jsize count=(*env)->GetArrayLength(env, jbuffers);
+  if (count>com_aoapps_io_posix_PosixFileHandle_IOV_MAX) count=com_aoapps_io_posix_PosixFileHandle_IOV_MAX;
+  jint positions[com_aoapps_io_posix_PosixFileHandle_IOV_MAX];
+  jint lengths[com_aoapps_io_posix_PosixFileHandle_IOV_MAX];
+  (*env)->GetIntArrayRegion(env, jpositions, 0, count, positions);
+  (*env)->GetIntArrayRegion(env, jlengths, 0, count, lengths);
+  if ((*env)->ExceptionCheck(env)) return -1;
+  jsize c;
+  for (c=0; c<count; c++) {
+    jobject buffer=(*env)->GetObjectArrayElement(env, jbuffers, c);
+    if (buffer==NULL) return -1;
+    char* address=(char*)(*env)->GetDirectBufferAddress(env, buffer);
+    (*env)->DeleteLocalRef(env, buffer);
+    if (address==NULL) {
+      JNU_ThrowByName(env, ILLEGAL_ARGUMENT_EXCEPTION, "Not a direct buffer");
+      return -1;
+    }
+    iov[c].iov_base=address+positions[c];
+    iov[c].iov_len=(size_t)lengths[c];
+  }
+  return count;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    readv0
+ * Signature: (IJ[Ljava/nio/ByteBuffer;[I[II)J
+ */
+JNIEXPORT jlong JNICALL Java_com_aoapps_io_posix_PosixFileHandle_readv0(JNIEnv* env, jobject jthis, jint fd, jlong position, jobjectArray jbuffers, jintArray jpositions, jintArray jlengths, jint flags) {
+  struct iovec iov[com_aoapps_io_posix_PosixFileHandle_IOV_MAX];
+  int count=getIovec(env, jbuffers, jpositions, jlengths, iov);
+  if (count==-1) return 0;
+  size_t total=0;
+  int c;
+  for (c=0; c<count; c++) total+=iov[c].iov_len;
+  if (total==0) return 0;
+  ssize_t ret;
+  do {
+    // Plain preadv without flags, for kernels before preadv2
+    ret=flags==0 ? (position==-1 ? readv(fd, iov, count) : preadv(fd, iov, count, (off_t)position)) : preadv2(fd, iov, count, (off_t)position, flags);
+  } while (ret==-1 && errno==EINTR);
+  if (ret==-1) {
+    // Nothing cached to read without blocking
+    if (errno==EAGAIN && (flags & RWF_NOWAIT)) return 0;
+    throwErrno(env, errno, NULL);
+    return 0;
+  }
+  return ret==0 ? -1 : (jlong)ret;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    writev0
+ * Signature: (IJ[Ljava/nio/ByteBuffer;[I[II)J
+ */
+JNIEXPORT jlong JNICALL Java_com_aoapps_io_posix_PosixFileHandle_writev0(JNIEnv* env, jobject jthis, jint fd, jlong position, jobjectArray jbuffers, jintArray jpositions, jintArray jlengths, jint flags) {
+  struct iovec iov[com_aoapps_io_posix_PosixFileHandle_IOV_MAX];
+  int count=getIovec(env, jbuffers, jpositions, jlengths, iov);
+  if (count==-1) return 0;
+  ssize_t ret;
+  do {
+    ret=flags==0 ? (position==-1 ? writev(fd, iov, count) : pwritev(fd, iov, count, (off_t)position)) : pwritev2(fd, iov, count, (off_t)position, flags);
+  } while (ret==-1 && errno==EINTR);
+  if (ret==-1) {
+    throwErrno(env, errno, NULL);
+    return 0;
+  }
+  return (jlong)ret;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    sync0
+ * Signature: (IZ)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFileHandle_sync0(JNIEnv* env, jobject jthis, jint fd, jboolean metaData) {
+  if ((metaData==JNI_TRUE ? fsync(fd) : fdatasync(fd))!=0) throwErrno(env, errno, NULL);
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    map0
+ * Signature: (IJJZI)J
+ */
+JNIEXPORT jlong JNICALL Java_com_aoapps_io_posix_PosixFileHandle_map0(JNIEnv* env, jobject jthis, jint fd, jlong position, jlong size, jboolean writable, jint flags) {
+  if ((uint64_t)size>SIZE_MAX) {
+    throwErrno(env, ENOMEM, NULL);
+    return 0;
+  }
+  // Shared unless private, only the flags of MappedRegion are passed through
+  int mapFlags=(flags & MAP_PRIVATE) ? MAP_PRIVATE : MAP_SHARED;
+  mapFlags|=flags & (MAP_POPULATE|MAP_HUGETLB);
+  void* address=mmap(NULL, (size_t)size, writable==JNI_TRUE ? PROT_READ|PROT_WRITE : PROT_READ, mapFlags, fd, (off_t)position);
+  if (address==MAP_FAILED) {
+    throwErrno(env, errno, NULL);
+    return 0;
+  }
+  return (jlong)(uintptr_t)address;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    dup0
+ * Signature: (I)Ljava/io/FileDescriptor;
+ */
+JNIEXPORT jobject JNICALL Java_com_aoapps_io_posix_PosixFileHandle_dup0(JNIEnv* env, jobject jthis, jint fd) {
+  int dup=fcntl(fd, F_DUPFD_CLOEXEC, 0);
+  if (dup==-1) {
+    throwErrno(env, errno, NULL);
+    return NULL;
+  }
+  jobject fileDescriptor=newFileDescriptor(env, dup);
+  if (fileDescriptor==NULL) close(dup);
+  return fileDescriptor;
+}
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    close0
+ * Signature: (I)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFileHandle_close0(JNIEnv* env, jclass cls, jint fd) {
+  // Linux always releases the descriptor, so EINTR is not retried
+  if (close(fd)!=0 && errno!=EINTR) throwErrno(env, errno, NULL);
+}
+
+static const JNINativeMethod methods[]={
+  {"open0", "(Ljava/lang/String;IJ)I", (void*)Java_com_aoapps_io_posix_PosixFileHandle_open0},
+  {"openNoSymlinks0", "(Ljava/lang/String;I)I", (void*)Java_com_aoapps_io_posix_PosixFileHandle_openNoSymlinks0},
+  {"stat0", "(I)Lcom/aoapps/io/posix/Stat;", (void*)Java_com_aoapps_io_posix_PosixFileHandle_stat0},
+  {"chmod0", "(IJ)V", (void*)Java_com_aoapps_io_posix_PosixFileHandle_chmod0},
+  {"chown0", "(III)V", (void*)Java_com_aoapps_io_posix_PosixFileHandle_chown0},
+  {"utimens0", "(IJJ)V", (void*)Java_com_aoapps_io_posix_PosixFileHandle_utimens0},
+  {"truncate0", "(IJ)V", (void*)Java_com_aoapps_io_posix_PosixFileHandle_truncate0},
+  {"allocate0", "(IJJZ)V", (void*)Java_com_aoapps_io_posix_PosixFileHandle_allocate0},
+  {"read0", "(IJ[BII)I", (void*)Java_com_aoapps_io_posix_PosixFileHandle_read0},
+  {"readv0", "(IJ[Ljava/nio/ByteBuffer;[I[II)J", (void*)Java_com_aoapps_io_posix_PosixFileHandle_readv0},
+  {"writev0", "(IJ[Ljava/nio/ByteBuffer;[I[II)J", (void*)Java_com_aoapps_io_posix_PosixFileHandle_writev0},
+  {"sync0", "(IZ)V", (void*)Java_com_aoapps_io_posix_PosixFileHandle_sync0},
+  {"map0", "(IJJZI)J", (void*)Java_com_aoapps_io_posix_PosixFileHandle_map0},
+  {"dup0", "(I)Ljava/io/FileDescriptor;", (void*)Java_com_aoapps_io_posix_PosixFileHandle_dup0},
+  {"close0", "(I)V", (void*)Java_com_aoapps_io_posix_PosixFileHandle_close0}
+};
+
+jint registerPosixFileHandleNatives(JNIEnv* env) {
+  return registerNatives(env, "com/aoapps/io/posix/PosixFileHandle", methods, sizeof(methods)/sizeof(methods[0]));
+}
@@ -0,0 +1,177 @@
+/* DO NOT EDIT THIS FILE - it is machine generated */
+#include <jni.h>
+/* Header for class com_aoapps_io_posix_PosixFileHandle */
+
+#ifndef _Included_com_aoapps_io_posix_PosixFileHandle
+#define _Included_com_aoapps_io_posix_PosixFileHandle
+#ifdef __cplusplus
+extern "C" {
+#endif
+#undef com_aoapps_io_posix_PosixFileHandle_O_RDONLY
+#define com_aoapps_io_posix_PosixFileHandle_O_RDONLY 0L
+#undef com_aoapps_io_posix_PosixFileHandle_O_WRONLY
+#define com_aoapps_io_posix_PosixFileHandle_O_WRONLY 1L
+#undef com_aoapps_io_posix_PosixFileHandle_O_RDWR
+#define com_aoapps_io_posix_PosixFileHandle_O_RDWR 2L
+#undef com_aoapps_io_posix_PosixFileHandle_O_CREAT
+#define com_aoapps_io_posix_PosixFileHandle_O_CREAT 64L
+#undef com_aoapps_io_posix_PosixFileHandle_O_EXCL
+#define com_aoapps_io_posix_PosixFileHandle_O_EXCL 128L
+#undef com_aoapps_io_posix_PosixFileHandle_O_TRUNC
+#define com_aoapps_io_posix_PosixFileHandle_O_TRUNC 512L
+#undef com_aoapps_io_posix_PosixFileHandle_O_APPEND
+#define com_aoapps_io_posix_PosixFileHandle_O_APPEND 1024L
+#undef com_aoapps_io_posix_PosixFileHandle_O_NONBLOCK
+#define com_aoapps_io_posix_PosixFileHandle_O_NONBLOCK 2048L
+#undef com_aoapps_io_posix_PosixFileHandle_O_DSYNC
+#define com_aoapps_io_posix_PosixFileHandle_O_DSYNC 4096L
+#undef com_aoapps_io_posix_PosixFileHandle_O_DIRECTORY
+#define com_aoapps_io_posix_PosixFileHandle_O_DIRECTORY 65536L
+#undef com_aoapps_io_posix_PosixFileHandle_O_NOFOLLOW
+#define com_aoapps_io_posix_PosixFileHandle_O_NOFOLLOW 131072L
+#undef com_aoapps_io_posix_PosixFileHandle_O_NOATIME
+#define com_aoapps_io_posix_PosixFileHandle_O_NOATIME 262144L
+#undef com_aoapps_io_posix_PosixFileHandle_O_SYNC
+#define com_aoapps_io_posix_PosixFileHandle_O_SYNC 1052672L
+#undef com_aoapps_io_posix_PosixFileHandle_O_ACCMODE
+#define com_aoapps_io_posix_PosixFileHandle_O_ACCMODE 3L
+#undef com_aoapps_io_posix_PosixFileHandle_UTIME_NOW
+#define com_aoapps_io_posix_PosixFileHandle_UTIME_NOW 9223372036854775807LL
+#undef com_aoapps_io_posix_PosixFileHandle_UTIME_OMIT
+#define com_aoapps_io_posix_PosixFileHandle_UTIME_OMIT -9223372036854775808LL
+#undef com_aoapps_io_posix_PosixFileHandle_RWF_HIPRI
+#define com_aoapps_io_posix_PosixFileHandle_RWF_HIPRI 1L
+#undef com_aoapps_io_posix_PosixFileHandle_RWF_DSYNC
+#define com_aoapps_io_posix_PosixFileHandle_RWF_DSYNC 2L
+#undef com_aoapps_io_posix_PosixFileHandle_RWF_SYNC
+#define com_aoapps_io_posix_PosixFileHandle_RWF_SYNC 4L
+#undef com_aoapps_io_posix_PosixFileHandle_RWF_NOWAIT
+#define com_aoapps_io_posix_PosixFileHandle_RWF_NOWAIT 8L
+#undef com_aoapps_io_posix_PosixFileHandle_RWF_APPEND
+#define com_aoapps_io_posix_PosixFileHandle_RWF_APPEND 16L
+#undef com_aoapps_io_posix_PosixFileHandle_IOV_MAX
+#define com_aoapps_io_posix_PosixFileHandle_IOV_MAX 1024L
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    open0
+ * Signature: (Ljava/lang/String;IJ)I
+ */
+JNIEXPORT jint JNICALL Java_com_aoapps_io_posix_PosixFileHandle_open0
+  (JNIEnv *, jclass, jstring, jint, jlong);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    openNoSymlinks0
+ * Signature: (Ljava/lang/String;I)I
+ */
+JNIEXPORT jint JNICALL Java_com_aoapps_io_posix_PosixFileHandle_openNoSymlinks0
+  (JNIEnv *, jclass, jstring, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    stat0
+ * Signature: (I)Lcom/aoapps/io/posix/Stat;
+ */
+JNIEXPORT jobject JNICALL Java_com_aoapps_io_posix_PosixFileHandle_stat0
+  (JNIEnv *, jobject, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    chmod0
+ * Signature: (IJ)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFileHandle_chmod0
+  (JNIEnv *, jobject, jint, jlong);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    chown0
+ * Signature: (III)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFileHandle_chown0
+  (JNIEnv *, jobject, jint, jint, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    utimens0
+ * Signature: (IJJ)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFileHandle_utimens0
+  (JNIEnv *, jobject, jint, jlong, jlong);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    truncate0
+ * Signature: (IJ)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFileHandle_truncate0
+  (JNIEnv *, jobject, jint, jlong);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    allocate0
+ * Signature: (IJJZ)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFileHandle_allocate0
+  (JNIEnv *, jobject, jint, jlong, jlong, jboolean);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    read0
+ * Signature: (IJ[BII)I
+ */
+JNIEXPORT jint JNICALL Java_com_aoapps_io_posix_PosixFileHandle_read0
+  (JNIEnv *, jobject, jint, jlong, jbyteArray, jint, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    readv0
+ * Signature: (IJ[Ljava/nio/ByteBuffer;[I[II)J
+ */
+JNIEXPORT jlong JNICALL Java_com_aoapps_io_posix_PosixFileHandle_readv0
+  (JNIEnv *, jobject, jint, jlong, jobjectArray, jintArray, jintArray, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    writev0
+ * Signature: (IJ[Ljava/nio/ByteBuffer;[I[II)J
+ */
+JNIEXPORT jlong JNICALL Java_com_aoapps_io_posix_PosixFileHandle_writev0
+  (JNIEnv *, jobject, jint, jlong, jobjectArray, jintArray, jintArray, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    sync0
+ * Signature: (IZ)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFileHandle_sync0
+  (JNIEnv *, jobject, jint, jboolean);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    map0
+ * Signature: (IJJZI)J
+ */
+JNIEXPORT jlong JNICALL Java_com_aoapps_io_posix_PosixFileHandle_map0
+  (JNIEnv *, jobject, jint, jlong, jlong, jboolean, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    dup0
+ * Signature: (I)Ljava/io/FileDescriptor;
+ */
+JNIEXPORT jobject JNICALL Java_com_aoapps_io_posix_PosixFileHandle_dup0
+  (JNIEnv *, jobject, jint);
+
+/*
+ * Class:     com_aoapps_io_posix_PosixFileHandle
+ * Method:    close0
+ * Signature: (I)V
+ */
+JNIEXPORT void JNICALL Java_com_aoapps_io_posix_PosixFileHandle_close0
+  (JNIEnv *, jclass, jint);
+
+#ifdef __cplusplus
+}
+#endif
+#endif
@@ -1,7 +1,7 @@
 #!/bin/sh
 #
 # ao-io-posix - Java interface to native POSIX filesystem objects.
-# Copyright (C) 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007, 2008, 2009, 2010, 2011, 2015, 2021, 2022  AO Industries, Inc.
+# Copyright (C) 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007, 2008, 2009, 2010, 2011, 2015, 2021, 2022, 2026  AO Industries, Inc.
 #     support@aoindustries.com
 #     7262 Bull Pen Cir
 #     Mobile, AL 36695
@@ -21,15 +21,16 @@
 # You should have received a copy of the GNU Lesser General Public License
 # along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
 #
+# The shared library is written with libaocode.so.sha256, holding its SHA-256 and size, which is
+# embedded beside it so a library already extracted is found without hashing either copy.
+SOURCES="aocode_shared.c aocode_blake3.c aocode_copy.c aocode_extent.c aocode_match.c aocode_pool.c aocode_range.c aocode_search.c aocode_symlink.c aocode_walk.c jni_util.c com_aoapps_io_posix_FileHandleCache.c com_aoapps_io_posix_MappedRegion.c com_aoapps_io_posix_PosixFile.c com_aoapps_io_posix_PosixFileHandle.c linux/com_aoapps_io_posix_linux_DevRandom.c"
 gcc -D_FILE_OFFSET_BITS=64 \
   -fPIC \
   -O2 \
-  -shared -lcrypt \
+  -shared -lcrypt -lpthread \
   -I/opt/jdk1.8.0/include \
   -I/opt/jdk1.8.0/include/linux \
   -o libaocode.so \
-  aocode_shared.c \
-  jni_util.c \
-  com_aoapps_io_posix_PosixFile.c \
-  linux/com_aoapps_io_posix_linux_DevRandom.c || exit "$?"
+  $SOURCES || exit "$?"
 strip libaocode.so || exit "$?"
+echo "$(sha256sum libaocode.so | cut -c1-64) $(stat -c %s libaocode.so)" > libaocode.so.sha256 || exit "$?"
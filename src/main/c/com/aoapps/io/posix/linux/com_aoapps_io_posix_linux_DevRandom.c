@@ -1,6 +1,6 @@
 /*
  * ao-io-posix - Java interface to native POSIX filesystem objects.
- * Copyright (C) 2004, 2005, 2006, 2007, 2008, 2009, 2010, 2011, 2015, 2016, 2021, 2022  AO Industries, Inc.
+ * Copyright (C) 2004, 2005, 2006, 2007, 2008, 2009, 2010, 2011, 2015, 2016, 2021, 2022, 2026  AO Industries, Inc.
  *     support@aoindustries.com
  *     7262 Bull Pen Cir
  *     Mobile, AL 36695
@@ -70,3 +70,11 @@ JNIEXPORT void JNICALL Java_com_aoapps_io_posix_linux_DevRandom_addEntropy0(JNIE
   if (newExcCls!=NULL) (*env)->ThrowNew(env, newExcCls, strerror(errno));
   return;
 }
+
+static const JNINativeMethod methods[]={
+  {"addEntropy0", "([B)V", (void*)Java_com_aoapps_io_posix_linux_DevRandom_addEntropy0}
+};
+
+jint registerDevRandomNatives(JNIEnv* env) {
+  return registerNatives(env, "com/aoapps/io/posix/linux/DevRandom", methods, sizeof(methods)/sizeof(methods[0]));
+}
@@ -0,0 +1,111 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+package com.aoapps.io.posix;
+
+/**
+ * How much of a range of a file is in the page cache, as counted by {@link PosixFile#getCacheResidency(long, long)}.
+ * <p>
+ * All counts are in pages.  The dirty, writeback, and eviction counts come from the {@code cachestat} system call
+ * and are {@code -1} on kernels before Linux 6.5, where only the cached pages are counted with {@code mincore}.
+ * </p>
+ *
+ * @author  AO Industries, Inc.
+ */
+public final class CacheResidency {
+
+  private final long pages;
+  private final long cached;
+  private final long dirty;
+  private final long writeback;
+  private final long evicted;
+  private final long recentlyEvicted;
+
+  /**
+   * @param  counts  the pages, cached, dirty, writeback, evicted, and recently evicted counts
+   */
+  CacheResidency(long[] counts) {
+    this.pages = counts[0];
+    this.cached = counts[1];
+    this.dirty = counts[2];
+    this.writeback = counts[3];
+    this.evicted = counts[4];
+    this.recentlyEvicted = counts[5];
+  }
+
+  @Override
+  public String toString() {
+    return cached + "/" + pages + " cached, " + dirty + " dirty, " + writeback + " writeback";
+  }
+
+  /**
+   * Gets the number of pages in the range, limited to the end of the file.
+   */
+  public long getPages() {
+    return pages;
+  }
+
+  /**
+   * Gets the number of pages in the page cache.
+   */
+  public long getCached() {
+    return cached;
+  }
+
+  /**
+   * Gets the number of cached pages not yet written, or {@code -1} when unknown.
+   */
+  public long getDirty() {
+    return dirty;
+  }
+
+  /**
+   * Gets the number of cached pages being written, or {@code -1} when unknown.
+   */
+  public long getWriteback() {
+    return writeback;
+  }
+
+  /**
+   * Gets the number of pages evicted from the page cache, or {@code -1} when unknown.
+   */
+  public long getEvicted() {
+    return evicted;
+  }
+
+  /**
+   * Gets the number of evicted pages that would still be cached with a larger page cache, or {@code -1} when
+   * unknown.
+   */
+  public long getRecentlyEvicted() {
+    return recentlyEvicted;
+  }
+
+  /**
+   * Is every page of the range in the page cache, so reading it needs no disk I/O.
+   */
+  public boolean isFullyCached() {
+    return cached >= pages;
+  }
+}
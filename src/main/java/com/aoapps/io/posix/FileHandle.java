@@ -0,0 +1,134 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import java.util.Arrays;
+
+/**
+ * A persistent, opaque handle to a file as returned by the Linux <code>name_to_handle_at</code> call.
+ * The handle remains valid across renames of the file and its parents and may be stored,
+ * such as in a catalog, and later reopened with {@link PosixFile#openByHandle(com.aoapps.io.posix.FileHandle)}
+ * without any path resolution.
+ * <p>
+ * The handle includes the mount id, which is only meaningful until the filesystem is unmounted.
+ * </p>
+ *
+ * @see  PosixFile#getFileHandle()
+ *
+ * @author  AO Industries, Inc.
+ */
+public final class FileHandle {
+
+  /**
+   * The number of bytes before the filesystem-specific handle: the handle type and the mount id.
+   */
+  private static final int HEADER_SIZE = 8;
+
+  /**
+   * The largest handle accepted, matching <code>MAX_HANDLE_SZ</code>.
+   */
+  private static final int MAX_HANDLE_SIZE = 128;
+
+  /**
+   * Gets a handle from its encoded form.
+   *
+   * @see  #toByteArray()
+   *
+   * @throws  IllegalArgumentException  when not a valid encoded handle
+   */
+  public static FileHandle valueOf(byte[] encoded) throws IllegalArgumentException {
+    if (encoded.length < HEADER_SIZE || encoded.length > HEADER_SIZE + MAX_HANDLE_SIZE) {
+      throw new IllegalArgumentException("Invalid file handle length: " + encoded.length);
+    }
+    return new FileHandle(encoded.clone());
+  }
+
+  private final byte[] encoded;
+
+  /**
+   * Takes ownership of the encoded array.
+   */
+  FileHandle(byte[] encoded) {
+    this.encoded = encoded;
+  }
+
+  /**
+   * Gets the filesystem-specific type of handle.
+   */
+  public int getHandleType() {
+    return getInt(0);
+  }
+
+  /**
+   * Gets the id of the mount containing the file, as found in <code>/proc/self/mountinfo</code>.
+   */
+  public int getMountId() {
+    return getInt(4);
+  }
+
+  private int getInt(int off) {
+    return
+        ((encoded[off] & 0xff) << 24)
+            | ((encoded[off + 1] & 0xff) << 16)
+            | ((encoded[off + 2] & 0xff) << 8)
+            | (encoded[off + 3] & 0xff);
+  }
+
+  /**
+   * Gets the compact encoded form of this handle, suitable for storage.
+   *
+   * @see  #valueOf(byte[])
+   */
+  public byte[] toByteArray() {
+    return encoded.clone();
+  }
+
+  /**
+   * Gets the encoded form without copying.
+   */
+  byte[] getEncoded() {
+    return encoded;
+  }
+
+  @Override
+  public boolean equals(Object obj) {
+    return
+        (obj instanceof FileHandle)
+            && Arrays.equals(encoded, ((FileHandle) obj).encoded);
+  }
+
+  @Override
+  public int hashCode() {
+    return Arrays.hashCode(encoded);
+  }
+
+  @Override
+  public String toString() {
+    StringBuilder sb = new StringBuilder(encoded.length * 2);
+    for (byte b : encoded) {
+      sb.append(Character.forDigit((b >>> 4) & 0xf, 16)).append(Character.forDigit(b & 0xf, 16));
+    }
+    return sb.toString();
+  }
+}
@@ -0,0 +1,497 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import java.io.FileNotFoundException;
+import java.io.IOException;
+import java.io.InputStream;
+import java.util.ArrayList;
+import java.util.HashMap;
+import java.util.Iterator;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.logging.Level;
+import java.util.logging.Logger;
+
+/**
+ * A bounded cache of open, read-only file descriptors for files that are read repeatedly, such as templates,
+ * certificates, and static assets.  Each file is opened once and shared by all concurrent readers, who read with
+ * <code>pread</code> so no reader changes the position of another.
+ * <p>
+ * Files are held by their device and inode, with the least recently used closed first once more than the maximum
+ * are open.  The maximum is limited to a quarter of the process limit on open files.
+ * </p>
+ * <p>
+ * Symbolic links are never followed, anywhere in the path, so a link placed by another user cannot redirect
+ * the cache to a file of their choosing.
+ * A cached path is checked with <code>stat</code> on each use, and reopened when it leads to a different file, such
+ * as after a rename, or when the change time or size of its file differ or the file has been removed.  Each file is also watched with <code>inotify</code>, when available, so files that are
+ * changed or removed are closed promptly instead of holding the space of removed files.
+ * </p>
+ *
+ * @author  AO Industries, Inc.
+ */
+public final class FileHandleCache implements AutoCloseable {
+
+  private static final Logger logger = Logger.getLogger(FileHandleCache.class.getName());
+
+  /**
+   * The watch descriptor reported when events were lost.
+   */
+  private static final int OVERFLOW = -1;
+
+  /**
+   * The least time between reading the pending inotify events, in nanoseconds.
+   */
+  private static final long DRAIN_INTERVAL = 10L * 1000 * 1000;
+
+  /**
+   * The fields of {@link #getFileId0(int, long[])} and {@link #getPathId0(java.lang.String, long[])}.
+   */
+  private static final int ID_DEV = 0;
+  private static final int ID_INO = 1;
+  private static final int ID_SIZE = 2;
+  private static final int ID_CTIME = 3;
+  private static final int ID_NLINK = 4;
+  private static final int ID_MODE = 5;
+  private static final int ID_LENGTH = 6;
+
+  private static final long S_IFMT = 0170000;
+  private static final long S_IFREG = 0100000;
+
+  private static final class Key {
+
+    private final long dev;
+    private final long ino;
+
+    private Key(long dev, long ino) {
+      this.dev = dev;
+      this.ino = ino;
+    }
+
+    @Override
+    public boolean equals(Object obj) {
+      if (!(obj instanceof Key)) {
+        return false;
+      }
+      Key other = (Key) obj;
+      return dev == other.dev && ino == other.ino;
+    }
+
+    @Override
+    public int hashCode() {
+      return (int) (dev * 31 + ino) ^ (int) (ino >>> 32);
+    }
+  }
+
+  /**
+   * One open file, shared by all paths leading to it.
+   */
+  private static final class Entry {
+
+    private final Key key;
+    private final PosixFileHandle handle;
+    private final long size;
+    private final long ctime;
+    private final List<String> paths = new ArrayList<>(1);
+    private int wd = -1;
+    private int leases;
+    private boolean removed;
+
+    private Entry(Key key, PosixFileHandle handle, long size, long ctime) {
+      this.key = key;
+      this.handle = handle;
+      this.size = size;
+      this.ctime = ctime;
+    }
+  }
+
+  private final int maxOpen;
+  private final LinkedHashMap<Key, Entry> entries = new LinkedHashMap<>(16, 0.75f, true);
+  private final Map<String, Entry> byPath = new HashMap<>();
+  private final Map<Integer, Entry> byWatch = new HashMap<>();
+  private final int inotifyFd;
+  private long lastDrain;
+  private boolean closed;
+
+  /**
+   * Creates a cache of at most the given number of open files.
+   *
+   * @param  maxOpen  the most files kept open, limited to a quarter of the process limit on open files
+   */
+  public FileHandleCache(int maxOpen) throws IOException {
+    if (maxOpen < 1) {
+      throw new IllegalArgumentException("maxOpen < 1: " + maxOpen);
+    }
+    PosixFile.loadLibrary();
+    this.maxOpen = (int) Math.max(1, Math.min(maxOpen, getOpenFileLimit0() / 4));
+    int fd;
+    try {
+      fd = inotifyInit0();
+    } catch (IOException e) {
+      // Validated by fstat alone
+      logger.log(Level.FINE, "inotify not available", e);
+      fd = -1;
+    }
+    inotifyFd = fd;
+    lastDrain = System.nanoTime();
+  }
+
+  /**
+   * Creates a cache of up to a quarter of the process limit on open files.
+   */
+  public FileHandleCache() throws IOException {
+    this(Integer.MAX_VALUE);
+  }
+
+  private static native long getOpenFileLimit0() throws IOException;
+
+  private static native int inotifyInit0() throws IOException;
+
+  private static native int addWatch0(int inotifyFd, int fd) throws IOException;
+
+  private static native void removeWatch0(int inotifyFd, int wd) throws IOException;
+
+  private static native int[] readEvents0(int inotifyFd) throws IOException;
+
+  private static native void getFileId0(int fd, long[] id) throws IOException;
+
+  private static native boolean getPathId0(String path, long[] id) throws IOException;
+
+  private static native void close0(int fd) throws IOException;
+
+  /**
+   * Gets the most files kept open.
+   */
+  public int getMaxOpen() {
+    return maxOpen;
+  }
+
+  /**
+   * Gets the number of files currently cached.
+   */
+  public synchronized int size() {
+    return entries.size();
+  }
+
+  /**
+   * Opens a regular file through the cache.  The lease must be closed, which releases the file back to the cache
+   * without closing it.
+   * <p>
+   * This method will not follow any symbolic links in the path.
+   * </p>
+   *
+   * @throws  FileNotFoundException  when the file does not exist
+   * @throws  IOException  when not a regular file or any component of the path is a symbolic link
+   */
+  public Lease open(PosixFile file) throws IOException {
+    file.checkRead();
+    String path = file.getPath();
+    long[] id = new long[ID_LENGTH];
+    Entry entry;
+    synchronized (this) {
+      checkNotClosed();
+      drainEvents();
+      entry = byPath.get(path);
+      if (entry != null) {
+        entry.leases++;
+        // Moves to most recently used
+        entries.get(entry.key);
+      }
+    }
+    if (entry != null) {
+      boolean current;
+      try {
+        // The path, not the open file, so a path now leading elsewhere, or through a symbolic link, is reopened
+        current = getPathId0(path, id)
+            && id[ID_DEV] == entry.key.dev
+            && id[ID_INO] == entry.key.ino
+            && id[ID_SIZE] == entry.size
+            && id[ID_CTIME] == entry.ctime
+            && id[ID_NLINK] > 0;
+      } catch (IOException e) {
+        release(entry);
+        throw e;
+      }
+      if (current) {
+        return new Lease(entry);
+      }
+      synchronized (this) {
+        remove(entry);
+      }
+      release(entry);
+    }
+    // Opened outside the lock, the slow path
+    PosixFileHandle handle = PosixFileHandle.openNoSymlinks(file, PosixFileHandle.O_RDONLY | PosixFileHandle.O_NONBLOCK);
+    try {
+      getFileId0(handle.getFd(), id);
+      if ((id[ID_MODE] & S_IFMT) != S_IFREG) {
+        throw new IOException("Not a regular file: " + path);
+      }
+    } catch (IOException | RuntimeException e) {
+      handle.close();
+      throw e;
+    }
+    Key key = new Key(id[ID_DEV], id[ID_INO]);
+    PosixFileHandle extra = null;
+    synchronized (this) {
+      if (closed) {
+        extra = handle;
+        entry = null;
+      } else {
+        // Another path, or another thread, may have opened the same file
+        entry = entries.get(key);
+        if (entry != null && entry.size == id[ID_SIZE] && entry.ctime == id[ID_CTIME]) {
+          extra = handle;
+        } else {
+          if (entry != null) {
+            remove(entry);
+          }
+          entry = new Entry(key, handle, id[ID_SIZE], id[ID_CTIME]);
+          if (inotifyFd != -1) {
+            try {
+              entry.wd = addWatch0(inotifyFd, handle.getFd());
+              byWatch.put(entry.wd, entry);
+            } catch (IOException e) {
+              // Such as exceeding the limit on watches, validated by fstat alone
+              logger.log(Level.FINE, null, e);
+            }
+          }
+          entries.put(key, entry);
+          evict();
+        }
+        Entry previous = byPath.put(path, entry);
+        if (previous != entry) {
+          if (previous != null) {
+            previous.paths.remove(path);
+          }
+          entry.paths.add(path);
+        }
+        entry.leases++;
+      }
+    }
+    if (extra != null) {
+      extra.close();
+    }
+    if (entry == null) {
+      throw new IOException("Cache closed");
+    }
+    return new Lease(entry);
+  }
+
+  private void checkNotClosed() throws IOException {
+    if (closed) {
+      throw new IOException("Cache closed");
+    }
+  }
+
+  /**
+   * Closes the files reported changed by inotify, at most once per {@link #DRAIN_INTERVAL}.
+   */
+  private void drainEvents() throws IOException {
+    assert Thread.holdsLock(this);
+    if (inotifyFd != -1) {
+      long now = System.nanoTime();
+      if (now - lastDrain >= DRAIN_INTERVAL) {
+        lastDrain = now;
+        int[] wds;
+        while ((wds = readEvents0(inotifyFd)) != null) {
+          for (int wd : wds) {
+            if (wd == OVERFLOW) {
+              // Events were lost, so nothing cached can be trusted
+              for (Entry entry : new ArrayList<>(entries.values())) {
+                remove(entry);
+              }
+            } else {
+              Entry entry = byWatch.get(wd);
+              if (entry != null) {
+                remove(entry);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Closes the least recently used files until no more than the maximum remain.
+   */
+  private void evict() throws IOException {
+    assert Thread.holdsLock(this);
+    Iterator<Entry> iter = entries.values().iterator();
+    while (entries.size() > maxOpen && iter.hasNext()) {
+      Entry entry = iter.next();
+      iter.remove();
+      removeMappings(entry);
+    }
+  }
+
+  /**
+   * Removes an entry from the cache, its file is closed once no longer leased.
+   */
+  private void remove(Entry entry) throws IOException {
+    assert Thread.holdsLock(this);
+    if (!entry.removed) {
+      if (entries.get(entry.key) == entry) {
+        entries.remove(entry.key);
+      }
+      removeMappings(entry);
+    }
+  }
+
+  private void removeMappings(Entry entry) throws IOException {
+    assert Thread.holdsLock(this);
+    entry.removed = true;
+    for (String path : entry.paths) {
+      if (byPath.get(path) == entry) {
+        byPath.remove(path);
+      }
+    }
+    entry.paths.clear();
+    if (entry.wd != -1) {
+      if (byWatch.get(entry.wd) == entry) {
+        byWatch.remove(entry.wd);
+        removeWatch0(inotifyFd, entry.wd);
+      }
+      entry.wd = -1;
+    }
+    if (entry.leases == 0) {
+      entry.handle.close();
+    }
+  }
+
+  /**
+   * Releases one lease, closing the file when removed from the cache and no longer leased.
+   */
+  private void release(Entry entry) throws IOException {
+    boolean close;
+    synchronized (this) {
+      close = --entry.leases == 0 && entry.removed;
+    }
+    if (close) {
+      entry.handle.close();
+    }
+  }
+
+  /**
+   * Closes all files not currently leased, the rest are closed as their leases are closed.
+   * The cache may not be used after closing.
+   */
+  @Override
+  public void close() throws IOException {
+    synchronized (this) {
+      if (closed) {
+        return;
+      }
+      closed = true;
+      for (Entry entry : new ArrayList<>(entries.values())) {
+        remove(entry);
+      }
+    }
+    if (inotifyFd != -1) {
+      close0(inotifyFd);
+    }
+  }
+
+  /**
+   * One reader's use of a cached file.  Any number of threads may share a lease, which must be closed once.
+   */
+  public final class Lease implements AutoCloseable {
+
+    private final Entry entry;
+    private boolean released;
+
+    private Lease(Entry entry) {
+      this.entry = entry;
+    }
+
+    /**
+     * Gets the size of the file as of when it was opened.
+     */
+    public long getSize() {
+      return entry.size;
+    }
+
+    /**
+     * Reads from a position in the file.
+     *
+     * @see  PosixFileHandle#read(long, byte[], int, int)
+     */
+    public int read(long position, byte[] b, int off, int len) throws IOException {
+      return entry.handle.read(position, b, off, len);
+    }
+
+    /**
+     * Gets a new stream over the whole file, with its own position.  Closing the stream does not close this lease.
+     */
+    public InputStream getInputStream() {
+      return new InputStream() {
+        private long position;
+
+        @Override
+        public int read() throws IOException {
+          byte[] b = new byte[1];
+          return read(b, 0, 1) == -1 ? -1 : (b[0] & 0xff);
+        }
+
+        @Override
+        public int read(byte[] b, int off, int len) throws IOException {
+          int count = Lease.this.read(position, b, off, len);
+          if (count > 0) {
+            position += count;
+          }
+          return count;
+        }
+
+        @Override
+        public long skip(long n) {
+          long skipped = Math.max(0, Math.min(n, entry.size - position));
+          position += skipped;
+          return skipped;
+        }
+
+        @Override
+        public int available() {
+          return (int) Math.min(Integer.MAX_VALUE, Math.max(0, entry.size - position));
+        }
+      };
+    }
+
+    /**
+     * Releases the file back to the cache, closing again has no effect.
+     */
+    @Override
+    public void close() throws IOException {
+      synchronized (this) {
+        if (released) {
+          return;
+        }
+        released = true;
+      }
+      release(entry);
+    }
+  }
+}
@@ -0,0 +1,86 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+/**
+ * One file to be written by {@link PosixFile#writeFiles(java.util.List, boolean)}.
+ *
+ * @author  AO Industries, Inc.
+ */
+public final class FileSpec {
+
+  private final PosixFile file;
+  private final byte[] contents;
+  private final long mode;
+  private final int uid;
+  private final int gid;
+
+  /**
+   * The contents are not copied and must not be modified until written.
+   *
+   * @param  mode  the permission bits of the new file, only the lower 12 bits are used
+   * @param  uid   the owner of the new file or <code>-1</code> for the current user
+   * @param  gid   the group of the new file or <code>-1</code> for the current group
+   */
+  public FileSpec(PosixFile file, byte[] contents, long mode, int uid, int gid) {
+    if (file == null) {
+      throw new IllegalArgumentException("file is null");
+    }
+    if (contents == null) {
+      throw new IllegalArgumentException("contents is null");
+    }
+    this.file = file;
+    this.contents = contents;
+    this.mode = mode;
+    this.uid = uid;
+    this.gid = gid;
+  }
+
+  /**
+   * Writes with the current user and group.
+   */
+  public FileSpec(PosixFile file, byte[] contents, long mode) {
+    this(file, contents, mode, -1, -1);
+  }
+
+  public PosixFile getFile() {
+    return file;
+  }
+
+  public byte[] getContents() {
+    return contents;
+  }
+
+  public long getMode() {
+    return mode;
+  }
+
+  public int getUid() {
+    return uid;
+  }
+
+  public int getGid() {
+    return gid;
+  }
+}
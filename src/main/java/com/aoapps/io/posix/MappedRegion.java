@@ -0,0 +1,361 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import java.io.IOException;
+import java.lang.ref.PhantomReference;
+import java.lang.ref.Reference;
+import java.lang.ref.ReferenceQueue;
+import java.nio.ByteBuffer;
+import java.nio.channels.ClosedChannelException;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.logging.Level;
+import java.util.logging.Logger;
+
+/**
+ * A memory mapping of a range of a file, which unlike {@link java.nio.channels.FileChannel#map(java.nio.channels.FileChannel.MapMode, long, long)}
+ * may exceed 2 GiB, may be populated or backed by huge pages, and is unmapped explicitly.
+ * Its contents are accessed through {@link ByteBuffer} windows of up to 2 GiB each at any offset.
+ * <p>
+ * The memory is unmapped once the region is closed, or unreachable, and all of its windows are unreachable, so
+ * a window remains usable after the region is closed.  Unreachable regions and windows are released by a daemon
+ * thread once the garbage collector finds them, or sooner when another region is mapped or closed.
+ * </p>
+ *
+ * @see  PosixFileHandle#map(long, long, int)
+ * @see  PosixFile#map(long, long, int)
+ *
+ * @author  AO Industries, Inc.
+ */
+public final class MappedRegion implements AutoCloseable {
+
+  private static final Logger logger = Logger.getLogger(MappedRegion.class.getName());
+
+  /**
+   * Map flag: Changes are private to this process instead of written to the file.
+   */
+  public static final int MAP_PRIVATE = 0x02;
+
+  /**
+   * Map flag: Read the whole range into memory and map it before returning, so later access does not fault.
+   */
+  public static final int MAP_POPULATE = 0x8000;
+
+  /**
+   * Map flag: Back the mapping with huge pages, only possible for files on <code>hugetlbfs</code>.
+   */
+  public static final int MAP_HUGETLB = 0x40000;
+
+  /**
+   * Advice: No special treatment.
+   */
+  public static final int MADV_NORMAL = 0;
+
+  /**
+   * Advice: Expect access in random order, so read ahead is disabled.
+   */
+  public static final int MADV_RANDOM = 1;
+
+  /**
+   * Advice: Expect access in order, so read ahead is aggressive and pages may be freed soon after access.
+   */
+  public static final int MADV_SEQUENTIAL = 2;
+
+  /**
+   * Advice: Expect access soon, so reading into the page cache begins now.
+   */
+  public static final int MADV_WILLNEED = 3;
+
+  /**
+   * Advice: Do not expect access soon, so the pages may be freed.
+   */
+  public static final int MADV_DONTNEED = 4;
+
+  /**
+   * Advice: Back the range with transparent huge pages where possible, for fewer TLB misses.
+   */
+  public static final int MADV_HUGEPAGE = 14;
+
+  /**
+   * Advice: Do not back the range with transparent huge pages.
+   */
+  public static final int MADV_NOHUGEPAGE = 15;
+
+  private static long pageSize;
+
+  /**
+   * Gets the size of a page, which mappings and advice are aligned to.
+   */
+  static long getPageSize() {
+    if (pageSize == 0) {
+      PosixFile.loadLibrary();
+      pageSize = getPageSize0();
+    }
+    return pageSize;
+  }
+
+  private static native long getPageSize0();
+
+  /**
+   * The memory of one region, unmapped once no longer referenced by the region, its windows, or a call in progress.
+   */
+  private static final class Mapping {
+
+    private final long base;
+    private final long size;
+    private int refs = 1;
+
+    private Mapping(long base, long size) {
+      this.base = base;
+      this.size = size;
+    }
+
+    private synchronized void acquire() {
+      refs++;
+    }
+
+    private void release() throws IOException {
+      boolean unmap;
+      synchronized (this) {
+        unmap = --refs == 0;
+      }
+      if (unmap) {
+        unmap0(base, size);
+      }
+    }
+  }
+
+  /**
+   * Releases a mapping exactly once, either explicitly or after its region or window is unreachable.
+   */
+  private static final class Releaser extends PhantomReference<Object> {
+
+    private final Mapping mapping;
+    private final AtomicBoolean released = new AtomicBoolean();
+
+    private Releaser(Object referent, Mapping mapping) {
+      super(referent, queue);
+      this.mapping = mapping;
+    }
+
+    private void release() throws IOException {
+      if (released.compareAndSet(false, true)) {
+        releasers.remove(this);
+        mapping.release();
+      }
+    }
+  }
+
+  private static final ReferenceQueue<Object> queue = new ReferenceQueue<>();
+
+  /**
+   * Keeps the releasers reachable until their regions or windows are.
+   */
+  private static final Set<Releaser> releasers = ConcurrentHashMap.newKeySet();
+
+  private static void release(Reference<?> ref) {
+    try {
+      ((Releaser) ref).release();
+    } catch (IOException e) {
+      logger.log(Level.WARNING, null, e);
+    }
+  }
+
+  /**
+   * Releases the mappings of any regions and windows that became unreachable.
+   */
+  private static void releaseUnreachable() {
+    Reference<?> ref;
+    while ((ref = queue.poll()) != null) {
+      release(ref);
+    }
+  }
+
+  private static final AtomicBoolean drainerStarted = new AtomicBoolean();
+
+  /**
+   * Starts the daemon thread that releases unreachable regions and windows as they are found,
+   * so their memory is unmapped even when no more regions are mapped.
+   */
+  private static void startDrainer() {
+    if (drainerStarted.compareAndSet(false, true)) {
+      Thread drainer = new Thread(() -> {
+        try {
+          while (true) {
+            release(queue.remove());
+          }
+        } catch (InterruptedException e) {
+          Thread.currentThread().interrupt();
+        }
+      }, MappedRegion.class.getName() + ".drainer");
+      drainer.setDaemon(true);
+      drainer.start();
+    }
+  }
+
+  private final Mapping mapping;
+  private final Releaser releaser;
+  private final long base;
+  private final long address;
+  private final long size;
+  private final boolean writable;
+  private boolean closed;
+
+  /**
+   * @param  base        the address of the mapping, page aligned
+   * @param  mappedSize  the size of the mapping from its base
+   * @param  address     the address of the first byte requested
+   * @param  size        the number of bytes requested
+   */
+  MappedRegion(long base, long mappedSize, long address, long size, boolean writable) {
+    startDrainer();
+    releaseUnreachable();
+    mapping = new Mapping(base, mappedSize);
+    releaser = new Releaser(this, mapping);
+    releasers.add(releaser);
+    this.base = base;
+    this.address = address;
+    this.size = size;
+    this.writable = writable;
+  }
+
+  /**
+   * Gets the size of the region.
+   */
+  public long getSize() {
+    return size;
+  }
+
+  /**
+   * Is the region writable.
+   */
+  public boolean isWritable() {
+    return writable;
+  }
+
+  /**
+   * Keeps the memory mapped until released, even if the region is closed meanwhile.
+   */
+  private synchronized Mapping acquire() throws ClosedChannelException {
+    if (closed) {
+      throw new ClosedChannelException();
+    }
+    mapping.acquire();
+    return mapping;
+  }
+
+  private void checkRange(long offset, long length) {
+    if (offset < 0 || length < 0 || length > size - offset) {
+      throw new IndexOutOfBoundsException("offset=" + offset + ", length=" + length + ", size=" + size);
+    }
+  }
+
+  /**
+   * Gets a window of the region as a direct buffer, read-only unless the region is writable.
+   * The memory remains mapped while the window, or any buffer derived from it, is reachable.
+   *
+   * @param  offset  the offset within the region, which may exceed 2 GiB
+   */
+  public ByteBuffer getBuffer(long offset, int length) throws IOException {
+    checkRange(offset, length);
+    releaseUnreachable();
+    Mapping acquired = acquire();
+    ByteBuffer buffer;
+    try {
+      buffer = newBuffer0(address + offset, length);
+    } catch (Throwable t) {
+      acquired.release();
+      throw t;
+    }
+    // Read-only views and slices refer back to this buffer, so it is unreachable only after them
+    releasers.add(new Releaser(buffer, acquired));
+    return writable ? buffer : buffer.asReadOnlyBuffer();
+  }
+
+  private static native ByteBuffer newBuffer0(long address, int length);
+
+  /**
+   * Gives advice about the expected use of a range of the region, which is widened to whole pages.
+   *
+   * @param  advice  one of the <code>MADV_*</code> constants
+   */
+  public void advise(long offset, long length, int advice) throws IOException {
+    checkRange(offset, length);
+    Mapping acquired = acquire();
+    try {
+      long start = address + offset;
+      long aligned = start - (start - base) % getPageSize();
+      advise0(aligned, start + length - aligned, advice);
+    } finally {
+      acquired.release();
+    }
+  }
+
+  private static native void advise0(long address, long length, int advice) throws IOException;
+
+  /**
+   * Writes the changes of a range of the region to the file, which is widened to whole pages.
+   *
+   * @param  async  when {@code true}, schedules the writes and returns at once
+   */
+  public void sync(long offset, long length, boolean async) throws IOException {
+    checkRange(offset, length);
+    Mapping acquired = acquire();
+    try {
+      long start = address + offset;
+      long aligned = start - (start - base) % getPageSize();
+      sync0(aligned, start + length - aligned, async);
+    } finally {
+      acquired.release();
+    }
+  }
+
+  private static native void sync0(long address, long length, boolean async) throws IOException;
+
+  /**
+   * Writes all changes of the region to the file and waits for them.
+   */
+  public void sync() throws IOException {
+    sync(0, size, false);
+  }
+
+  /**
+   * Closes the region, which is unmapped once none of its windows are reachable.  Closing again has no effect.
+   */
+  @Override
+  public void close() throws IOException {
+    synchronized (this) {
+      if (closed) {
+        return;
+      }
+      closed = true;
+    }
+    releaser.release();
+    releaseUnreachable();
+  }
+
+  private static native void unmap0(long address, long length) throws IOException;
+}
@@ -1,6 +1,6 @@
 /*
  * ao-io-posix - Java interface to native POSIX filesystem objects.
- * Copyright (C) 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007, 2008, 2009, 2010, 2011, 2013, 2015, 2016, 2017, 2018, 2019, 2020, 2021, 2022, 2024  AO Industries, Inc.
+ * Copyright (C) 2000, 2001, 2002, 2003, 2004, 2005, 2006, 2007, 2008, 2009, 2010, 2011, 2013, 2015, 2016, 2017, 2018, 2019, 2020, 2021, 2022, 2024, 2026  AO Industries, Inc.
  *     support@aoindustries.com
  *     7262 Bull Pen Cir
  *     Mobile, AL 36695
@@ -27,7 +27,9 @@ import com.aoapps.lang.io.FileUtils;
 import com.aoapps.lang.io.IoUtils;
 import com.aoapps.lang.util.BufferManager;
 import java.io.BufferedInputStream;
+import java.io.ByteArrayOutputStream;
 import java.io.File;
+import java.io.FileDescriptor;
 import java.io.FileInputStream;
 import java.io.FileNotFoundException;
 import java.io.FileOutputStream;
@@ -35,11 +37,24 @@ import java.io.IOException;
 import java.io.InputStream;
 import java.io.OutputStream;
 import java.io.RandomAccessFile;
+import java.nio.charset.StandardCharsets;
 import java.nio.file.Files;
+import java.nio.file.LinkOption;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.nio.file.StandardCopyOption;
+import java.nio.file.attribute.FileTime;
+import java.nio.file.attribute.PosixFilePermissions;
+import java.security.GeneralSecurityException;
+import java.security.MessageDigest;
 import java.security.SecureRandom;
 import java.util.ArrayList;
+import java.util.HashSet;
 import java.util.List;
+import java.util.Set;
 import java.util.Stack;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.TimeoutException;
 import java.util.logging.Level;
 import java.util.logging.Logger;
 
@@ -187,23 +202,311 @@ public class PosixFile {
    */
   public static final long IS_SOCKET = 0140000;
 
+  /**
+   * Inode flag: Secure deletion (<code>s</code>), not honored by most filesystems.
+   */
+  public static final int FLAG_SECURE_DELETION = 0x1;
+
+  /**
+   * Inode flag: Undeletable (<code>u</code>), not honored by most filesystems.
+   */
+  public static final int FLAG_UNDELETE = 0x2;
+
+  /**
+   * Inode flag: Compressed by the filesystem (<code>c</code>).
+   */
+  public static final int FLAG_COMPRESSED = 0x4;
+
+  /**
+   * Inode flag: Synchronous updates (<code>S</code>).
+   */
+  public static final int FLAG_SYNC = 0x8;
+
+  /**
+   * Inode flag: Immutable (<code>i</code>), may not be modified, renamed, deleted, or linked to.
+   */
+  public static final int FLAG_IMMUTABLE = 0x10;
+
+  /**
+   * Inode flag: Append only (<code>a</code>), may only be opened for appending.
+   */
+  public static final int FLAG_APPEND_ONLY = 0x20;
+
+  /**
+   * Inode flag: No dump (<code>d</code>), excluded from backups.
+   */
+  public static final int FLAG_NO_DUMP = 0x40;
+
+  /**
+   * Inode flag: No access time updates (<code>A</code>).
+   */
+  public static final int FLAG_NO_ATIME = 0x80;
+
+  /**
+   * Inode flag: Encrypted by the filesystem (<code>E</code>), read-only.
+   */
+  public static final int FLAG_ENCRYPTED = 0x800;
+
+  /**
+   * Inode flag: Data journaling (<code>j</code>).
+   */
+  public static final int FLAG_JOURNAL_DATA = 0x4000;
+
+  /**
+   * Inode flag: No tail-merging (<code>t</code>).
+   */
+  public static final int FLAG_NO_TAIL_MERGE = 0x8000;
+
+  /**
+   * Inode flag: Synchronous directory updates (<code>D</code>).
+   */
+  public static final int FLAG_DIRSYNC = 0x10000;
+
+  /**
+   * Inode flag: Top of directory hierarchies (<code>T</code>).
+   */
+  public static final int FLAG_TOP_DIR = 0x20000;
+
+  /**
+   * Inode flag: Uses extents (<code>e</code>), read-only.
+   */
+  public static final int FLAG_EXTENTS = 0x80000;
+
+  /**
+   * Inode flag: Protected by fs-verity (<code>V</code>), read-only.
+   */
+  public static final int FLAG_VERITY = 0x100000;
+
+  /**
+   * Inode flag: No copy on write (<code>C</code>).
+   */
+  public static final int FLAG_NO_COW = 0x800000;
+
+  /**
+   * Inode flag: Direct access (<code>x</code>), read-only.
+   */
+  public static final int FLAG_DAX = 0x2000000;
+
+  /**
+   * Inode flag: Data stored inline in the inode (<code>N</code>), read-only.
+   */
+  public static final int FLAG_INLINE_DATA = 0x10000000;
+
+  /**
+   * Inode flag: Project ID inherited by new files (<code>P</code>).
+   */
+  public static final int FLAG_PROJECT_INHERIT = 0x20000000;
+
+  /**
+   * Inode flag: Case-insensitive directory (<code>F</code>), read-only.
+   */
+  public static final int FLAG_CASEFOLD = 0x40000000;
+
+  /**
+   * The system property that provides the full path to <code>libaocode.so</code>, skipping all other lookups.
+   */
+  public static final String LIBRARY_PROPERTY = PosixFile.class.getName() + ".library";
+
+  /**
+   * The system property that overrides the directory where the embedded library is extracted.
+   * Defaults to <code>ao-io-posix</code> in <code>$XDG_CACHE_HOME</code> or <code>~/.cache</code>.
+   */
+  public static final String CACHE_DIRECTORY_PROPERTY = PosixFile.class.getName() + ".cacheDirectory";
+
   private static final Object libraryLock = new Object();
   private static volatile boolean loaded;
 
   /**
    * Loads the shared library native code <code>libaocode.so</code>.
+   * <ol>
+   * <li>When the {@link #LIBRARY_PROPERTY} system property is set, the library is loaded from that path.</li>
+   * <li>Otherwise, when the library is embedded as the resource <code>linux-<i>os.arch</i>/libaocode.so</code>,
+   *     it is extracted once into a content-addressed cache directory and loaded from there.</li>
+   * <li>Finally, falls back to searching <code>java.library.path</code>.</li>
+   * </ol>
+   * <p>
+   * All native methods are registered when the library is loaded.
+   * </p>
    */
   public static void loadLibrary() {
     if (!loaded) {
       synchronized (libraryLock) {
         if (!loaded) {
-          System.loadLibrary("aocode");
+          String library = System.getProperty(LIBRARY_PROPERTY);
+          if (library == null || library.isEmpty()) {
+            library = extractLibrary();
+          }
+          if (library != null) {
+            System.load(library);
+          } else {
+            System.loadLibrary("aocode");
+          }
           loaded = true;
         }
       }
     }
   }
 
+  /**
+   * Extracts the embedded library into the cache directory, named by its SHA-256 so that each version is only
+   * written once.  The directory must be owned by this user with mode 0700.
+   * <p>
+   * The SHA-256 and size of the library are embedded beside it by <code>compile.sh</code>, so that finding the
+   * library already extracted reads neither the library nor the cached copy.
+   * </p>
+   *
+   * @return  the path to the extracted library or {@code null} when not embedded or unable to extract
+   */
+  private static String extractLibrary() {
+    String resource = "linux-" + System.getProperty("os.arch") + "/libaocode.so";
+    try {
+      byte[] bytes = null;
+      byte[] digest;
+      long size;
+      String id = readLibraryId(resource + ".sha256");
+      if (id != null) {
+        int space = id.indexOf(' ');
+        digest = parseHex(id.substring(0, space));
+        size = Long.parseLong(id.substring(space + 1));
+      } else {
+        // Built without the embedded digest
+        bytes = readLibrary(resource);
+        if (bytes == null) {
+          return null;
+        }
+        digest = MessageDigest.getInstance("SHA-256").digest(bytes);
+        size = bytes.length;
+      }
+      StringBuilder name = new StringBuilder("libaocode-");
+      for (byte b : digest) {
+        name.append(Character.forDigit((b >>> 4) & 0xf, 16)).append(Character.forDigit(b & 0xf, 16));
+      }
+      name.append(".so");
+      Path dir = getCacheDirectory();
+      Files.createDirectories(dir, PosixFilePermissions.asFileAttribute(PosixFilePermissions.fromString("rwx------")));
+      // Only this user may replace the library between it being verified and loaded
+      int uid = (Integer) Files.getAttribute(Paths.get("/proc/self"), "unix:uid");
+      if (
+          !Files.isDirectory(dir, LinkOption.NOFOLLOW_LINKS)
+              || (Integer) Files.getAttribute(dir, "unix:uid", LinkOption.NOFOLLOW_LINKS) != uid
+              || ((Integer) Files.getAttribute(dir, "unix:mode", LinkOption.NOFOLLOW_LINKS) & 077) != 0
+      ) {
+        throw new IOException("Cache directory must be owned by this user with mode 0700: " + dir);
+      }
+      Path file = dir.resolve(name.toString());
+      FileTime stamp = getExtractedTime(digest);
+      if (!isExtracted(file, size, digest, stamp, uid)) {
+        if (bytes == null) {
+          bytes = readLibrary(resource);
+          if (bytes == null || bytes.length != size || !MessageDigest.isEqual(digest, MessageDigest.getInstance("SHA-256").digest(bytes))) {
+            throw new IOException("Embedded library does not match its SHA-256: " + resource);
+          }
+        }
+        Path temp = Files.createTempFile(dir, "libaocode-", ".tmp");
+        try {
+          Files.write(temp, bytes);
+          Files.setLastModifiedTime(temp, stamp);
+          Files.move(temp, file, StandardCopyOption.REPLACE_EXISTING, StandardCopyOption.ATOMIC_MOVE);
+        } finally {
+          Files.deleteIfExists(temp);
+        }
+      }
+      return file.toString();
+    } catch (IOException | GeneralSecurityException | UnsupportedOperationException | IllegalArgumentException | IndexOutOfBoundsException e) {
+      logger.log(Level.WARNING, "Unable to extract " + resource + ", falling back to java.library.path", e);
+      return null;
+    }
+  }
+
+  /**
+   * Reads the embedded library, or {@code null} when not embedded.
+   */
+  private static byte[] readLibrary(String resource) throws IOException {
+    try (InputStream in = PosixFile.class.getResourceAsStream(resource)) {
+      if (in == null) {
+        return null;
+      }
+      ByteArrayOutputStream bout = new ByteArrayOutputStream();
+      IoUtils.copy(in, bout);
+      return bout.toByteArray();
+    }
+  }
+
+  /**
+   * Reads the SHA-256 in hexadecimal and the size of the embedded library, separated by a space, or {@code null}
+   * when not embedded.
+   */
+  private static String readLibraryId(String resource) throws IOException {
+    try (InputStream in = PosixFile.class.getResourceAsStream(resource)) {
+      if (in == null) {
+        return null;
+      }
+      ByteArrayOutputStream bout = new ByteArrayOutputStream();
+      IoUtils.copy(in, bout);
+      return new String(bout.toByteArray(), StandardCharsets.US_ASCII).trim();
+    }
+  }
+
+  private static byte[] parseHex(String hex) {
+    if (hex.length() != 64) {
+      throw new IllegalArgumentException("Invalid SHA-256: " + hex);
+    }
+    byte[] bytes = new byte[hex.length() / 2];
+    for (int i = 0; i < bytes.length; i++) {
+      bytes[i] = (byte) Integer.parseInt(hex.substring(i * 2, i * 2 + 2), 16);
+    }
+    return bytes;
+  }
+
+  /**
+   * Gets the modification time given to an extracted library, derived from its SHA-256.  Any write to the file
+   * moves its modification time to the present, so a cached copy still having this time has not been written since
+   * it was extracted.
+   */
+  static FileTime getExtractedTime(byte[] digest) {
+    long seconds = ((digest[0] & 0x7fL) << 24) | ((digest[1] & 0xffL) << 16) | ((digest[2] & 0xffL) << 8) | (digest[3] & 0xffL);
+    return FileTime.from(seconds, TimeUnit.SECONDS);
+  }
+
+  /**
+   * Checks whether a previously extracted library is intact: a regular file owned by this user, not writable by
+   * others, of the expected size.  Its SHA-256 is only verified when its modification time is not the one it was
+   * extracted with, such as after being copied, and then the time is restored so later checks are fast.
+   */
+  static boolean isExtracted(Path file, long size, byte[] digest, FileTime stamp, int uid) throws IOException, GeneralSecurityException {
+    if (
+        !Files.isRegularFile(file, LinkOption.NOFOLLOW_LINKS)
+            || Files.size(file) != size
+            || (Integer) Files.getAttribute(file, "unix:uid", LinkOption.NOFOLLOW_LINKS) != uid
+            || ((Integer) Files.getAttribute(file, "unix:mode", LinkOption.NOFOLLOW_LINKS) & 022) != 0
+    ) {
+      return false;
+    }
+    if (Files.getLastModifiedTime(file, LinkOption.NOFOLLOW_LINKS).to(TimeUnit.SECONDS) == stamp.to(TimeUnit.SECONDS)) {
+      return true;
+    }
+    if (!MessageDigest.isEqual(digest, MessageDigest.getInstance("SHA-256").digest(Files.readAllBytes(file)))) {
+      return false;
+    }
+    Files.setLastModifiedTime(file, stamp);
+    return true;
+  }
+
+  private static Path getCacheDirectory() {
+    String dir = System.getProperty(CACHE_DIRECTORY_PROPERTY);
+    if (dir != null && !dir.isEmpty()) {
+      return Paths.get(dir);
+    }
+    String cacheHome = System.getenv("XDG_CACHE_HOME");
+    Path base;
+    if (cacheHome != null && !cacheHome.isEmpty()) {
+      base = Paths.get(cacheHome);
+    } else {
+      base = Paths.get(System.getProperty("user.home"), ".cache");
+    }
+    return base.resolve("ao-io-posix");
+  }
+
   /**
    * The path.
    */
@@ -363,9 +666,158 @@ public class PosixFile {
 
   private native Stat getStat0(String path) throws IOException;
 
+  /**
+   * Stats the file, waiting at most the given time, such as when the file may be on a hung network mount.
+   * <p>
+   * This method will follow symbolic links in the path but not a final symbolic link.
+   * </p>
+   *
+   * @throws  TimeoutException  when the stat did not finish in time, or the mount of this file is unhealthy
+   *
+   * @see  SupervisedPool
+   */
+  public Stat getStat(long timeout, TimeUnit unit) throws IOException, TimeoutException {
+    return SupervisedPool.getInstance().call(timeout, unit, this::getStat, this);
+  }
+
+  /**
+   * Gets the inode flags of this file, similar to the output of the Linux <code>lsattr</code> command.
+   * Only regular files and directories have inode flags.
+   * <p>
+   * This method will follow symbolic links in the path but not a final symbolic link.
+   * </p>
+   *
+   * @see  #FLAG_IMMUTABLE
+   * @see  #FLAG_APPEND_ONLY
+   * @see  #FLAG_NO_DUMP
+   */
+  public final int getFlags() throws IOException {
+    checkRead();
+    loadLibrary();
+    return getFlags0(path);
+  }
+
+  private static native int getFlags0(String path) throws IOException;
+
+  /**
+   * Adds and removes inode flags, similar to the Linux <code>chattr</code> command.
+   * Flags that are read-only are ignored.
+   * <p>
+   * This method will follow symbolic links in the path but not a final symbolic link.
+   * </p>
+   *
+   * @param  addFlags     the flags to add
+   * @param  removeFlags  the flags to remove, which take precedence over <code>addFlags</code>
+   *
+   * @see  #chattr(int, int, boolean, com.aoapps.io.posix.WalkOption...)
+   */
+  public final PosixFile chattr(int addFlags, int removeFlags) throws IOException {
+    return chattr(addFlags, removeFlags, false);
+  }
+
+  /**
+   * Adds and removes inode flags, similar to the Linux <code>chattr</code> command.
+   * Flags that are read-only are ignored.
+   * <p>
+   * When recursive, all regular files and directories below this directory are updated in a single native call.
+   * Symbolic links are not followed and other types of files are skipped.
+   * </p>
+   * <p>
+   * This method will follow symbolic links in the path but not a final symbolic link.
+   * </p>
+   *
+   * @param  addFlags     the flags to add
+   * @param  removeFlags  the flags to remove, which take precedence over <code>addFlags</code>
+   * @param  options      the options for the recursive walk
+   */
+  public final PosixFile chattr(int addFlags, int removeFlags, boolean recursive, WalkOption... options) throws IOException {
+    checkWrite();
+    loadLibrary();
+    chattr0(path, addFlags, removeFlags, recursive, null, WalkOption.toFlags(options));
+    return this;
+  }
+
+  /**
+   * Recursively adds and removes inode flags as {@link #chattr(int, int, boolean, com.aoapps.io.posix.WalkOption...)},
+   * recording progress in a checkpoint file.
+   * <p>
+   * The traversal position is written to <code>checkpoint</code> about once a second and when the walk fails.  When
+   * <code>checkpoint</code> already exists, the walk resumes from it and the subtrees already finished are skipped
+   * without being read again.  The checkpoint must be from this same operation, with the same flags, on this same
+   * directory, otherwise an {@link IOException} is thrown.  The checkpoint is removed once the walk completes.
+   * </p>
+   *
+   * @param  addFlags     the flags to add
+   * @param  removeFlags  the flags to remove, which take precedence over <code>addFlags</code>
+   * @param  checkpoint   the checkpoint to resume from and update
+   * @param  options      the options for the recursive walk
+   */
+  public final PosixFile chattr(int addFlags, int removeFlags, File checkpoint, WalkOption... options) throws IOException {
+    checkWrite();
+    String checkpointPath = checkpoint.getPath();
+    checkWrite(checkpointPath);
+    loadLibrary();
+    chattr0(path, addFlags, removeFlags, true, checkpointPath, WalkOption.toFlags(options));
+    return this;
+  }
+
+  private static native void chattr0(String path, int addFlags, int removeFlags, boolean recursive, String checkpoint, int flags) throws IOException;
+
+  /**
+   * Gets a persistent handle to this file that may later be reopened with {@link #openByHandle(com.aoapps.io.posix.FileHandle)},
+   * even after this file or its parents have been renamed.
+   * <p>
+   * This method will follow symbolic links in the path but not a final symbolic link.
+   * </p>
+   *
+   * @throws  IOException  when the filesystem does not support file handles
+   */
+  public final FileHandle getFileHandle() throws IOException {
+    checkRead();
+    loadLibrary();
+    return new FileHandle(getFileHandle0(path));
+  }
+
+  private static native byte[] getFileHandle0(String path) throws IOException;
+
+  /**
+   * Opens a file for reading by its persistent handle in a single call, without any path resolution.
+   * <p>
+   * This requires the <code>CAP_DAC_READ_SEARCH</code> capability.
+   * The mount points are opened once and reused for subsequent calls.
+   * </p>
+   *
+   * @throws  FileNotFoundException  when the file no longer exists
+   *
+   * @see  #getFileHandle()
+   */
+  public static FileInputStream openByHandle(FileHandle handle) throws IOException {
+    loadLibrary();
+    FileDescriptor fd = openByHandle0(handle.getEncoded(), O_RDONLY);
+    FileInputStream in = new FileInputStream(fd);
+    SecurityManager security = System.getSecurityManager();
+    if (security != null) {
+      try {
+        security.checkRead(fd);
+      } catch (SecurityException e) {
+        in.close();
+        throw e;
+      }
+    }
+    return in;
+  }
+
+  private static final int O_RDONLY = 0;
+
+  private static native FileDescriptor openByHandle0(byte[] handle, int flags) throws IOException;
+
   /**
    * Compares this contents of this file to the contents of another file.
    * <p>
+   * Data is only read where the files may differ: two paths to the same inode are equal, as are ranges that are
+   * holes in both files or that both files share on disk, such as reflinked copies.
+   * </p>
+   * <p>
    * This method will follow both path symbolic links and a final symbolic link.
    * </p>
    */
@@ -382,26 +834,12 @@ public class PosixFile {
     if (size != otherStat.getSize()) {
       return false;
     }
-    int buffSize = size < BufferManager.BUFFER_SIZE ? (int) size : BufferManager.BUFFER_SIZE;
-    if (buffSize < 64) {
-      buffSize = 64;
-    }
-    try (
-        InputStream in1 = new BufferedInputStream(new FileInputStream(getFile()), buffSize);
-        InputStream in2 = new BufferedInputStream(new FileInputStream(otherFile.getFile()), buffSize)
-        ) {
-      while (true) {
-        int b1 = in1.read();
-        int b2 = in2.read();
-        if (b1 != b2) {
-          return false;
-        }
-        if (b1 == -1) {
-          break;
-        }
-      }
+    // Two paths to the same inode
+    if (stat.getDevice() == otherStat.getDevice() && stat.getInode() == otherStat.getInode()) {
+      return true;
     }
-    return true;
+    // Compared natively, reading only the ranges not provably equal from their extents
+    return contentEquals0(new String[]{path}, new String[]{otherFile.path})[0];
   }
 
   /**
@@ -551,6 +989,247 @@ public class PosixFile {
     }
   }
 
+  /**
+   * Copies one filesystem object to another, as {@link #copyTo(com.aoapps.io.posix.PosixFile, boolean)}, waiting at
+   * most the given time.  A copy that times out continues in the background until the storage responds, and may
+   * leave a partial copy.
+   *
+   * @throws  TimeoutException  when the copy did not finish in time, or the mount of either file is unhealthy
+   *
+   * @see  SupervisedPool
+   */
+  public void copyTo(PosixFile otherFile, boolean overwrite, long timeout, TimeUnit unit) throws IOException, TimeoutException {
+    SupervisedPool.getInstance().call(
+        timeout,
+        unit,
+        () -> {
+          copyTo(otherFile, overwrite);
+          return null;
+        },
+        this,
+        otherFile
+    );
+  }
+
+  private static String[] toPaths(List<? extends PosixFile> files, boolean write) throws IOException {
+    int size = files.size();
+    String[] paths = new String[size];
+    for (int i = 0; i < size; i++) {
+      PosixFile file = files.get(i);
+      if (write) {
+        file.checkWrite();
+      } else {
+        file.checkRead();
+      }
+      paths[i] = file.path;
+    }
+    return paths;
+  }
+
+  /**
+   * Copies many regular files at once, including their permissions and ownership, on a native worker pool.
+   * <p>
+   * The pool has workers for each NUMA node, pinned to that node's CPUs and each with an I/O buffer allocated on
+   * its node.  Each copy is preferably run on the node closest to the block device of its source file.
+   * </p>
+   * <p>
+   * This method will follow symbolic links in the path but not a final symbolic link.
+   * </p>
+   *
+   * @param  from       the regular files to copy
+   * @param  to         the destinations, in the same order
+   * @param  overwrite  when {@code false}, fails when any destination already exists
+   *
+   * @throws  IOException  when any copy fails, in which case the copies not yet started are skipped
+   *
+   * @see  #copyTo(com.aoapps.io.posix.PosixFile, boolean)
+   * @see  #copyFiles(java.util.List, java.util.List, boolean, long)
+   */
+  public static void copyFiles(List<? extends PosixFile> from, List<? extends PosixFile> to, boolean overwrite) throws IOException {
+    copyFiles(from, to, overwrite, 0);
+  }
+
+  /**
+   * Copies many regular files at once, like {@link #copyFiles(java.util.List, java.util.List, boolean)}, but writes
+   * each copy behind with at most {@code maxDirtyBytes} of its written data not yet on disk.
+   * <p>
+   * Each completed window of half of {@code maxDirtyBytes} is sent to writeback with {@code sync_file_range}, the
+   * window before it is waited on, and the written pages of that older window are dropped from the page cache.
+   * Large copies then write at a steady rate instead of filling the page cache until the kernel throttles them in
+   * long stalls, and they do not evict the cached data of other processes.  The pages of the sources are left cached,
+   * since other processes may have been reading them before the copy.  A later {@link FileDescriptor#sync()}
+   * or {@code fsync} only has the last window left to wait for.
+   * </p>
+   * <p>
+   * This is not a durability guarantee: the last window is only started, and file metadata is not flushed.
+   * </p>
+   *
+   * @param  maxDirtyBytes  the most bytes of each copy that may be dirty in the page cache, or {@code 0} to
+   *                        copy through the page cache as usual
+   */
+  public static void copyFiles(List<? extends PosixFile> from, List<? extends PosixFile> to, boolean overwrite, long maxDirtyBytes) throws IOException {
+    if (from.size() != to.size()) {
+      throw new IllegalArgumentException("from.size() != to.size(): " + from.size() + " != " + to.size());
+    }
+    if (maxDirtyBytes < 0) {
+      throw new IllegalArgumentException("maxDirtyBytes < 0: " + maxDirtyBytes);
+    }
+    String[] fromPaths = toPaths(from, false);
+    String[] toPaths = toPaths(to, true);
+    loadLibrary();
+    copyFiles0(fromPaths, toPaths, overwrite, maxDirtyBytes);
+  }
+
+  private static native void copyFiles0(String[] from, String[] to, boolean overwrite, long maxDirtyBytes) throws IOException;
+
+  /**
+   * Compares the contents of many pairs of regular files at once on a native worker pool.
+   * <p>
+   * The pool has workers for each NUMA node, pinned to that node's CPUs and each with an I/O buffer allocated on
+   * its node.  Each comparison is preferably run on the node closest to the block device of its first file.
+   * </p>
+   * <p>
+   * As {@link #contentEquals(com.aoapps.io.posix.PosixFile)}, only the ranges where each pair may differ are read.
+   * </p>
+   * <p>
+   * This method will follow both path symbolic links and a final symbolic link.
+   * </p>
+   *
+   * @return  whether the contents of each pair are equal, in the same order
+   *
+   * @see  #contentEquals(com.aoapps.io.posix.PosixFile)
+   */
+  public static boolean[] contentEquals(List<? extends PosixFile> files1, List<? extends PosixFile> files2) throws IOException {
+    if (files1.size() != files2.size()) {
+      throw new IllegalArgumentException("files1.size() != files2.size(): " + files1.size() + " != " + files2.size());
+    }
+    String[] paths1 = toPaths(files1, false);
+    String[] paths2 = toPaths(files2, false);
+    loadLibrary();
+    return contentEquals0(paths1, paths2);
+  }
+
+  private static native boolean[] contentEquals0(String[] paths1, String[] paths2) throws IOException;
+
+  /**
+   * Compares the contents of this file to the contents of another file, as {@link #contentEquals(com.aoapps.io.posix.PosixFile)},
+   * but splits the ranges where the files may differ into parts that are compared in parallel on the native
+   * worker pool with {@code pread}.  Stops at the first difference found in any part.
+   * <p>
+   * A single sequential stream reaches only a fraction of the bandwidth of fast storage, such as NVMe arrays, so
+   * this is much faster to verify large files there.  It may be slower on rotating disks, which must seek between
+   * the ranges.
+   * </p>
+   * <p>
+   * This method will follow both path symbolic links and a final symbolic link.
+   * </p>
+   */
+  public boolean contentEqualsParallel(PosixFile otherFile) throws IOException {
+    checkRead();
+    otherFile.checkRead();
+    loadLibrary();
+    return contentEqualsParallel0(path, otherFile.path);
+  }
+
+  private static native boolean contentEqualsParallel0(String path1, String path2) throws IOException;
+
+  /**
+   * Computes the 32-byte BLAKE3 hash of this regular file.  BLAKE3 is a tree hash, so the file is split into
+   * ranges that are hashed in parallel on the native worker pool with {@code pread}, then joined.
+   * <p>
+   * This method will follow both path symbolic links and a final symbolic link.
+   * </p>
+   */
+  public byte[] getBlake3Hash() throws IOException {
+    checkRead();
+    loadLibrary();
+    return getBlake3Hash0(path);
+  }
+
+  private static native byte[] getBlake3Hash0(String path) throws IOException;
+
+  /**
+   * Searches the contents of all regular files in this tree for many byte patterns at once, in a single native call.
+   * <p>
+   * The patterns are compiled into one Aho-Corasick automaton, so each byte read costs a single table lookup
+   * regardless of the number of patterns.  One native thread walks the tree while scanner threads read the files in
+   * large blocks and match them, so the search is bound by I/O instead of CPU.  Files are opened with
+   * <code>O_NOATIME</code> when permitted so a sweep does not change access times.
+   * </p>
+   * <p>
+   * Only regular files are read: empty files and files larger than <code>maxSize</code> are skipped by their stat
+   * before being opened.  Files removed or replaced during the search are skipped.  Files that cannot be opened or
+   * read are passed to {@link SearchHandler#failed(java.lang.String, java.io.IOException)} and the search continues.
+   * </p>
+   * <p>
+   * Hits are streamed to the handler on the calling thread while the search continues.  All hits of a file are
+   * delivered together, in order of their end offset, but files are delivered in the order their scans complete.
+   * When the handler throws an exception, the search is stopped and the exception is thrown from this method.
+   * </p>
+   * <p>
+   * This method will follow symbolic links in the path but will not follow any symbolic links below this file.
+   * </p>
+   *
+   * @param  patterns  the byte patterns to find, none of which may be empty, identified to the handler by index
+   * @param  maxSize   the largest file read, or {@code -1} for no limit
+   * @param  handler   receives each match
+   * @param  options   the options for the recursive walk
+   *
+   * @throws  IllegalArgumentException  when a pattern is empty, or the patterns together are too large to compile
+   */
+  public final void search(byte[][] patterns, long maxSize, SearchHandler handler, WalkOption... options) throws IOException {
+    for (int i = 0; i < patterns.length; i++) {
+      if (patterns[i].length == 0) {
+        throw new IllegalArgumentException("Empty pattern: " + i);
+      }
+    }
+    checkRead();
+    if (patterns.length > 0) {
+      loadLibrary();
+      search0(path, patterns, maxSize, handler, WalkOption.toFlags(options));
+    }
+  }
+
+  private static native void search0(String path, byte[][] patterns, long maxSize, SearchHandler handler, int flags) throws IOException;
+
+  /**
+   * Finds every symbolic link in this tree and classifies each as resolving within <code>root</code>, broken,
+   * looping, or escaping <code>root</code>, in a single native call.
+   * <p>
+   * Link chains are resolved in native code with one <code>lstat</code> per path component, remembering the outcome
+   * of every link by its device and inode, so each link is read and resolved only once however many chains pass
+   * through it.  A link is considered within the root when its fully resolved target is the root or below it.
+   * </p>
+   * <p>
+   * Links are streamed to the handler in batches on the calling thread while the walk continues.
+   * When the handler throws an exception, the analysis is stopped and the exception is thrown from this method.
+   * </p>
+   * <p>
+   * This method will follow symbolic links in the path but will not follow any symbolic links below this file.
+   * </p>
+   *
+   * @param  root     the directory links must not escape, often this file or a parent of it
+   * @param  handler  receives each batch of links
+   * @param  options  the options for the recursive walk
+   */
+  public final void analyzeSymlinks(PosixFile root, SymlinkHandler handler, WalkOption... options) throws IOException {
+    checkRead();
+    root.checkRead();
+    loadLibrary();
+    analyzeSymlinks0(path, root.path, handler, WalkOption.toFlags(options));
+  }
+
+  /**
+   * Analyzes the symbolic links in this tree, with this file as the root they must not escape.
+   *
+   * @see  #analyzeSymlinks(com.aoapps.io.posix.PosixFile, com.aoapps.io.posix.SymlinkHandler, com.aoapps.io.posix.WalkOption...)
+   */
+  public final void analyzeSymlinks(SymlinkHandler handler, WalkOption... options) throws IOException {
+    analyzeSymlinks(this, handler, options);
+  }
+
+  private static native void analyzeSymlinks0(String path, String root, SymlinkHandler handler, int flags) throws IOException;
+
   /**
    * The set of supported crypt algorithms.
    */
@@ -706,46 +1385,66 @@ public class PosixFile {
   }
 
   /**
-   * Deletes this file and if it is a directory, all files below it.
+   * Deletes this file and if it is a directory, all files below it.  Crosses mount points.
    * <p>
-   * Due to a race conditition, this method will follow symbolic links.  Please use
-   * <code>secureDeleteRecursive</code> instead.
+   * This method will follow symbolic links in the path but will not follow any symbolic links below this file.
+   * Please use <code>secureDeleteRecursive</code> to also avoid race conditions in the path.
    * </p>
    *
-   * @see  #deleteRecursive(com.aoapps.io.posix.PosixFile)
+   * @see  #deleteRecursive(com.aoapps.io.posix.WalkOption...)
    */
   public final void deleteRecursive() throws IOException {
-    deleteRecursive(this);
+    deleteRecursive(new WalkOption[0]);
   }
 
   /**
-   * See {@link #deleteRecursive()}.
+   * Deletes this file and if it is a directory, all files below it.  The entire tree is deleted in a single native
+   * call.  It is not an error for this file to not exist.
+   * <p>
+   * With {@link WalkOption#ONE_FILE_SYSTEM}, mount points are left in place and an {@link IOException} is thrown once
+   * everything else has been deleted.
+   * </p>
+   * <p>
+   * This method will follow symbolic links in the path but will not follow any symbolic links below this file.
+   * Please use <code>secureDeleteRecursive</code> to also avoid race conditions in the path.
+   * </p>
+   */
+  public final void deleteRecursive(WalkOption... options) throws IOException {
+    deleteRecursive(null, options);
+  }
+
+  /**
+   * Deletes this file and if it is a directory, all files below it, as {@link #deleteRecursive(com.aoapps.io.posix.WalkOption...)},
+   * recording progress in a checkpoint file.
+   * <p>
+   * The traversal position is written to <code>checkpoint</code> about once a second and when the delete fails.  When
+   * <code>checkpoint</code> already exists, the delete resumes from it and the directories already finished, such
+   * as those left holding mount points, are skipped without being read again.  The checkpoint must be from a delete
+   * with the same options on this same directory, otherwise an {@link IOException} is thrown.  The checkpoint is
+   * removed once the delete completes.
+   * </p>
+   *
+   * @param  checkpoint  the checkpoint to resume from and update, or {@code null} for none
    */
-  private static void deleteRecursive(PosixFile file) throws IOException {
+  public final void deleteRecursive(File checkpoint, WalkOption... options) throws IOException {
+    checkWrite();
+    String checkpointPath = checkpoint == null ? null : checkpoint.getPath();
+    if (checkpointPath != null) {
+      checkWrite(checkpointPath);
+    }
+    loadLibrary();
     try {
-      Stat stat = file.getStat();
-      // This next line matches directories specifically to avoid listing and recursing into symlink references
-      if (stat.isDirectory()) {
-        // TODO: Race condition between getStat and list(), how can we avoid this from pure Java???
-        String[] list = file.list();
-        if (list != null) {
-          int len = list.length;
-          for (int c = 0; c < len; c++) {
-            deleteRecursive(new PosixFile(file, list[c], false));
-          }
-        }
-      }
-      file.delete();
-    } catch (FileNotFoundException err) {
-      // OK if it was deleted while we're trying to deleteRecursive it
+      deleteRecursive0(path, checkpointPath, WalkOption.toFlags(options));
     } catch (IOException err) {
       if (logger.isLoggable(Level.FINER)) {
-        logger.finer("Error recursively delete: " + file.path);
+        logger.finer("Error recursively delete: " + path);
       }
       throw err;
     }
   }
 
+  private static native void deleteRecursive0(String path, String checkpoint, int flags) throws IOException;
+
   /**
    * TODO: Java 1.8: Can do this in a pure Java way
    */
@@ -819,6 +1518,7 @@ public class PosixFile {
   /**
    * Securely deletes this file entry and all files below it while not following symbolic links.  This method must be called with
    * root privileges to properly avoid race conditions.  If not running with root privileges, use <code>deleteRecursive</code> instead.
+   * Crosses mount points.
    * <p>
    * In order to avoid race conditions, all directories above this directory will have their permissions set
    * so that regular users cannot modify the directories.  After each parent directory has its permissions set
@@ -830,51 +1530,64 @@ public class PosixFile {
    * TODO: Java 1.8: Can do this in a pure Java way
    * </p>
    *
-   * @see  #secureDeleteRecursive(com.aoapps.io.posix.PosixFile)
+   * @see  #secureDeleteRecursive(int, int, com.aoapps.io.posix.WalkOption...)
    */
   public final void secureDeleteRecursive(int uidMin, int gidMin) throws IOException {
-    List<SecuredDirectory> parentsChanged = new ArrayList<>();
-    try {
-      secureParents(parentsChanged, uidMin, gidMin);
-      secureDeleteRecursive(this);
-    } finally {
-      restoreParents(parentsChanged);
-    }
+    secureDeleteRecursive(uidMin, gidMin, new WalkOption[0]);
+  }
+
+  /**
+   * Securely deletes this file entry and all files below it while not following symbolic links.  This method must be called with
+   * root privileges to properly avoid race conditions.  If not running with root privileges, use <code>deleteRecursive</code> instead.
+   * <p>
+   * The parents are secured as described in {@link #secureDeleteRecursive(int, int)}, then the entire tree is secured
+   * and deleted in a single native call.
+   * </p>
+   * <p>
+   * With {@link WalkOption#ONE_FILE_SYSTEM}, mount points are left in place and an {@link IOException} is thrown once
+   * everything else has been deleted.
+   * </p>
+   */
+  public final void secureDeleteRecursive(int uidMin, int gidMin, WalkOption... options) throws IOException {
+    secureDeleteRecursive(uidMin, gidMin, null, options);
   }
 
   /**
-   * See {@link #secureDeleteRecursive(int, int)}.
+   * Securely deletes this file entry and all files below it as {@link #secureDeleteRecursive(int, int, com.aoapps.io.posix.WalkOption...)},
+   * recording progress in a checkpoint file.
+   * <p>
+   * The traversal position is written to <code>checkpoint</code> about once a second and when the delete fails.  When
+   * <code>checkpoint</code> already exists, the delete resumes from it.  The directories on the path to the resumed
+   * position are secured again before their remaining contents are deleted.  The checkpoint must be from a secure
+   * delete with the same options on this same directory, otherwise an {@link IOException} is thrown.  The checkpoint
+   * is removed once the delete completes.
+   * </p>
+   *
+   * @param  checkpoint  the checkpoint to resume from and update, or {@code null} for none
    */
-  private static void secureDeleteRecursive(PosixFile file) throws IOException {
+  public final void secureDeleteRecursive(int uidMin, int gidMin, File checkpoint, WalkOption... options) throws IOException {
+    List<SecuredDirectory> parentsChanged = new ArrayList<>();
     try {
-      Stat stat = file.getStat();
-      long mode = stat.getRawMode();
-      // Race condition does not exist because the parents have been secured already
-      if (!isSymLink(mode) && isDirectory(mode)) {
-        // Secure the current directory before the recursive calls
-        if (stat.getUid() != ROOT_UID || stat.getGid() != ROOT_GID) {
-          file.chown(ROOT_UID, ROOT_GID);
-        }
-        if (stat.getMode() != 0700) {
-          file.setMode(0700);
-        }
-        String[] list = file.list();
-        if (list != null) {
-          int len = list.length;
-          for (int c = 0; c < len; c++) {
-            secureDeleteRecursive(new PosixFile(file, list[c]));
-          }
-        }
+      secureParents(parentsChanged, uidMin, gidMin);
+      checkWrite();
+      String checkpointPath = checkpoint == null ? null : checkpoint.getPath();
+      if (checkpointPath != null) {
+        checkWrite(checkpointPath);
       }
-      file.delete();
+      loadLibrary();
+      secureDeleteRecursive0(path, checkpointPath, WalkOption.toFlags(options));
     } catch (IOException err) {
       if (logger.isLoggable(Level.FINER)) {
-        logger.finer("Error recursively delete: " + file.path);
+        logger.finer("Error recursively delete: " + path);
       }
       throw err;
+    } finally {
+      restoreParents(parentsChanged);
     }
   }
 
+  private static native void secureDeleteRecursive0(String path, String checkpoint, int flags) throws IOException;
+
   /**
    * Determines if a file exists, a symbolic link with an invalid destination
    * is still considered to exist.
@@ -1200,10 +1913,15 @@ public class PosixFile {
         }
       }
 
-      // Create the new file with the correct owner and permissions
-      FileOutputStream out = new FileOutputStream(getFile());
-      chown(uid, gid).setMode(mode);
-      return out;
+      // Create the new file with the correct owner and permissions, changed on the open file without resolving the path again
+      int flags = PosixFileHandle.O_WRONLY | PosixFileHandle.O_CREAT | PosixFileHandle.O_TRUNC | PosixFileHandle.O_NOFOLLOW;
+      if (!overwrite) {
+        flags |= PosixFileHandle.O_EXCL;
+      }
+      try (PosixFileHandle handle = PosixFileHandle.open(this, flags, 0600)) {
+        handle.chown(uid, gid).chmod(mode);
+        return new FileOutputStream(handle.dup());
+      }
     } finally {
       restoreParents(parentsChanged);
     }
@@ -1233,6 +1951,255 @@ public class PosixFile {
     }
   }
 
+  private static void checkRange(long offset, long length) {
+    if (offset < 0) {
+      throw new IllegalArgumentException("offset < 0: " + offset);
+    }
+    if (length < -1) {
+      throw new IllegalArgumentException("length < -1: " + length);
+    }
+  }
+
+  /**
+   * Sends a range of this file to a socket, pipe, or other file descriptor without copying its bytes through the
+   * Java heap or user space.
+   * <p>
+   * The bytes are moved by the kernel with <code>sendfile</code>, falling back to <code>read</code> and
+   * <code>write</code> for destinations the kernel does not support.  A non-blocking destination is waited on when
+   * full.
+   * </p>
+   * <p>
+   * This method will follow symbolic links in the path but not a final symbolic link.
+   * </p>
+   *
+   * @param  out     the destination, which is left open
+   * @param  offset  the position in this file of the first byte sent
+   * @param  length  the number of bytes to send, or {@code -1} to send through the end of the file
+   *
+   * @return  the number of bytes sent, which is less than <code>length</code> when the file ends first
+   *
+   * @see  #secureTransferTo(java.io.FileDescriptor, long, long, int, int)
+   */
+  public final long transferTo(FileDescriptor out, long offset, long length) throws IOException {
+    checkRange(offset, length);
+    checkRead();
+    loadLibrary();
+    FileDescriptor in = openRegular0(path);
+    // The stream owns the descriptor and closes it
+    FileInputStream inStream = new FileInputStream(in);
+    try {
+      return transfer0(in, out, offset, length);
+    } finally {
+      inStream.close();
+    }
+  }
+
+  /**
+   * Securely sends a range of this file to a socket, pipe, or other file descriptor as
+   * {@link #transferTo(java.io.FileDescriptor, long, long)}, temporarily performing permission changes and ensuring
+   * that no symbolic links are anywhere in the path.
+   * <p>
+   * The file is opened race-free while the parents are secured, as in {@link #getSecureInputStream(int, int)},
+   * and the parents are restored before any bytes are sent.
+   * </p>
+   *
+   * @param  out     the destination, which is left open
+   * @param  offset  the position in this file of the first byte sent
+   * @param  length  the number of bytes to send, or {@code -1} to send through the end of the file
+   *
+   * @return  the number of bytes sent, which is less than <code>length</code> when the file ends first
+   */
+  public final long secureTransferTo(FileDescriptor out, long offset, long length, int uidMin, int gidMin) throws IOException {
+    checkRange(offset, length);
+    checkRead();
+    loadLibrary();
+    FileDescriptor in;
+    List<SecuredDirectory> parentsChanged = new ArrayList<>();
+    try {
+      secureParents(parentsChanged, uidMin, gidMin);
+      in = openRegular0(path);
+    } finally {
+      restoreParents(parentsChanged);
+    }
+    // The stream owns the descriptor and closes it
+    FileInputStream inStream = new FileInputStream(in);
+    try {
+      return transfer0(in, out, offset, length);
+    } finally {
+      inStream.close();
+    }
+  }
+
+  private static native FileDescriptor openRegular0(String path) throws IOException;
+
+  private static native long transfer0(FileDescriptor in, FileDescriptor out, long offset, long length) throws IOException;
+
+  /**
+   * Reads the entire contents of this regular file in a single native call: open, <code>fstat</code> to size the
+   * array, read, and close.  A file that grows while being read is read to its new end.
+   * <p>
+   * This method will follow symbolic links in the path but not a final symbolic link.
+   * </p>
+   *
+   * @throws  FileNotFoundException  when this file does not exist
+   * @throws  IOException  when not a regular file or too large for an array
+   *
+   * @see  #readAllBytesSecure(int, int)
+   * @see  #readAllBytes(java.util.List)
+   */
+  public final byte[] readAllBytes() throws IOException {
+    checkRead();
+    loadLibrary();
+    return readAllBytes0(path);
+  }
+
+  private static native byte[] readAllBytes0(String path) throws IOException;
+
+  /**
+   * Reads this regular file into a provided buffer in a single native call, avoiding an allocation per file.
+   * <p>
+   * This method will follow symbolic links in the path but not a final symbolic link.
+   * </p>
+   *
+   * @return  the number of bytes read, or the size of the file when larger than <code>len</code>, in which case
+   *          the buffer holds its first <code>len</code> bytes
+   *
+   * @throws  FileNotFoundException  when this file does not exist
+   * @throws  IOException  when not a regular file
+   */
+  public final long readAllBytes(byte[] buff, int off, int len) throws IOException {
+    if (off < 0 || len < 0 || len > buff.length - off) {
+      throw new IndexOutOfBoundsException("buff.length=" + buff.length + ", off=" + off + ", len=" + len);
+    }
+    checkRead();
+    loadLibrary();
+    return readAllBytesInto0(path, buff, off, len);
+  }
+
+  private static native long readAllBytesInto0(String path, byte[] buff, int off, int len) throws IOException;
+
+  /**
+   * Securely reads the entire contents of this regular file as {@link #readAllBytes()}, temporarily performing
+   * permission changes and ensuring that no symbolic links are anywhere in the path, as in
+   * {@link #getSecureInputStream(int, int)}.
+   */
+  public final byte[] readAllBytesSecure(int uidMin, int gidMin) throws IOException {
+    checkRead();
+    loadLibrary();
+    List<SecuredDirectory> parentsChanged = new ArrayList<>();
+    try {
+      secureParents(parentsChanged, uidMin, gidMin);
+      return readAllBytes0(path);
+    } finally {
+      restoreParents(parentsChanged);
+    }
+  }
+
+  /**
+   * Reads the entire contents of many regular files as {@link #readAllBytes()} in a single native call.
+   * <p>
+   * This method will follow symbolic links in the path but not a final symbolic link.
+   * </p>
+   *
+   * @return  the contents of each file, in the same order, or {@code null} for files that do not exist
+   *
+   * @throws  IOException  on the first file that cannot be read, other than not existing
+   */
+  public static byte[][] readAllBytes(List<? extends PosixFile> files) throws IOException {
+    String[] paths = toPaths(files, false);
+    loadLibrary();
+    return readAllBytesBatch0(paths);
+  }
+
+  private static native byte[][] readAllBytesBatch0(String[] paths) throws IOException;
+
+  /**
+   * Writes many small files in a single native call, spread across the native worker pool.
+   * Each file is written to a temporary file in the same directory, given its mode and ownership,
+   * and then renamed over any existing file, so readers see either the old or the new contents
+   * of each file, never a partial write.  The batch as a whole is not atomic: when one file fails,
+   * the files already written remain.
+   * <p>
+   * When {@code sync} is set, each file is flushed before its rename and each distinct parent directory
+   * is flushed once after all renames, so the batch is durable on return.
+   * </p>
+   * <p>
+   * The files are written concurrently, so the same path may not be given twice.  Paths are compared as given,
+   * so different paths to the same file, such as through a symbolic link, still race.
+   * </p>
+   *
+   * @throws  IllegalArgumentException  when the same path is given more than once
+   * @throws  IOException  for the write that failed first, with the writes not yet started skipped
+   */
+  public static void writeFiles(List<FileSpec> specs, boolean sync) throws IOException {
+    int size = specs.size();
+    String[] paths = new String[size];
+    byte[][] contents = new byte[size][];
+    long[] modes = new long[size];
+    int[] uids = new int[size];
+    int[] gids = new int[size];
+    Set<String> seen = new HashSet<>(size * 4 / 3 + 1);
+    for (int i = 0; i < size; i++) {
+      FileSpec spec = specs.get(i);
+      PosixFile file = spec.getFile();
+      if (!seen.add(file.path)) {
+        throw new IllegalArgumentException("Duplicate path: " + file.path);
+      }
+      file.checkWrite();
+      paths[i] = file.path;
+      contents[i] = spec.getContents();
+      modes[i] = spec.getMode();
+      uids[i] = spec.getUid();
+      gids[i] = spec.getGid();
+    }
+    loadLibrary();
+    writeFiles0(paths, contents, modes, uids, gids, sync);
+  }
+
+  private static native void writeFiles0(String[] paths, byte[][] contents, long[] modes, int[] uids, int[] gids, boolean sync) throws IOException;
+
+  /**
+   * Maps a range of this file into memory read-only, such as for a large index.
+   * The file is only open while being mapped.
+   * <p>
+   * This method will follow symbolic links in the path, including a final symbolic link.
+   * </p>
+   *
+   * @param  flags  any of {@link MappedRegion#MAP_POPULATE} and {@link MappedRegion#MAP_HUGETLB}
+   *
+   * @see  PosixFileHandle#map(long, long, int)
+   */
+  public final MappedRegion map(long position, long size, int flags) throws IOException {
+    try (PosixFileHandle handle = PosixFileHandle.open(this, PosixFileHandle.O_RDONLY, 0)) {
+      return handle.map(position, size, flags & ~MappedRegion.MAP_PRIVATE);
+    }
+  }
+
+  /**
+   * Counts how much of a range of this regular file is in the page cache, without reading it, such as to choose
+   * between mapping already cached data and streaming it from disk.  Uses the {@code cachestat} system call,
+   * falling back to {@code mmap} and {@code mincore} on older kernels.
+   * <p>
+   * This method will follow symbolic links in the path but not a final symbolic link.
+   * </p>
+   *
+   * @param  offset  the first byte of the range, rounded down to a page
+   * @param  length  the number of bytes in the range, or {@code 0} through the end of the file
+   */
+  public CacheResidency getCacheResidency(long offset, long length) throws IOException {
+    if (offset < 0) {
+      throw new IllegalArgumentException("offset < 0: " + offset);
+    }
+    if (length < 0) {
+      throw new IllegalArgumentException("length < 0: " + length);
+    }
+    checkRead();
+    loadLibrary();
+    return new CacheResidency(getCacheResidency0(path, offset, length));
+  }
+
+  private static native long[] getCacheResidency0(String path, long offset, long length) throws IOException;
+
   /**
    * Gets the parent of this file or <code>null</code> if it doesn't have a parent.
    * Not synchronized because multiple instantiation is acceptable.
@@ -0,0 +1,612 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import java.io.FileDescriptor;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.lang.ref.PhantomReference;
+import java.lang.ref.Reference;
+import java.lang.ref.ReferenceQueue;
+import java.nio.ByteBuffer;
+import java.nio.ReadOnlyBufferException;
+import java.nio.channels.ClosedChannelException;
+import java.nio.channels.FileChannel;
+import java.nio.file.Paths;
+import java.nio.file.StandardOpenOption;
+import java.util.Set;
+import java.util.concurrent.ConcurrentHashMap;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.logging.Level;
+import java.util.logging.Logger;
+
+/**
+ * An open file descriptor, on which metadata is read and changed with a single system call each,
+ * without resolving the path again.  This is both faster and free of the races of path-based calls
+ * made after opening a file.
+ * <p>
+ * A handle that becomes unreachable without being closed has its file descriptor closed by a daemon thread
+ * once the garbage collector finds it, or sooner when another handle is opened or closed.
+ * </p>
+ * <p>
+ * A handle may be used by multiple threads, but must not be closed while in use.
+ * </p>
+ *
+ * @see  #open(com.aoapps.io.posix.PosixFile, int, long)
+ *
+ * @author  AO Industries, Inc.
+ */
+public final class PosixFileHandle implements AutoCloseable {
+
+  private static final Logger logger = Logger.getLogger(PosixFileHandle.class.getName());
+
+  /**
+   * Open for reading only.
+   */
+  public static final int O_RDONLY = 00;
+
+  /**
+   * Open for writing only.
+   */
+  public static final int O_WRONLY = 01;
+
+  /**
+   * Open for reading and writing.
+   */
+  public static final int O_RDWR = 02;
+
+  /**
+   * Create the file when it does not exist.
+   */
+  public static final int O_CREAT = 0100;
+
+  /**
+   * With {@link #O_CREAT}, fail when the file already exists.
+   */
+  public static final int O_EXCL = 0200;
+
+  /**
+   * Truncate an existing regular file to zero length.
+   */
+  public static final int O_TRUNC = 01000;
+
+  /**
+   * Every write is to the end of the file.
+   */
+  public static final int O_APPEND = 02000;
+
+  /**
+   * Do not block opening a FIFO or waiting for a mandatory lock.  Reads and writes of regular files are unaffected.
+   */
+  public static final int O_NONBLOCK = 04000;
+
+  /**
+   * Every write waits for the data to be on disk.
+   */
+  public static final int O_DSYNC = 010000;
+
+  /**
+   * Fail unless a directory.
+   */
+  public static final int O_DIRECTORY = 0200000;
+
+  /**
+   * Fail when the final component of the path is a symbolic link.
+   */
+  public static final int O_NOFOLLOW = 0400000;
+
+  /**
+   * Do not update the access time on read, permitted for the owner of the file or a privileged process.
+   */
+  public static final int O_NOATIME = 01000000;
+
+  /**
+   * Every write waits for the data and metadata to be on disk.
+   */
+  public static final int O_SYNC = 04010000;
+
+  private static final int O_ACCMODE = 03;
+
+  /**
+   * A time for {@link #utimens(long, long)} that sets the current time.
+   */
+  public static final long UTIME_NOW = Long.MAX_VALUE;
+
+  /**
+   * A time for {@link #utimens(long, long)} that leaves the time unchanged.
+   */
+  public static final long UTIME_OMIT = Long.MIN_VALUE;
+
+  /**
+   * Per-call flag for {@link #read(long, java.nio.ByteBuffer[], int)} and {@link #write(long, java.nio.ByteBuffer[], int)}:
+   * Poll for completion on devices that support it, for low latency at the cost of CPU.
+   */
+  public static final int RWF_HIPRI = 0x1;
+
+  /**
+   * Per-call flag for {@link #write(long, java.nio.ByteBuffer[], int)}: The write waits for the data to be on disk,
+   * as {@link #O_DSYNC} for this call only.
+   */
+  public static final int RWF_DSYNC = 0x2;
+
+  /**
+   * Per-call flag for {@link #write(long, java.nio.ByteBuffer[], int)}: The write waits for the data and metadata to be
+   * on disk, as {@link #O_SYNC} for this call only.
+   */
+  public static final int RWF_SYNC = 0x4;
+
+  /**
+   * Per-call flag for {@link #read(long, java.nio.ByteBuffer[], int)}: Only read data already in the page cache,
+   * returning at once instead of waiting on the disk.
+   */
+  public static final int RWF_NOWAIT = 0x8;
+
+  /**
+   * Per-call flag for {@link #write(long, java.nio.ByteBuffer[], int)}: Append to the end of the file,
+   * as {@link #O_APPEND} for this call only.
+   */
+  public static final int RWF_APPEND = 0x10;
+
+  /**
+   * The most buffers in one vectored call.
+   */
+  private static final int IOV_MAX = 1024;
+
+  /**
+   * Closes the file descriptor exactly once, either explicitly or after the handle is unreachable.
+   */
+  private static final class Closer extends PhantomReference<PosixFileHandle> {
+
+    private final int fd;
+    private final AtomicBoolean closed = new AtomicBoolean();
+
+    private Closer(PosixFileHandle handle, int fd) {
+      super(handle, queue);
+      this.fd = fd;
+    }
+
+    private void close() throws IOException {
+      if (closed.compareAndSet(false, true)) {
+        closers.remove(this);
+        close0(fd);
+      }
+    }
+  }
+
+  private static final ReferenceQueue<PosixFileHandle> queue = new ReferenceQueue<>();
+
+  /**
+   * Keeps the closers reachable until their handles are.
+   */
+  private static final Set<Closer> closers = ConcurrentHashMap.newKeySet();
+
+  private static void close(Reference<? extends PosixFileHandle> ref) {
+    try {
+      ((Closer) ref).close();
+    } catch (IOException e) {
+      logger.log(Level.WARNING, null, e);
+    }
+  }
+
+  /**
+   * Closes the file descriptors of any handles that became unreachable without being closed.
+   */
+  private static void closeUnreachable() {
+    Reference<? extends PosixFileHandle> ref;
+    while ((ref = queue.poll()) != null) {
+      close(ref);
+    }
+  }
+
+  private static final AtomicBoolean drainerStarted = new AtomicBoolean();
+
+  /**
+   * Starts the daemon thread that closes the file descriptors of unreachable handles as they are found,
+   * so they are closed even when no more handles are opened.
+   */
+  private static void startDrainer() {
+    if (drainerStarted.compareAndSet(false, true)) {
+      Thread drainer = new Thread(() -> {
+        try {
+          while (true) {
+            close(queue.remove());
+          }
+        } catch (InterruptedException e) {
+          Thread.currentThread().interrupt();
+        }
+      }, PosixFileHandle.class.getName() + ".drainer");
+      drainer.setDaemon(true);
+      drainer.start();
+    }
+  }
+
+  /**
+   * Opens a file with the <code>open</code> flags of this class, the new file descriptor is close-on-exec.
+   * <p>
+   * This method will follow symbolic links in the path, including a final symbolic link unless {@link #O_NOFOLLOW}.
+   * </p>
+   *
+   * @param  mode  the permissions of a file created by {@link #O_CREAT}, before the umask
+   */
+  public static PosixFileHandle open(PosixFile file, int flags, long mode) throws IOException {
+    int access = flags & O_ACCMODE;
+    if (access != O_WRONLY) {
+      file.checkRead();
+    }
+    if (access != O_RDONLY || (flags & (O_CREAT | O_TRUNC | O_APPEND)) != 0) {
+      file.checkWrite();
+    }
+    PosixFile.loadLibrary();
+    startDrainer();
+    closeUnreachable();
+    return new PosixFileHandle(file, flags, open0(file.getPath(), flags, mode & PosixFile.PERMISSION_MASK));
+  }
+
+  private static native int open0(String path, int flags, long mode) throws IOException;
+
+  /**
+   * Opens an existing file for reading as {@link #open(com.aoapps.io.posix.PosixFile, int, long)}, but without
+   * following any symbolic link in the path.
+   *
+   * @throws  IOException  when any component of the path is a symbolic link
+   */
+  static PosixFileHandle openNoSymlinks(PosixFile file, int flags) throws IOException {
+    file.checkRead();
+    PosixFile.loadLibrary();
+    startDrainer();
+    closeUnreachable();
+    return new PosixFileHandle(file, flags, openNoSymlinks0(file.getPath(), flags));
+  }
+
+  private static native int openNoSymlinks0(String path, int flags) throws IOException;
+
+  private final PosixFile file;
+  private final int flags;
+  private final int fd;
+  private final Closer closer;
+
+  private PosixFileHandle(PosixFile file, int flags, int fd) {
+    this.file = file;
+    this.flags = flags;
+    this.fd = fd;
+    closer = new Closer(this, fd);
+    closers.add(closer);
+  }
+
+  /**
+   * Gets the file this handle was opened from, which may since have been renamed or removed.
+   */
+  public PosixFile getFile() {
+    return file;
+  }
+
+  /**
+   * Gets the flags this handle was opened with.
+   */
+  public int getFlags() {
+    return flags;
+  }
+
+  /**
+   * Gets the file descriptor.
+   * The natives below are instance methods so this handle remains reachable, and its file descriptor open,
+   * throughout each call.
+   *
+   * @throws  ClosedChannelException  when already closed
+   */
+  int getFd() throws ClosedChannelException {
+    if (closer.closed.get()) {
+      throw new ClosedChannelException();
+    }
+    return fd;
+  }
+
+  /**
+   * Gets the status of the open file.
+   */
+  public Stat stat() throws IOException {
+    return stat0(getFd());
+  }
+
+  private native Stat stat0(int fd) throws IOException;
+
+  /**
+   * Sets the permissions of the open file.
+   */
+  public PosixFileHandle chmod(long mode) throws IOException {
+    file.checkWrite();
+    chmod0(getFd(), mode & PosixFile.PERMISSION_MASK);
+    return this;
+  }
+
+  private native void chmod0(int fd, long mode) throws IOException;
+
+  /**
+   * Changes the owner and group of the open file, {@code -1} leaves either unchanged.
+   */
+  public PosixFileHandle chown(int uid, int gid) throws IOException {
+    file.checkWrite();
+    chown0(getFd(), uid, gid);
+    return this;
+  }
+
+  private native void chown0(int fd, int uid, int gid) throws IOException;
+
+  /**
+   * Sets the access and modify times of the open file.
+   *
+   * @param  atime  the access time in nanoseconds since the epoch, {@link #UTIME_NOW}, or {@link #UTIME_OMIT}
+   * @param  mtime  the modify time in nanoseconds since the epoch, {@link #UTIME_NOW}, or {@link #UTIME_OMIT}
+   */
+  public PosixFileHandle utimens(long atime, long mtime) throws IOException {
+    file.checkWrite();
+    utimens0(getFd(), atime, mtime);
+    return this;
+  }
+
+  private native void utimens0(int fd, long atime, long mtime) throws IOException;
+
+  /**
+   * Truncates or extends the open file to the given size.
+   */
+  public PosixFileHandle truncate(long size) throws IOException {
+    if (size < 0) {
+      throw new IllegalArgumentException("size < 0: " + size);
+    }
+    file.checkWrite();
+    truncate0(getFd(), size);
+    return this;
+  }
+
+  private native void truncate0(int fd, long size) throws IOException;
+
+  /**
+   * Allocates the disk space for a range of the open file so later writes within it cannot fail for lack of space.
+   * Filesystems without native preallocation are emulated by writing zeros, except when keeping the size.
+   *
+   * @param  keepSize  when {@code true}, space allocated past the end of the file does not change its size
+   */
+  public PosixFileHandle allocate(long offset, long length, boolean keepSize) throws IOException {
+    if (offset < 0) {
+      throw new IllegalArgumentException("offset < 0: " + offset);
+    }
+    if (length <= 0) {
+      throw new IllegalArgumentException("length <= 0: " + length);
+    }
+    file.checkWrite();
+    allocate0(getFd(), offset, length, keepSize);
+    return this;
+  }
+
+  private native void allocate0(int fd, long offset, long length, boolean keepSize) throws IOException;
+
+  /**
+   * Reads from a position in the open file without using or changing the file position, so any number of threads
+   * may read the same handle concurrently.
+   *
+   * @return  the number of bytes read, which may be less than <code>len</code>, or {@code -1} at the end of the file
+   */
+  public int read(long position, byte[] b, int off, int len) throws IOException {
+    if (position < 0) {
+      throw new IllegalArgumentException("position < 0: " + position);
+    }
+    if (off < 0 || len < 0 || len > b.length - off) {
+      throw new IndexOutOfBoundsException();
+    }
+    if (len == 0) {
+      return 0;
+    }
+    return read0(getFd(), position, b, off, len);
+  }
+
+  private native int read0(int fd, long position, byte[] b, int off, int len) throws IOException;
+
+  /**
+   * Gets the position and remaining bytes of each buffer, which must all be direct.
+   */
+  private static void checkBuffers(ByteBuffer[] buffers, boolean read, int[] positions, int[] lengths) {
+    for (int i = 0; i < buffers.length; i++) {
+      ByteBuffer buffer = buffers[i];
+      if (!buffer.isDirect()) {
+        throw new IllegalArgumentException("Not a direct buffer: " + i);
+      }
+      if (read && buffer.isReadOnly()) {
+        throw new ReadOnlyBufferException();
+      }
+      positions[i] = buffer.position();
+      lengths[i] = buffer.remaining();
+    }
+  }
+
+  /**
+   * Moves the buffers past the bytes transferred, in order.
+   */
+  private static void advance(ByteBuffer[] buffers, long count) {
+    for (int i = 0; count > 0 && i < buffers.length; i++) {
+      ByteBuffer buffer = buffers[i];
+      int n = (int) Math.min(count, buffer.remaining());
+      buffer.position(buffer.position() + n);
+      count -= n;
+    }
+  }
+
+  /**
+   * Reads into a sequence of direct buffers with a single <code>preadv2</code> call, filling each buffer in turn,
+   * with per-call flags.  The position of each buffer is advanced past the bytes read.
+   * <p>
+   * With {@link #RWF_NOWAIT}, only data already in the page cache is read, so an event loop may serve cached data
+   * inline and hand only the misses to a thread that may block.
+   * </p>
+   *
+   * @param  position  the position in the file, or {@code -1} to read at and advance the file position
+   * @param  flags     any of {@link #RWF_HIPRI} and {@link #RWF_NOWAIT}, or {@code 0} for a plain <code>preadv</code>
+   *
+   * @return  the number of bytes read, which may be less than requested, {@code -1} at the end of the file,
+   *          or {@code 0} when {@link #RWF_NOWAIT} and none of the data is cached
+   *
+   * @throws  IOException  when the kernel does not support the flags
+   */
+  public long read(long position, ByteBuffer[] buffers, int flags) throws IOException {
+    if (position < -1) {
+      throw new IllegalArgumentException("position < -1: " + position);
+    }
+    if (buffers.length > IOV_MAX) {
+      throw new IllegalArgumentException("buffers.length > " + IOV_MAX + ": " + buffers.length);
+    }
+    int[] positions = new int[buffers.length];
+    int[] lengths = new int[buffers.length];
+    checkBuffers(buffers, true, positions, lengths);
+    long count = readv0(getFd(), position, buffers, positions, lengths, flags);
+    advance(buffers, count);
+    return count;
+  }
+
+  private native long readv0(int fd, long position, ByteBuffer[] buffers, int[] positions, int[] lengths, int flags) throws IOException;
+
+  /**
+   * Writes a sequence of direct buffers with a single <code>pwritev2</code> call, with per-call flags.
+   * The position of each buffer is advanced past the bytes written.
+   *
+   * @param  position  the position in the file, or {@code -1} to write at and advance the file position
+   * @param  flags     any of {@link #RWF_HIPRI}, {@link #RWF_DSYNC}, {@link #RWF_SYNC}, and {@link #RWF_APPEND},
+   *                   or {@code 0} for a plain <code>pwritev</code>
+   *
+   * @return  the number of bytes written, which may be less than requested
+   *
+   * @throws  IOException  when the kernel does not support the flags
+   */
+  public long write(long position, ByteBuffer[] buffers, int flags) throws IOException {
+    if (position < -1) {
+      throw new IllegalArgumentException("position < -1: " + position);
+    }
+    if (buffers.length > IOV_MAX) {
+      throw new IllegalArgumentException("buffers.length > " + IOV_MAX + ": " + buffers.length);
+    }
+    file.checkWrite();
+    int[] positions = new int[buffers.length];
+    int[] lengths = new int[buffers.length];
+    checkBuffers(buffers, false, positions, lengths);
+    long count = writev0(getFd(), position, buffers, positions, lengths, flags);
+    advance(buffers, count);
+    return count;
+  }
+
+  private native long writev0(int fd, long position, ByteBuffer[] buffers, int[] positions, int[] lengths, int flags) throws IOException;
+
+  /**
+   * Flushes the open file to disk.
+   *
+   * @param  metaData  when {@code false}, metadata not needed to read the data back, such as the modify time,
+   *                   is not flushed
+   */
+  public PosixFileHandle sync(boolean metaData) throws IOException {
+    sync0(getFd(), metaData);
+    return this;
+  }
+
+  private native void sync0(int fd, boolean metaData) throws IOException;
+
+  /**
+   * Flushes the open file and all of its metadata to disk.
+   */
+  public PosixFileHandle sync() throws IOException {
+    return sync(true);
+  }
+
+  /**
+   * Maps a range of the open file into memory, which remains mapped after this handle is closed.
+   * The region is writable when this handle is open for reading and writing or the mapping is private.
+   *
+   * @param  position  the position in the file, need not be page aligned
+   * @param  size      the size of the region, which may exceed 2 GiB
+   * @param  flags     any of {@link MappedRegion#MAP_PRIVATE}, {@link MappedRegion#MAP_POPULATE},
+   *                   and {@link MappedRegion#MAP_HUGETLB}
+   */
+  public MappedRegion map(long position, long size, int flags) throws IOException {
+    if (position < 0) {
+      throw new IllegalArgumentException("position < 0: " + position);
+    }
+    if (size <= 0) {
+      throw new IllegalArgumentException("size <= 0: " + size);
+    }
+    boolean writable = (this.flags & O_ACCMODE) == O_RDWR || (flags & MappedRegion.MAP_PRIVATE) != 0;
+    // The mapping starts at the page containing the position
+    long delta = position % MappedRegion.getPageSize();
+    long base = map0(getFd(), position - delta, size + delta, writable, flags);
+    return new MappedRegion(base, size + delta, base + delta, size, writable);
+  }
+
+  private native long map0(int fd, long position, long size, boolean writable, int flags) throws IOException;
+
+  /**
+   * Gets a new channel to the open file, which must be closed separately from this handle.
+   * <p>
+   * A handle opened read-only or write-only gives a channel on a duplicate of its file descriptor,
+   * sharing the file position.  A read-write handle gives a channel that reopens the same file through
+   * <code>/proc/self/fd</code>, with its own position, even when the file has been renamed or removed.
+   * </p>
+   */
+  public FileChannel getChannel() throws IOException {
+    int access = flags & O_ACCMODE;
+    if (access == O_RDWR) {
+      if ((flags & O_APPEND) != 0) {
+        return FileChannel.open(Paths.get("/proc/self/fd", Integer.toString(getFd())), StandardOpenOption.READ, StandardOpenOption.APPEND);
+      } else {
+        return FileChannel.open(Paths.get("/proc/self/fd", Integer.toString(getFd())), StandardOpenOption.READ, StandardOpenOption.WRITE);
+      }
+    }
+    FileDescriptor dup = dup();
+    if (access == O_WRONLY) {
+      return new FileOutputStream(dup).getChannel();
+    } else {
+      return new FileInputStream(dup).getChannel();
+    }
+  }
+
+  /**
+   * Gets a new, close-on-exec duplicate of the file descriptor, sharing the file position.
+   */
+  FileDescriptor dup() throws IOException {
+    return dup0(getFd());
+  }
+
+  private native FileDescriptor dup0(int fd) throws IOException;
+
+  /**
+   * Closes the file descriptor, closing again has no effect.
+   */
+  @Override
+  public void close() throws IOException {
+    closer.close();
+    closeUnreachable();
+  }
+
+  private static native void close0(int fd) throws IOException;
+
+  @Override
+  public String toString() {
+    return file.toString();
+  }
+}
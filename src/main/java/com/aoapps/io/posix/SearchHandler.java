@@ -0,0 +1,62 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import java.io.IOException;
+
+/**
+ * Receives the matches found by {@link PosixFile#search(byte[][], long, com.aoapps.io.posix.SearchHandler, com.aoapps.io.posix.WalkOption...)}.
+ * <p>
+ * Called only on the thread that started the search.
+ * </p>
+ *
+ * @author  AO Industries, Inc.
+ */
+@FunctionalInterface
+public interface SearchHandler {
+
+  /**
+   * Called for each match.  Throwing an exception stops the search.
+   *
+   * @param  path     the path of the file, starting with the path of the directory searched
+   * @param  offset   the offset of the first byte of the match within the file
+   * @param  pattern  the index of the pattern matched
+   */
+  void hit(String path, long offset, int pattern) throws IOException;
+
+  /**
+   * Called for each file that could not be opened or read, such as for lack of permission.  Hits already delivered
+   * for the file remain.  The search continues with the other files, unless this throws an exception, which stops
+   * the search.
+   * <p>
+   * Does nothing by default, so files that cannot be read are skipped.
+   * </p>
+   *
+   * @param  path   the path of the file, starting with the path of the directory searched
+   * @param  cause  the failure, with a message starting with the path
+   */
+  default void failed(String path, IOException cause) throws IOException {
+    // Skip the file
+  }
+}
@@ -1,6 +1,6 @@
 /*
  * ao-io-posix - Java interface to native POSIX filesystem objects.
- * Copyright (C) 2006, 2007, 2008, 2009, 2010, 2011, 2015, 2016, 2021, 2022  AO Industries, Inc.
+ * Copyright (C) 2006, 2007, 2008, 2009, 2010, 2011, 2015, 2016, 2021, 2022, 2026  AO Industries, Inc.
  *     support@aoindustries.com
  *     7262 Bull Pen Cir
  *     Mobile, AL 36695
@@ -34,6 +34,51 @@ import java.io.FileNotFoundException;
  */
 public class Stat {
 
+  /**
+   * Attribute: The file is compressed by the filesystem.
+   */
+  public static final long ATTR_COMPRESSED = 0x4;
+
+  /**
+   * Attribute: The file is immutable.
+   */
+  public static final long ATTR_IMMUTABLE = 0x10;
+
+  /**
+   * Attribute: The file may only be opened for appending.
+   */
+  public static final long ATTR_APPEND_ONLY = 0x20;
+
+  /**
+   * Attribute: The file is excluded from backups.
+   */
+  public static final long ATTR_NO_DUMP = 0x40;
+
+  /**
+   * Attribute: The file is encrypted by the filesystem.
+   */
+  public static final long ATTR_ENCRYPTED = 0x800;
+
+  /**
+   * Attribute: The directory is an automount trigger.
+   */
+  public static final long ATTR_AUTOMOUNT = 0x1000;
+
+  /**
+   * Attribute: The directory is the root of a mount.
+   */
+  public static final long ATTR_MOUNT_ROOT = 0x2000;
+
+  /**
+   * Attribute: The file is protected by fs-verity.
+   */
+  public static final long ATTR_VERITY = 0x100000;
+
+  /**
+   * Attribute: The file is in the direct access (DAX) state.
+   */
+  public static final long ATTR_DAX = 0x200000;
+
   /**
    * A stat that represents a non-existent file.
    */
@@ -51,6 +96,8 @@ public class Stat {
       0,
       0,
       0,
+      0,
+      0,
       0
   );
 
@@ -68,9 +115,13 @@ public class Stat {
   private final long accessTime;
   private final long modifyTime;
   private final long changeTime;
+  private final long attributes;
+  private final long attributesMask;
 
   /**
-   * Creates a new stat given all the values.
+   * Creates a new stat given all the values, without any attributes.
+   *
+   * @see  #Stat(boolean, long, long, long, int, int, int, long, long, int, long, long, long, long, long, long)
    */
   public Stat(
       boolean exists,
@@ -87,6 +138,50 @@ public class Stat {
       long accessTime,
       long modifyTime,
       long changeTime
+  ) {
+    this(
+        exists,
+        device,
+        inode,
+        mode,
+        numberLinks,
+        uid,
+        gid,
+        deviceIdentifier,
+        size,
+        blockSize,
+        blockCount,
+        accessTime,
+        modifyTime,
+        changeTime,
+        0,
+        0
+    );
+  }
+
+  /**
+   * Creates a new stat given all the values.
+   *
+   * @param  attributes      the <code>STATX_ATTR_*</code> attributes of the file
+   * @param  attributesMask  the attributes supported by the filesystem
+   */
+  public Stat(
+      boolean exists,
+      long device,
+      long inode,
+      long mode,
+      int numberLinks,
+      int uid,
+      int gid,
+      long deviceIdentifier,
+      long size,
+      int blockSize,
+      long blockCount,
+      long accessTime,
+      long modifyTime,
+      long changeTime,
+      long attributes,
+      long attributesMask
   ) {
     this.exists = exists;
     this.device = device;
@@ -102,6 +197,8 @@ public class Stat {
     this.accessTime = accessTime;
     this.modifyTime = modifyTime;
     this.changeTime = changeTime;
+    this.attributes = attributes;
+    this.attributesMask = attributesMask;
   }
 
   /**
@@ -332,4 +429,118 @@ public class Stat {
     }
     return PosixFile.isSymLink(mode);
   }
+
+  /**
+   * Gets the <code>STATX_ATTR_*</code> attributes of this file.  These are zero when the kernel does not support
+   * <code>statx</code>.
+   *
+   * @see  #getAttributesMask()
+   */
+  public long getAttributes() throws FileNotFoundException {
+    if (!exists) {
+      throw new FileNotFoundException();
+    }
+    return attributes;
+  }
+
+  /**
+   * Gets the attributes that are supported by the filesystem containing this file.  An attribute that is not in the
+   * mask is not known to be set or unset.
+   */
+  public long getAttributesMask() throws FileNotFoundException {
+    if (!exists) {
+      throw new FileNotFoundException();
+    }
+    return attributesMask;
+  }
+
+  /**
+   * Determines if this file is compressed by the filesystem.
+   */
+  public boolean isCompressed() throws FileNotFoundException {
+    if (!exists) {
+      throw new FileNotFoundException();
+    }
+    return (attributes & ATTR_COMPRESSED) != 0;
+  }
+
+  /**
+   * Determines if this file is immutable.
+   */
+  public boolean isImmutable() throws FileNotFoundException {
+    if (!exists) {
+      throw new FileNotFoundException();
+    }
+    return (attributes & ATTR_IMMUTABLE) != 0;
+  }
+
+  /**
+   * Determines if this file may only be opened for appending.
+   */
+  public boolean isAppendOnly() throws FileNotFoundException {
+    if (!exists) {
+      throw new FileNotFoundException();
+    }
+    return (attributes & ATTR_APPEND_ONLY) != 0;
+  }
+
+  /**
+   * Determines if this file is excluded from backups.
+   */
+  public boolean isNoDump() throws FileNotFoundException {
+    if (!exists) {
+      throw new FileNotFoundException();
+    }
+    return (attributes & ATTR_NO_DUMP) != 0;
+  }
+
+  /**
+   * Determines if this file is encrypted by the filesystem.
+   */
+  public boolean isEncrypted() throws FileNotFoundException {
+    if (!exists) {
+      throw new FileNotFoundException();
+    }
+    return (attributes & ATTR_ENCRYPTED) != 0;
+  }
+
+  /**
+   * Determines if this directory is an automount trigger.
+   */
+  public boolean isAutomount() throws FileNotFoundException {
+    if (!exists) {
+      throw new FileNotFoundException();
+    }
+    return (attributes & ATTR_AUTOMOUNT) != 0;
+  }
+
+  /**
+   * Determines if this directory is the root of a mount.
+   */
+  public boolean isMountRoot() throws FileNotFoundException {
+    if (!exists) {
+      throw new FileNotFoundException();
+    }
+    return (attributes & ATTR_MOUNT_ROOT) != 0;
+  }
+
+  /**
+   * Determines if this file is protected by fs-verity.
+   */
+  public boolean isVerity() throws FileNotFoundException {
+    if (!exists) {
+      throw new FileNotFoundException();
+    }
+    return (attributes & ATTR_VERITY) != 0;
+  }
+
+  /**
+   * Determines if this file is in the direct access (DAX) state.
+   */
+  public boolean isDax() throws FileNotFoundException {
+    if (!exists) {
+      throw new FileNotFoundException();
+    }
+    return (attributes & ATTR_DAX) != 0;
+  }
 }
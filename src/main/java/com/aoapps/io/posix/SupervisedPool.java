@@ -0,0 +1,642 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+package com.aoapps.io.posix;
+
+import java.io.File;
+import java.io.IOException;
+import java.io.InterruptedIOException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.HashSet;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Set;
+import java.util.concurrent.Callable;
+import java.util.concurrent.ExecutionException;
+import java.util.concurrent.Future;
+import java.util.concurrent.SynchronousQueue;
+import java.util.concurrent.ThreadPoolExecutor;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.TimeoutException;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.function.LongSupplier;
+import java.util.logging.Level;
+import java.util.logging.Logger;
+
+/**
+ * Runs filesystem operations with a deadline on a pool of helper threads, so a hung mount, such as an unresponsive
+ * NFS server, cannot block the calling thread forever.
+ * <p>
+ * A thread blocked in the kernel on a hung mount cannot be interrupted or killed.  When an operation times out, the
+ * caller gets a {@link TimeoutException} while its helper is quarantined: it is left to finish on its own, renamed
+ * to show the mount it is stuck on, and no longer counted as available.  A new helper is started for the next
+ * operation.
+ * </p>
+ * <p>
+ * Each mount has a circuit breaker.  A timeout opens the breaker of every mount the operation used, and operations on
+ * an open mount fail immediately with a {@link TimeoutException} instead of tying up another helper.  After a cool
+ * down, which doubles with each consecutive timeout, a single operation is let through as a probe; its success
+ * closes the breaker.  Only operations started after the breaker last opened can close it, so a slow operation from
+ * before the failure that finally returns does not.  The breaker also stays open while the mount has too many helpers
+ * still quarantined.
+ * </p>
+ * <p>
+ * The mount of each file is the longest mount point in <code>/proc/self/mountinfo</code> containing its real path,
+ * with all symbolic links resolved, or the real path of its nearest existing parent.  Since resolving could itself
+ * hang, it is done on the helper as part of the operation and remembered for {@link #MOUNT_REFRESH_INTERVAL}.
+ * When resolving times out, the breaker of the mount containing the path as given is opened instead.
+ * </p>
+ *
+ * @author  AO Industries, Inc.
+ */
+public final class SupervisedPool {
+
+  private static final Logger logger = Logger.getLogger(SupervisedPool.class.getName());
+
+  /**
+   * An operation that may block on storage.
+   */
+  @FunctionalInterface
+  public interface Operation<V> {
+    V call() throws IOException;
+  }
+
+  /**
+   * The least time between reading the mount table, and the longest a resolved mount is remembered, in nanoseconds.
+   */
+  private static final long MOUNT_REFRESH_INTERVAL = 1000L * 1000 * 1000;
+
+  /**
+   * The most paths with their mounts remembered.
+   */
+  private static final int MAX_RESOLVED = 4096;
+
+  /**
+   * The cool down after the first timeout, in nanoseconds.
+   */
+  static final long MIN_COOLDOWN = 5L * 1000 * 1000 * 1000;
+
+  /**
+   * The longest cool down, in nanoseconds.
+   */
+  private static final long MAX_COOLDOWN = 5L * 60 * 1000 * 1000 * 1000;
+
+  /**
+   * The most helpers that may be quarantined on one mount before its breaker stays open.
+   */
+  static final int MAX_QUARANTINED_PER_MOUNT = 4;
+
+  /**
+   * The circuit breaker of one mount.
+   */
+  private static final class Breaker {
+
+    private final String mountPoint;
+    private int failures;
+    private long openUntil;
+    private boolean probing;
+    private int quarantined;
+
+    /**
+     * Incremented each time the breaker opens, so only operations started since may close it.
+     */
+    private int generation;
+
+    private Breaker(String mountPoint) {
+      this.mountPoint = mountPoint;
+    }
+  }
+
+  /**
+   * One operation's use of a breaker, as of when the operation was let through.
+   */
+  private static final class Permit {
+
+    private final Breaker breaker;
+    private final int generation;
+    private final boolean probe;
+
+    private Permit(Breaker breaker) {
+      this.breaker = breaker;
+      this.generation = breaker.generation;
+      this.probe = breaker.failures > 0;
+    }
+  }
+
+  /**
+   * One operation on the helpers, which tracks its thread so it can be quarantined.
+   */
+  private final class Task<V> implements Callable<V> {
+
+    private final Operation<V> operation;
+    private final PosixFile[] files;
+    private List<Permit> permits;
+    private Thread thread;
+    private String threadName;
+    private boolean timedOut;
+    private List<Breaker> quarantinedOn;
+
+    /**
+     * @param  permits  the permits when the mounts of all files were already resolved,
+     *                  or {@code null} to resolve them on the helper
+     */
+    private Task(Operation<V> operation, PosixFile[] files, List<Permit> permits) {
+      this.operation = operation;
+      this.files = files;
+      this.permits = permits;
+    }
+
+    @Override
+    public V call() throws IOException, TimeoutException {
+      synchronized (this) {
+        thread = Thread.currentThread();
+        threadName = thread.getName();
+      }
+      try {
+        if (getPermits() == null) {
+          List<String> points = new ArrayList<>(files.length);
+          for (PosixFile file : files) {
+            String mountPoint = resolveMountPoint(file);
+            if (!points.contains(mountPoint)) {
+              points.add(mountPoint);
+            }
+          }
+          acquire(points, this);
+        }
+        return operation.call();
+      } finally {
+        release(this);
+      }
+    }
+
+    private synchronized List<Permit> getPermits() {
+      return permits;
+    }
+  }
+
+  /**
+   * A mount resolved for a path, and when.
+   */
+  private static final class Resolved {
+
+    private final String mountPoint;
+    private final long time;
+
+    private Resolved(String mountPoint, long time) {
+      this.mountPoint = mountPoint;
+      this.time = time;
+    }
+  }
+
+  private static final AtomicInteger poolCounter = new AtomicInteger();
+
+  private static volatile SupervisedPool instance;
+
+  /**
+   * Gets the pool shared by the deadline variants of {@link PosixFile}.
+   */
+  public static SupervisedPool getInstance() {
+    SupervisedPool pool = instance;
+    if (pool == null) {
+      synchronized (SupervisedPool.class) {
+        pool = instance;
+        if (pool == null) {
+          pool = new SupervisedPool(64);
+          instance = pool;
+        }
+      }
+    }
+    return pool;
+  }
+
+  private final int maxQuarantined;
+  private final LongSupplier clock;
+  private final ThreadPoolExecutor executor;
+  private final Map<String, Breaker> breakers = new HashMap<>();
+  private final Set<Task<?>> quarantinedTasks = new HashSet<>();
+  private List<String> mountPoints;
+  private long mountsRead;
+  private final Map<String, Resolved> resolved = new LinkedHashMap<String, Resolved>(16, 0.75f, true) {
+    private static final long serialVersionUID = 1L;
+
+    @Override
+    protected boolean removeEldestEntry(Map.Entry<String, Resolved> eldest) {
+      return size() > MAX_RESOLVED;
+    }
+  };
+
+  /**
+   * Creates a new pool.
+   *
+   * @param  maxQuarantined  the most helpers that may be quarantined at once, after which all operations fail
+   *                         immediately until some finish
+   */
+  public SupervisedPool(int maxQuarantined) {
+    this(maxQuarantined, System::nanoTime);
+  }
+
+  /**
+   * Creates a new pool with the given source of {@link System#nanoTime()}, so tests may control the cool downs.
+   */
+  SupervisedPool(int maxQuarantined, LongSupplier clock) {
+    if (maxQuarantined < 1) {
+      throw new IllegalArgumentException("maxQuarantined < 1: " + maxQuarantined);
+    }
+    this.maxQuarantined = maxQuarantined;
+    this.clock = clock;
+    String prefix = SupervisedPool.class.getName() + '-' + poolCounter.incrementAndGet() + '-';
+    AtomicInteger threadCounter = new AtomicInteger();
+    executor = new ThreadPoolExecutor(0, Integer.MAX_VALUE, 60, TimeUnit.SECONDS, new SynchronousQueue<>(), r -> {
+      Thread thread = new Thread(r, prefix + threadCounter.incrementAndGet());
+      thread.setDaemon(true);
+      return thread;
+    });
+  }
+
+  /**
+   * Runs an operation on a helper, waiting at most the given time.
+   *
+   * @param  files  the files the operation uses, whose mounts are supervised
+   *
+   * @throws  TimeoutException  when the operation did not finish in time, or a mount it uses is unhealthy
+   */
+  public <V> V call(long timeout, TimeUnit unit, Operation<V> operation, PosixFile ... files) throws IOException, TimeoutException {
+    // Fails fast on the calling thread when the mounts are already known
+    List<String> points = getResolvedMountPoints(files);
+    Task<V> task = new Task<>(operation, files, null);
+    if (points != null) {
+      acquire(points, task);
+    }
+    Future<V> future;
+    try {
+      future = executor.submit(task);
+    } catch (RuntimeException e) {
+      completed(task, false);
+      throw e;
+    }
+    try {
+      V result = future.get(timeout, unit);
+      completed(task, true);
+      return result;
+    } catch (TimeoutException e) {
+      List<Breaker> opened = quarantine(task);
+      future.cancel(true);
+      throw new TimeoutException("Timeout after " + unit.toMillis(timeout) + " ms on " + describe(opened));
+    } catch (InterruptedException e) {
+      future.cancel(true);
+      completed(task, false);
+      Thread.currentThread().interrupt();
+      InterruptedIOException ioErr = new InterruptedIOException();
+      ioErr.initCause(e);
+      throw ioErr;
+    } catch (ExecutionException e) {
+      Throwable cause = e.getCause();
+      if (cause instanceof TimeoutException) {
+        // A mount resolved on the helper is unhealthy, so nothing was let through
+        throw new TimeoutException(cause.getMessage());
+      }
+      // The mount answered, even if with an error
+      completed(task, true);
+      if (cause instanceof IOException) {
+        throw (IOException) cause;
+      }
+      if (cause instanceof RuntimeException) {
+        throw (RuntimeException) cause;
+      }
+      if (cause instanceof Error) {
+        throw (Error) cause;
+      }
+      throw new IOException(cause);
+    }
+  }
+
+  /**
+   * Checks whether operations on the mount of a file are currently allowed.  A file not used by a recent operation
+   * is checked against the mount containing its path as given, since resolving its real path could hang.
+   */
+  public boolean isHealthy(PosixFile file) {
+    List<String> points = getResolvedMountPoints(file);
+    String mountPoint = points == null ? getLexicalMountPoint(file) : points.get(0);
+    synchronized (breakers) {
+      Breaker breaker = breakers.get(mountPoint);
+      return breaker == null || (breaker.failures == 0 && breaker.quarantined < MAX_QUARANTINED_PER_MOUNT);
+    }
+  }
+
+  /**
+   * Gets the number of helpers still stuck after timing out.
+   */
+  public int getQuarantinedCount() {
+    synchronized (breakers) {
+      return quarantinedTasks.size();
+    }
+  }
+
+  private static String describe(List<Breaker> used) {
+    StringBuilder sb = new StringBuilder();
+    for (Breaker breaker : used) {
+      if (sb.length() > 0) {
+        sb.append(", ");
+      }
+      sb.append(breaker.mountPoint);
+    }
+    return sb.toString();
+  }
+
+  private static List<Breaker> breakersOf(List<Permit> permits) {
+    List<Breaker> used = new ArrayList<>(permits.size());
+    for (Permit permit : permits) {
+      used.add(permit.breaker);
+    }
+    return used;
+  }
+
+  /**
+   * Lets an operation through the breakers of the mounts, failing when any is open.  A breaker whose cool down has
+   * passed lets this operation through as its single probe.  Does nothing for an operation that already timed out
+   * while its mounts were resolved.
+   */
+  private void acquire(List<String> points, Task<?> task) throws TimeoutException {
+    long now = clock.getAsLong();
+    synchronized (breakers) {
+      if (quarantinedTasks.size() >= maxQuarantined) {
+        throw new TimeoutException("Too many operations quarantined: " + quarantinedTasks.size());
+      }
+      List<Breaker> used = new ArrayList<>(points.size());
+      for (String mountPoint : points) {
+        Breaker breaker = breakers.computeIfAbsent(mountPoint, Breaker::new);
+        if (
+            breaker.quarantined >= MAX_QUARANTINED_PER_MOUNT
+                || (breaker.failures > 0 && (breaker.probing || now - breaker.openUntil < 0))
+        ) {
+          throw new TimeoutException("Mount unhealthy: " + mountPoint);
+        }
+        used.add(breaker);
+      }
+      synchronized (task) {
+        if (!task.timedOut) {
+          List<Permit> permits = new ArrayList<>(used.size());
+          for (Breaker breaker : used) {
+            Permit permit = new Permit(breaker);
+            if (permit.probe) {
+              breaker.probing = true;
+            }
+            permits.add(permit);
+          }
+          task.permits = permits;
+        }
+      }
+    }
+  }
+
+  /**
+   * Records the outcome of an operation that did not time out.
+   *
+   * @param  answered  whether the mounts responded, which closes their breakers when opened before the operation
+   *                   started
+   */
+  private void completed(Task<?> task, boolean answered) {
+    synchronized (breakers) {
+      List<Permit> permits = task.getPermits();
+      if (permits != null) {
+        for (Permit permit : permits) {
+          Breaker breaker = permit.breaker;
+          if (permit.probe) {
+            breaker.probing = false;
+          }
+          if (answered && breaker.failures > 0 && permit.generation == breaker.generation) {
+            logger.info("Mount recovered: " + breaker.mountPoint);
+            breaker.failures = 0;
+            breaker.openUntil = 0;
+          }
+        }
+      }
+    }
+  }
+
+  /**
+   * Opens the breakers of a timed out operation and sets its helper aside until it returns.
+   *
+   * @return  the breakers of the mounts the operation timed out on
+   */
+  private List<Breaker> quarantine(Task<?> task) {
+    long now = clock.getAsLong();
+    List<Breaker> used;
+    synchronized (breakers) {
+      List<Permit> permits;
+      synchronized (task) {
+        task.timedOut = true;
+        permits = task.permits;
+      }
+      if (permits == null) {
+        // Timed out resolving the mounts, so blames the mounts containing the paths as given
+        used = new ArrayList<>(task.files.length);
+        for (PosixFile file : task.files) {
+          Breaker breaker = breakers.computeIfAbsent(getLexicalMountPoint(file), Breaker::new);
+          if (!used.contains(breaker)) {
+            used.add(breaker);
+            open(breaker, now);
+          }
+        }
+      } else {
+        used = breakersOf(permits);
+        for (Permit permit : permits) {
+          Breaker breaker = permit.breaker;
+          if (permit.probe) {
+            breaker.probing = false;
+          }
+          // An operation from before the breaker last opened does not extend its cool down again
+          if (permit.generation == breaker.generation) {
+            open(breaker, now);
+          }
+        }
+      }
+      synchronized (task) {
+        // A task that has not started yet is cancelled instead
+        if (task.thread != null) {
+          task.quarantinedOn = used;
+          quarantinedTasks.add(task);
+          for (Breaker breaker : used) {
+            breaker.quarantined++;
+          }
+          task.thread.setName(task.threadName + " (quarantined on " + describe(used) + ')');
+        }
+      }
+    }
+    logger.warning("Operation timed out, mount unhealthy: " + describe(used));
+    return used;
+  }
+
+  private static void open(Breaker breaker, long now) {
+    breaker.failures++;
+    breaker.generation++;
+    long cooldown = MIN_COOLDOWN << Math.min(breaker.failures - 1, 16);
+    breaker.openUntil = now + Math.min(cooldown, MAX_COOLDOWN);
+  }
+
+  /**
+   * Returns a quarantined helper to the pool once its operation finally returns.
+   */
+  private void release(Task<?> task) {
+    synchronized (breakers) {
+      synchronized (task) {
+        if (task.quarantinedOn != null) {
+          quarantinedTasks.remove(task);
+          for (Breaker breaker : task.quarantinedOn) {
+            breaker.quarantined--;
+          }
+          task.quarantinedOn = null;
+          task.thread.setName(task.threadName);
+        }
+        task.thread = null;
+      }
+    }
+  }
+
+  private static String getAbsolutePath(PosixFile file) {
+    return Paths.get(file.getFile().getAbsolutePath()).normalize().toString();
+  }
+
+  /**
+   * Gets the mounts of the files remembered from recent resolutions, or {@code null} when any must be resolved.
+   */
+  private List<String> getResolvedMountPoints(PosixFile ... files) {
+    long now = clock.getAsLong();
+    List<String> points = new ArrayList<>(files.length);
+    synchronized (resolved) {
+      for (PosixFile file : files) {
+        Resolved r = resolved.get(getAbsolutePath(file));
+        if (r == null || now - r.time >= MOUNT_REFRESH_INTERVAL) {
+          return null;
+        }
+        if (!points.contains(r.mountPoint)) {
+          points.add(r.mountPoint);
+        }
+      }
+    }
+    return points;
+  }
+
+  /**
+   * Finds the mount of the real path of a file, or of its nearest existing parent, and remembers it.
+   * Called on a helper, since it may hang.
+   */
+  private String resolveMountPoint(PosixFile file) throws IOException {
+    String path = getAbsolutePath(file);
+    Path realPath = null;
+    List<String> missing = new ArrayList<>();
+    for (File dir = new File(path); dir != null; dir = dir.getParentFile()) {
+      if (dir.exists()) {
+        realPath = dir.toPath().toRealPath();
+        break;
+      }
+      missing.add(dir.getName());
+    }
+    if (realPath == null) {
+      realPath = Paths.get("/");
+    }
+    Collections.reverse(missing);
+    for (String name : missing) {
+      realPath = realPath.resolve(name);
+    }
+    String mountPoint = getMountPoint(realPath.toString());
+    synchronized (resolved) {
+      resolved.put(path, new Resolved(mountPoint, clock.getAsLong()));
+    }
+    return mountPoint;
+  }
+
+  /**
+   * Finds the mount containing the path of a file as given, without accessing the file.
+   */
+  private String getLexicalMountPoint(PosixFile file) {
+    return getMountPoint(getAbsolutePath(file));
+  }
+
+  /**
+   * Finds the longest mount point containing an absolute path.
+   */
+  private String getMountPoint(String path) {
+    List<String> points = getMountPoints();
+    String best = "/";
+    for (String point : points) {
+      if (
+          point.length() > best.length()
+              && path.startsWith(point)
+              && (path.length() == point.length() || path.charAt(point.length()) == '/')
+      ) {
+        best = point;
+      }
+    }
+    return best;
+  }
+
+  /**
+   * Gets the mount points, reading the mount table at most once per {@link #MOUNT_REFRESH_INTERVAL}.
+   */
+  private synchronized List<String> getMountPoints() {
+    long now = System.nanoTime();
+    if (mountPoints == null || now - mountsRead >= MOUNT_REFRESH_INTERVAL) {
+      List<String> points = new ArrayList<>();
+      try {
+        for (String line : Files.readAllLines(Paths.get("/proc/self/mountinfo"), StandardCharsets.ISO_8859_1)) {
+          // The mount point is the fifth field, with spaces and other special characters escaped in octal
+          String[] fields = line.split(" ", 6);
+          if (fields.length >= 5) {
+            points.add(unescape(fields[4]));
+          }
+        }
+      } catch (IOException e) {
+        logger.log(Level.FINE, "Unable to read mount table", e);
+      }
+      mountPoints = points;
+      mountsRead = now;
+    }
+    return mountPoints;
+  }
+
+  private static String unescape(String field) {
+    if (field.indexOf('\\') == -1) {
+      return field;
+    }
+    StringBuilder sb = new StringBuilder(field.length());
+    for (int i = 0; i < field.length(); i++) {
+      char ch = field.charAt(i);
+      if (ch == '\\' && i + 3 < field.length()) {
+        sb.append((char) Integer.parseInt(field.substring(i + 1, i + 4), 8));
+        i += 3;
+      } else {
+        sb.append(ch);
+      }
+    }
+    return sb.toString();
+  }
+}
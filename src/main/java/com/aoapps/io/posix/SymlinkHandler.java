@@ -0,0 +1,67 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import java.io.IOException;
+
+/**
+ * Receives the symbolic links classified by {@link PosixFile#analyzeSymlinks(com.aoapps.io.posix.PosixFile, com.aoapps.io.posix.SymlinkHandler, com.aoapps.io.posix.WalkOption...)}.
+ * <p>
+ * Called only on the thread that started the analysis.
+ * </p>
+ *
+ * @author  AO Industries, Inc.
+ */
+@FunctionalInterface
+public interface SymlinkHandler {
+
+  /**
+   * The link resolves to an existing file within the root.
+   */
+  int OK = 0;
+
+  /**
+   * The target, or a directory along the way, does not exist or cannot be searched.
+   */
+  int BROKEN = 1;
+
+  /**
+   * Resolving the link requires following more than 40 links, which includes any link that leads back to itself.
+   */
+  int LOOP = 2;
+
+  /**
+   * The link resolves to an existing file outside the root.
+   */
+  int ESCAPE = 3;
+
+  /**
+   * Called for each batch of links, in the order found.  Throwing an exception stops the analysis.
+   *
+   * @param  paths     the path of each link, starting with the path of the directory analyzed
+   * @param  targets   the contents of each link
+   * @param  statuses  the classification of each link, one of {@link #OK}, {@link #BROKEN}, {@link #LOOP}, or {@link #ESCAPE}
+   */
+  void links(String[] paths, String[] targets, int[] statuses) throws IOException;
+}
@@ -0,0 +1,89 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+
+package com.aoapps.io.posix;
+
+/**
+ * Options for the native recursive operations of {@link PosixFile}.
+ * <p>
+ * Symbolic links are never followed below the starting path, regardless of options.
+ * </p>
+ *
+ * @author  AO Industries, Inc.
+ */
+public enum WalkOption {
+
+  /**
+   * Do not cross into other mounted filesystems, including bind mounts of the same filesystem, similar to
+   * <code>rm --one-file-system</code>.  Mount points below the starting path are found from
+   * <code>/proc/self/mountinfo</code> and skipped without being accessed, so a hung remote mount is never touched.
+   * Mounts created during the walk are detected by a change of device or <code>STATX_ATTR_MOUNT_ROOT</code>.
+   * <p>
+   * When not specified, the walk crosses mount points.
+   * </p>
+   */
+  ONE_FILE_SYSTEM(0x1),
+
+  /**
+   * Processes the entries of each directory in inode order instead of <code>readdir</code> order, similar to what
+   * <code>rm -rf</code> does for large directories.  On ext4, <code>readdir</code> returns entries in hash order,
+   * so processing in that order seeks randomly across the inode tables; this greatly reduces seeks on rotational
+   * storage and large volumes.
+   * <p>
+   * All entries of a directory are already read before any are processed, so this only adds a sort.
+   * </p>
+   */
+  INODE_ORDER(0x2),
+
+  /**
+   * Overlaps metadata I/O with processing on cold caches.  Helper threads stat the upcoming entries of the current
+   * directory, within a bounded window ahead of the walk, and read ahead the start of each subdirectory found.
+   * The walk then uses the prefetched results instead of waiting on each inode read in turn.
+   * <p>
+   * This adds threads and some overhead, so is best for large trees on slow or remote storage whose metadata is not
+   * already cached.
+   * </p>
+   */
+  PREFETCH(0x4);
+
+  /**
+   * The bit used in native code, must match <code>AOCODE_WALK_*</code> in <code>aocode_walk.h</code>.
+   */
+  private final int flag;
+
+  private WalkOption(int flag) {
+    this.flag = flag;
+  }
+
+  /**
+   * Combines the options into the native flags.
+   */
+  static int toFlags(WalkOption... options) {
+    int flags = 0;
+    for (WalkOption option : options) {
+      flags |= option.flag;
+    }
+    return flags;
+  }
+}
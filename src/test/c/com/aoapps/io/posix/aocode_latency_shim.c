@@ -0,0 +1,638 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+/*
+ * An LD_PRELOAD shim that injects latency and errno failures into filesystem calls, for benchmarking
+ * behavior on slow storage such as high-latency NFS or overloaded disks.
+ *
+ * Configured by the AOCODE_SHIM environment variable, either the name of a preset or a list of rules:
+ *
+ *   AOCODE_SHIM=nfs
+ *   AOCODE_SHIM="stat=lognormal:200:1.0,spike:50000:0.001;unlink=fixed:1000,EIO:0.0001"
+ *
+ * Each rule is a call group followed by comma-separated items:
+ *
+ *   fixed:US                  a constant delay in microseconds
+ *   uniform:MIN:MAX           a uniformly distributed delay in microseconds
+ *   lognormal:MEDIAN:SIGMA    a log-normally distributed delay in microseconds
+ *   spike:US:PROBABILITY      an additional delay with the given probability, for tail latency
+ *   ERRNO:PROBABILITY         fails with the errno, such as EIO or ESTALE, without making the call
+ *
+ * The call groups are:
+ *
+ *   stat      stat, lstat, fstatat, and statx, including the 64-bit and older glibc variants
+ *   open      open, openat, and opendir, including the 64-bit variants
+ *   read      read and pread
+ *   unlink    unlink, unlinkat, and rmdir
+ *   rename    rename, renameat, and renameat2
+ *   getdents  getdents64, and readdir once per AOCODE_SHIM_DIRENTS entries (default 256) to
+ *             approximate the buffer refills glibc makes internally
+ *   fsync     fsync and fdatasync
+ *
+ * AOCODE_SHIM_PATH limits injection to the files below a directory, such as the trees of a benchmark,
+ * leaving the class path, logs, and everything else the process touches at full speed.  It is a
+ * plain string prefix of absolute paths, so "/tmp/TreeBenchmarkTest." selects every directory made
+ * with that prefix.  Relative paths are resolved against the working directory or, for the *at
+ * calls, selected when their directory was opened below the prefix.  The calls on file descriptors
+ * (read, getdents, fsync, and readdir) are selected when the descriptor was opened below the prefix
+ * by open, openat, or opendir; descriptors from dup or fcntl are not followed.
+ *
+ * AOCODE_SHIM_SEED seeds the random choices, and AOCODE_SHIM_STATS=1 prints the number of delayed
+ * and failed calls per group to standard error on exit.
+ */
+#define _GNU_SOURCE
+#include <dirent.h>
+#include <dlfcn.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <math.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define GROUP_STAT 0
+#define GROUP_OPEN 1
+#define GROUP_READ 2
+#define GROUP_UNLINK 3
+#define GROUP_RENAME 4
+#define GROUP_GETDENTS 5
+#define GROUP_FSYNC 6
+#define GROUP_COUNT 7
+
+#define MAX_ERRNOS 8
+
+static const char* const groupNames[GROUP_COUNT]={"stat", "open", "read", "unlink", "rename", "getdents", "fsync"};
+
+#define DIST_NONE 0
+#define DIST_FIXED 1
+#define DIST_UNIFORM 2
+#define DIST_LOGNORMAL 3
+
+typedef struct shim_rule {
+  int dist;
+  double a;
+  double b;
+  double spikeUs;
+  double spikeProbability;
+  int errnoCount;
+  int errnos[MAX_ERRNOS];
+  double errnoProbabilities[MAX_ERRNOS];
+  // Statistics
+  unsigned long calls;
+  unsigned long delayed;
+  unsigned long failed;
+} shim_rule;
+
+static shim_rule rules[GROUP_COUNT];
+static int active=0;
+static uint64_t seed=1;
+static unsigned direntsPerGetdents=256;
+static const char* pathPrefix=NULL;
+static size_t pathPrefixLen=0;
+
+// The file descriptors opened below pathPrefix, higher descriptors are never selected
+#define MAX_TRACKED_FDS 65536
+static unsigned char trackedFds[MAX_TRACKED_FDS];
+
+static const struct {
+  const char* name;
+  const char* config;
+} presets[]={
+  // High-latency NFS: every metadata operation is a round trip, with occasional multi-second stalls
+  {"nfs", "stat=lognormal:400:0.8,spike:200000:0.0005;open=lognormal:700:0.8,spike:200000:0.0005;"
+      "read=lognormal:250:0.7;unlink=lognormal:900:0.8;rename=lognormal:1100:0.8;"
+      "getdents=lognormal:1500:0.8;fsync=lognormal:5000:1.0"},
+  // Overloaded local disk: cheap cached metadata, slow data and very slow flushes
+  {"disk", "stat=lognormal:20:1.5,spike:20000:0.001;open=lognormal:30:1.5;read=lognormal:800:1.2,spike:100000:0.001;"
+      "unlink=lognormal:200:1.2;rename=lognormal:300:1.2;getdents=lognormal:500:1.2;fsync=lognormal:30000:1.2"},
+  // NFS with transient failures, for exercising error handling rather than measuring throughput
+  {"flaky", "stat=lognormal:400:0.8,ESTALE:0.0005,EIO:0.0002;open=lognormal:700:0.8,ESTALE:0.0005;"
+      "read=lognormal:250:0.7,EIO:0.0001;unlink=lognormal:900:0.8,EIO:0.0002;rename=lognormal:1100:0.8;"
+      "getdents=lognormal:1500:0.8;fsync=lognormal:5000:1.0,EIO:0.001"}
+};
+
+static const struct {
+  const char* name;
+  int value;
+} errnoNames[]={
+  {"EACCES", EACCES}, {"EAGAIN", EAGAIN}, {"EBUSY", EBUSY}, {"EINTR", EINTR}, {"EIO", EIO},
+  {"ENOENT", ENOENT}, {"ENOMEM", ENOMEM}, {"ENOSPC", ENOSPC}, {"EPERM", EPERM}, {"EROFS", EROFS},
+  {"ESTALE", ESTALE}, {"ETIMEDOUT", ETIMEDOUT}
+};
+
+static __thread uint64_t randomState=0;
+
+// xorshift64*, seeded per thread
+static double nextDouble(void) {
+  if (randomState==0) randomState=(seed ^ ((uint64_t)syscall(SYS_gettid)*0x9E3779B97F4A7C15ULL)) | 1;
+  randomState^=randomState>>12;
+  randomState^=randomState<<25;
+  randomState^=randomState>>27;
+  return (double)((randomState*0x2545F4914F6CDD1DULL)>>11) / 9007199254740992.0;
+}
+
+static double nextGaussian(void) {
+  double u1=nextDouble();
+  double u2=nextDouble();
+  if (u1<1e-300) u1=1e-300;
+  return sqrt(-2.0*log(u1))*cos(2.0*M_PI*u2);
+}
+
+static int parseRule(shim_rule* rule, char* items) {
+  char* saveptr;
+  char* item;
+  for (item=strtok_r(items, ",", &saveptr); item!=NULL; item=strtok_r(NULL, ",", &saveptr)) {
+    char* colon=strchr(item, ':');
+    if (colon==NULL) return -1;
+    *colon='\0';
+    char* args=colon+1;
+    if (strcmp(item, "fixed")==0) {
+      rule->dist=DIST_FIXED;
+      if (sscanf(args, "%lf", &rule->a)!=1) return -1;
+    } else if (strcmp(item, "uniform")==0) {
+      rule->dist=DIST_UNIFORM;
+      if (sscanf(args, "%lf:%lf", &rule->a, &rule->b)!=2) return -1;
+    } else if (strcmp(item, "lognormal")==0) {
+      rule->dist=DIST_LOGNORMAL;
+      if (sscanf(args, "%lf:%lf", &rule->a, &rule->b)!=2) return -1;
+    } else if (strcmp(item, "spike")==0) {
+      if (sscanf(args, "%lf:%lf", &rule->spikeUs, &rule->spikeProbability)!=2) return -1;
+    } else {
+      size_t e;
+      for (e=0; e<sizeof(errnoNames)/sizeof(errnoNames[0]); e++) {
+        if (strcmp(item, errnoNames[e].name)==0) break;
+      }
+      if (e==sizeof(errnoNames)/sizeof(errnoNames[0]) || rule->errnoCount==MAX_ERRNOS) return -1;
+      if (sscanf(args, "%lf", &rule->errnoProbabilities[rule->errnoCount])!=1) return -1;
+      rule->errnos[rule->errnoCount++]=errnoNames[e].value;
+    }
+  }
+  return 0;
+}
+
+static int parseConfig(const char* config) {
+  size_t p;
+  for (p=0; p<sizeof(presets)/sizeof(presets[0]); p++) {
+    if (strcmp(config, presets[p].name)==0) {
+      config=presets[p].config;
+      break;
+    }
+  }
+  char* copy=strdup(config);
+  if (copy==NULL) return -1;
+  int result=0;
+  char* saveptr;
+  char* ruleStr;
+  for (ruleStr=strtok_r(copy, ";", &saveptr); ruleStr!=NULL && result==0; ruleStr=strtok_r(NULL, ";", &saveptr)) {
+    char* eq=strchr(ruleStr, '=');
+    if (eq==NULL) {
+      result=-1;
+      break;
+    }
+    *eq='\0';
+    int g;
+    for (g=0; g<GROUP_COUNT; g++) {
+      if (strcmp(ruleStr, groupNames[g])==0) break;
+    }
+    if (g==GROUP_COUNT) {
+      result=-1;
+    } else {
+      char* items=strdup(eq+1);
+      if (items==NULL || parseRule(&rules[g], items)!=0) result=-1;
+      free(items);
+    }
+  }
+  free(copy);
+  return result;
+}
+
+static void printStats(void) {
+  int g;
+  for (g=0; g<GROUP_COUNT; g++) {
+    if (rules[g].calls>0) {
+      fprintf(stderr, "aocode_latency_shim: %s: %lu calls, %lu delayed, %lu failed\n", groupNames[g], rules[g].calls, rules[g].delayed, rules[g].failed);
+    }
+  }
+}
+
+__attribute__((constructor))
+static void shimInit(void) {
+  const char* config=getenv("AOCODE_SHIM");
+  if (config==NULL || *config=='\0') return;
+  const char* seedStr=getenv("AOCODE_SHIM_SEED");
+  if (seedStr!=NULL) seed=strtoull(seedStr, NULL, 10);
+  const char* direntsStr=getenv("AOCODE_SHIM_DIRENTS");
+  if (direntsStr!=NULL && atoi(direntsStr)>0) direntsPerGetdents=(unsigned)atoi(direntsStr);
+  if (parseConfig(config)!=0) {
+    fprintf(stderr, "aocode_latency_shim: Invalid AOCODE_SHIM: %s\n", config);
+    return;
+  }
+  const char* path=getenv("AOCODE_SHIM_PATH");
+  if (path!=NULL && *path!='\0') {
+    if (*path!='/') {
+      fprintf(stderr, "aocode_latency_shim: AOCODE_SHIM_PATH is not absolute: %s\n", path);
+      return;
+    }
+    pathPrefix=path;
+    pathPrefixLen=strlen(path);
+  }
+  const char* stats=getenv("AOCODE_SHIM_STATS");
+  if (stats!=NULL && strcmp(stats, "1")==0) atexit(printStats);
+  active=1;
+}
+
+static int isTracked(int fd) {
+  return fd>=0 && fd<MAX_TRACKED_FDS && __atomic_load_n(&trackedFds[fd], __ATOMIC_RELAXED);
+}
+
+/*
+ * Records whether a newly opened descriptor is below pathPrefix, returning it unchanged.  Always
+ * stored, since a descriptor number may be reused without passing through close.
+ */
+static int track(int fd, int selected) {
+  if (pathPrefix!=NULL && fd>=0 && fd<MAX_TRACKED_FDS) {
+    __atomic_store_n(&trackedFds[fd], (unsigned char)selected, __ATOMIC_RELAXED);
+  }
+  return fd;
+}
+
+/*
+ * Whether a call on a path, relative to dirfd when not absolute, is injected.
+ * Does not change errno.
+ */
+static int pathSelected(int dirfd, const char* path) {
+  if (!active) return 0;
+  if (pathPrefix==NULL) return 1;
+  if (path==NULL) return 0;
+  if (*path=='/') return strncmp(path, pathPrefix, pathPrefixLen)==0;
+  if (dirfd!=AT_FDCWD) return isTracked(dirfd);
+  char full[PATH_MAX];
+  int savedErrno=errno;
+  if (getcwd(full, sizeof(full))==NULL) {
+    errno=savedErrno;
+    return 0;
+  }
+  size_t len=strlen(full);
+  if (len==1) len=0; // The root directory
+  // Truncated only beyond PATH_MAX, where the prefix has long since been compared
+  snprintf(full+len, sizeof(full)-len, "/%s", path);
+  return strncmp(full, pathPrefix, pathPrefixLen)==0;
+}
+
+// Whether a call on a file descriptor is injected
+static int fdSelected(int fd) {
+  return active && (pathPrefix==NULL || isTracked(fd));
+}
+
+static void sleepUs(double us) {
+  if (us<=0) return;
+  struct timespec ts;
+  ts.tv_sec=(time_t)(us/1000000.0);
+  ts.tv_nsec=(long)((us-ts.tv_sec*1000000.0)*1000.0);
+  while (clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, &ts)==EINTR) {
+    // Keep sleeping the remainder
+  }
+}
+
+/*
+ * Applies the rule for a group, returns 0 to make the call or an errno to fail without making it.
+ * Preserves errno when the call is to be made.
+ */
+static int inject(int group) {
+  shim_rule* rule=&rules[group];
+  int savedErrno=errno;
+  __atomic_add_fetch(&rule->calls, 1, __ATOMIC_RELAXED);
+  double us;
+  switch (rule->dist) {
+    case DIST_FIXED: us=rule->a; break;
+    case DIST_UNIFORM: us=rule->a+(rule->b-rule->a)*nextDouble(); break;
+    case DIST_LOGNORMAL: us=rule->a*exp(rule->b*nextGaussian()); break;
+    default: us=0;
+  }
+  if (rule->spikeProbability>0 && nextDouble()<rule->spikeProbability) us+=rule->spikeUs;
+  if (us>0) {
+    __atomic_add_fetch(&rule->delayed, 1, __ATOMIC_RELAXED);
+    sleepUs(us);
+  }
+  int e;
+  for (e=0; e<rule->errnoCount; e++) {
+    if (nextDouble()<rule->errnoProbabilities[e]) {
+      __atomic_add_fetch(&rule->failed, 1, __ATOMIC_RELAXED);
+      return rule->errnos[e];
+    }
+  }
+  errno=savedErrno;
+  return 0;
+}
+
+#define REAL(name) \
+  static __typeof__(name)* real_##name=NULL; \
+  if (real_##name==NULL) real_##name=(__typeof__(name)*)dlsym(RTLD_NEXT, #name)
+
+#define INJECT(selected, group, failure) \
+  do { \
+    if (selected) { \
+      int injected=inject(group); \
+      if (injected!=0) { \
+        errno=injected; \
+        return failure; \
+      } \
+    } \
+  } while (0)
+
+// Gets the optional mode argument of the open family
+#define OPEN_MODE(flags, mode) \
+  mode_t mode=0; \
+  if ((flags) & (O_CREAT | __O_TMPFILE)) { \
+    va_list ap; \
+    va_start(ap, flags); \
+    mode=va_arg(ap, mode_t); \
+    va_end(ap); \
+  }
+
+/* stat */
+
+int stat(const char* path, struct stat* buf) {
+  REAL(stat);
+  INJECT(pathSelected(AT_FDCWD, path), GROUP_STAT, -1);
+  return real_stat(path, buf);
+}
+
+int stat64(const char* path, struct stat64* buf) {
+  REAL(stat64);
+  INJECT(pathSelected(AT_FDCWD, path), GROUP_STAT, -1);
+  return real_stat64(path, buf);
+}
+
+int lstat(const char* path, struct stat* buf) {
+  REAL(lstat);
+  INJECT(pathSelected(AT_FDCWD, path), GROUP_STAT, -1);
+  return real_lstat(path, buf);
+}
+
+int lstat64(const char* path, struct stat64* buf) {
+  REAL(lstat64);
+  INJECT(pathSelected(AT_FDCWD, path), GROUP_STAT, -1);
+  return real_lstat64(path, buf);
+}
+
+int fstatat(int dirfd, const char* path, struct stat* buf, int flags) {
+  REAL(fstatat);
+  INJECT(pathSelected(dirfd, path), GROUP_STAT, -1);
+  return real_fstatat(dirfd, path, buf, flags);
+}
+
+int fstatat64(int dirfd, const char* path, struct stat64* buf, int flags) {
+  REAL(fstatat64);
+  INJECT(pathSelected(dirfd, path), GROUP_STAT, -1);
+  return real_fstatat64(dirfd, path, buf, flags);
+}
+
+int statx(int dirfd, const char* path, int flags, unsigned int mask, struct statx* buf) {
+  REAL(statx);
+  INJECT(pathSelected(dirfd, path), GROUP_STAT, -1);
+  return real_statx(dirfd, path, flags, mask, buf);
+}
+
+// glibc before 2.33 routes stat calls through these
+int __xstat(int ver, const char* path, struct stat* buf);
+int __xstat(int ver, const char* path, struct stat* buf) {
+  REAL(__xstat);
+  INJECT(pathSelected(AT_FDCWD, path), GROUP_STAT, -1);
+  return real___xstat(ver, path, buf);
+}
+
+int __xstat64(int ver, const char* path, struct stat64* buf);
+int __xstat64(int ver, const char* path, struct stat64* buf) {
+  REAL(__xstat64);
+  INJECT(pathSelected(AT_FDCWD, path), GROUP_STAT, -1);
+  return real___xstat64(ver, path, buf);
+}
+
+int __lxstat(int ver, const char* path, struct stat* buf);
+int __lxstat(int ver, const char* path, struct stat* buf) {
+  REAL(__lxstat);
+  INJECT(pathSelected(AT_FDCWD, path), GROUP_STAT, -1);
+  return real___lxstat(ver, path, buf);
+}
+
+int __lxstat64(int ver, const char* path, struct stat64* buf);
+int __lxstat64(int ver, const char* path, struct stat64* buf) {
+  REAL(__lxstat64);
+  INJECT(pathSelected(AT_FDCWD, path), GROUP_STAT, -1);
+  return real___lxstat64(ver, path, buf);
+}
+
+int __fxstatat(int ver, int dirfd, const char* path, struct stat* buf, int flags);
+int __fxstatat(int ver, int dirfd, const char* path, struct stat* buf, int flags) {
+  REAL(__fxstatat);
+  INJECT(pathSelected(dirfd, path), GROUP_STAT, -1);
+  return real___fxstatat(ver, dirfd, path, buf, flags);
+}
+
+int __fxstatat64(int ver, int dirfd, const char* path, struct stat64* buf, int flags);
+int __fxstatat64(int ver, int dirfd, const char* path, struct stat64* buf, int flags) {
+  REAL(__fxstatat64);
+  INJECT(pathSelected(dirfd, path), GROUP_STAT, -1);
+  return real___fxstatat64(ver, dirfd, path, buf, flags);
+}
+
+/* open */
+
+int open(const char* path, int flags, ...) {
+  REAL(open);
+  OPEN_MODE(flags, mode);
+  int selected=pathSelected(AT_FDCWD, path);
+  INJECT(selected, GROUP_OPEN, -1);
+  return track(real_open(path, flags, mode), selected);
+}
+
+int open64(const char* path, int flags, ...) {
+  REAL(open64);
+  OPEN_MODE(flags, mode);
+  int selected=pathSelected(AT_FDCWD, path);
+  INJECT(selected, GROUP_OPEN, -1);
+  return track(real_open64(path, flags, mode), selected);
+}
+
+int openat(int dirfd, const char* path, int flags, ...) {
+  REAL(openat);
+  OPEN_MODE(flags, mode);
+  int selected=pathSelected(dirfd, path);
+  INJECT(selected, GROUP_OPEN, -1);
+  return track(real_openat(dirfd, path, flags, mode), selected);
+}
+
+int openat64(int dirfd, const char* path, int flags, ...) {
+  REAL(openat64);
+  OPEN_MODE(flags, mode);
+  int selected=pathSelected(dirfd, path);
+  INJECT(selected, GROUP_OPEN, -1);
+  return track(real_openat64(dirfd, path, flags, mode), selected);
+}
+
+DIR* opendir(const char* path) {
+  REAL(opendir);
+  int selected=pathSelected(AT_FDCWD, path);
+  INJECT(selected, GROUP_OPEN, NULL);
+  DIR* dir=real_opendir(path);
+  if (dir!=NULL) track(dirfd(dir), selected);
+  return dir;
+}
+
+/* close, not injected but ends the tracking of the descriptor */
+
+int close(int fd) {
+  REAL(close);
+  track(fd, 0);
+  return real_close(fd);
+}
+
+int closedir(DIR* dir) {
+  REAL(closedir);
+  track(dirfd(dir), 0);
+  return real_closedir(dir);
+}
+
+/* read */
+
+ssize_t read(int fd, void* buf, size_t count) {
+  REAL(read);
+  INJECT(fdSelected(fd), GROUP_READ, -1);
+  return real_read(fd, buf, count);
+}
+
+ssize_t pread(int fd, void* buf, size_t count, off_t offset) {
+  REAL(pread);
+  INJECT(fdSelected(fd), GROUP_READ, -1);
+  return real_pread(fd, buf, count, offset);
+}
+
+ssize_t pread64(int fd, void* buf, size_t count, off64_t offset) {
+  REAL(pread64);
+  INJECT(fdSelected(fd), GROUP_READ, -1);
+  return real_pread64(fd, buf, count, offset);
+}
+
+/* unlink */
+
+int unlink(const char* path) {
+  REAL(unlink);
+  INJECT(pathSelected(AT_FDCWD, path), GROUP_UNLINK, -1);
+  return real_unlink(path);
+}
+
+int unlinkat(int dirfd, const char* path, int flags) {
+  REAL(unlinkat);
+  INJECT(pathSelected(dirfd, path), GROUP_UNLINK, -1);
+  return real_unlinkat(dirfd, path, flags);
+}
+
+int rmdir(const char* path) {
+  REAL(rmdir);
+  INJECT(pathSelected(AT_FDCWD, path), GROUP_UNLINK, -1);
+  return real_rmdir(path);
+}
+
+/* rename */
+
+int rename(const char* oldpath, const char* newpath) {
+  REAL(rename);
+  INJECT(pathSelected(AT_FDCWD, oldpath) || pathSelected(AT_FDCWD, newpath), GROUP_RENAME, -1);
+  return real_rename(oldpath, newpath);
+}
+
+int renameat(int olddirfd, const char* oldpath, int newdirfd, const char* newpath) {
+  REAL(renameat);
+  INJECT(pathSelected(olddirfd, oldpath) || pathSelected(newdirfd, newpath), GROUP_RENAME, -1);
+  return real_renameat(olddirfd, oldpath, newdirfd, newpath);
+}
+
+int renameat2(int olddirfd, const char* oldpath, int newdirfd, const char* newpath, unsigned int flags) {
+  REAL(renameat2);
+  INJECT(pathSelected(olddirfd, oldpath) || pathSelected(newdirfd, newpath), GROUP_RENAME, -1);
+  return real_renameat2(olddirfd, oldpath, newdirfd, newpath, flags);
+}
+
+/* getdents */
+
+ssize_t getdents64(int fd, void* dirp, size_t count) {
+  REAL(getdents64);
+  INJECT(fdSelected(fd), GROUP_GETDENTS, -1);
+  return real_getdents64(fd, dirp, count);
+}
+
+static __thread DIR* lastDir=NULL;
+static __thread unsigned direntCount=0;
+
+// Delays when starting a directory and every direntsPerGetdents entries after
+static int injectReaddir(DIR* dir) {
+  if (!fdSelected(dirfd(dir))) return 0;
+  if (dir!=lastDir) {
+    lastDir=dir;
+    direntCount=0;
+  }
+  if (direntCount++ % direntsPerGetdents == 0) return inject(GROUP_GETDENTS);
+  return 0;
+}
+
+struct dirent* readdir(DIR* dir) {
+  REAL(readdir);
+  int injected=injectReaddir(dir);
+  if (injected!=0) {
+    errno=injected;
+    return NULL;
+  }
+  return real_readdir(dir);
+}
+
+struct dirent64* readdir64(DIR* dir) {
+  REAL(readdir64);
+  int injected=injectReaddir(dir);
+  if (injected!=0) {
+    errno=injected;
+    return NULL;
+  }
+  return real_readdir64(dir);
+}
+
+/* fsync */
+
+int fsync(int fd) {
+  REAL(fsync);
+  INJECT(fdSelected(fd), GROUP_FSYNC, -1);
+  return real_fsync(fd);
+}
+
+int fdatasync(int fd) {
+  REAL(fdatasync);
+  INJECT(fdSelected(fd), GROUP_FSYNC, -1);
+  return real_fdatasync(fd);
+}
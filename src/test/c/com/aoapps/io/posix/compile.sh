@@ -0,0 +1,31 @@
+#!/bin/sh
+#
+# ao-io-posix - Java interface to native POSIX filesystem objects.
+# Copyright (C) 2026  AO Industries, Inc.
+#     support@aoindustries.com
+#     7262 Bull Pen Cir
+#     Mobile, AL 36695
+#
+# This file is part of ao-io-posix.
+#
+# ao-io-posix is free software: you can redistribute it and/or modify
+# it under the terms of the GNU Lesser General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# ao-io-posix is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+#
+# Builds the latency-injection shim used by the latency profile, see aocode_latency_shim.c
+# Compiled without _FILE_OFFSET_BITS=64 so both the 32-bit and 64-bit offset variants may be wrapped.
+gcc -fPIC \
+  -O2 \
+  -shared \
+  -o libaocode_latency_shim.so \
+  aocode_latency_shim.c \
+  -ldl -lm || exit "$?"
@@ -1,6 +1,6 @@
 /*
  * ao-io-posix - Java interface to native POSIX filesystem objects.
- * Copyright (C) 2008, 2009, 2010, 2011, 2013, 2015, 2016, 2017, 2019, 2020, 2021, 2022  AO Industries, Inc.
+ * Copyright (C) 2008, 2009, 2010, 2011, 2013, 2015, 2016, 2017, 2019, 2020, 2021, 2022, 2026  AO Industries, Inc.
  *     support@aoindustries.com
  *     7262 Bull Pen Cir
  *     Mobile, AL 36695
@@ -23,41 +23,31 @@
 
 package com.aoapps.hodgepodge.io;
 
+import static org.junit.Assert.assertEquals;
+
+import com.aoapps.io.posix.NativeTest;
 import com.aoapps.io.posix.PosixFile;
 import java.io.File;
 import java.io.FileOutputStream;
 import java.io.IOException;
-import java.nio.file.Files;
 import java.util.ArrayList;
 import java.util.Collections;
 import java.util.HashMap;
 import java.util.List;
 import java.util.Map;
-import junit.framework.Test;
-import junit.framework.TestCase;
-import junit.framework.TestSuite;
+import org.junit.Before;
+import org.junit.Test;
 
 /**
- * Tests the filesystem iterator.
- * <p>
- * TODO: This test requires libaocode.so, find a way to compile this and
- *       include in the LD_LIBRARY_PATH of the test runner.
- * </p>
+ * Tests the filesystem iterator.  Requires <code>libaocode.so</code>, see {@link NativeTest}.
  *
  * @author  AO Industries, Inc.
  */
 @SuppressWarnings("UseOfSystemOutOrSystemErr")
-public class FilesystemIteratorTestTODO extends TestCase {
-
-  public FilesystemIteratorTestTODO(String testName) {
-    super(testName);
-  }
-
-  private PosixFile tempDir;
+public class FilesystemIteratorTest extends NativeTest {
 
-  @Override
-  protected void setUp() throws Exception {
-    tempDir = new PosixFile(Files.createTempDirectory("FilesystemIteratorTest.").toFile());
+  @Before
+  public void setUp() throws IOException {
     PosixFile tmp = new PosixFile(tempDir, "tmp", true).mkdir(false, 0755);
     PosixFile tmpSomething = new PosixFile(tmp, "something", true);
     new FileOutputStream(tmpSomething.getFile()).close();
@@ -77,20 +67,21 @@ public class FilesystemIteratorTestTODO extends TestCase {
     homeAoadminBrokenlink.symLink("brokenlinknotarget");
   }
 
-  @Override
-  protected void tearDown() throws Exception {
-    tempDir.deleteRecursive();
-    tempDir = null;
-  }
-
-  public static Test suite() {
-    TestSuite suite = new TestSuite(FilesystemIteratorTestTODO.class);
-    return suite;
+  /**
+   * Gets the expected results for the parents of the temporary directory, which are iterated on the way to it.
+   */
+  private List<String> expectedParents() {
+    List<String> parents = new ArrayList<>();
+    for (File parent = tempDir.getFile().getParentFile(); parent != null; parent = parent.getParentFile()) {
+      parents.add(0, parent.getPath());
+    }
+    return parents;
   }
 
   /**
    * Without any rules the iterator should not return anything (defaults to exclude all).
    */
+  @Test
   public void testIteratorNone() throws IOException {
     Map<String, FilesystemIteratorRule> rules = Collections.emptyMap();
     Map<String, FilesystemIteratorRule> prefixRules = Collections.emptyMap();
@@ -105,10 +96,9 @@ public class FilesystemIteratorTestTODO extends TestCase {
   /**
    * Tests interate all.
    */
+  @Test
   public void testIterateAll() throws IOException {
-    List<String> expectedResults = new ArrayList<>();
-    expectedResults.add("/");
-    expectedResults.add("/tmp");
+    List<String> expectedResults = expectedParents();
     expectedResults.add(tempDir.getPath());
     expectedResults.add(tempDir.getPath() + "/home");
     expectedResults.add(tempDir.getPath() + "/home/a");
@@ -131,13 +121,12 @@ public class FilesystemIteratorTestTODO extends TestCase {
   /**
    * Tests include and skip.
    */
+  @Test
   public void testIncludeDirectoryAndSkipContents() throws IOException {
     Map<String, FilesystemIteratorRule> rules = new HashMap<>();
     rules.put(tempDir.getPath(), FilesystemIteratorRule.OK);
     rules.put(tempDir.getPath() + "/tmp/", FilesystemIteratorRule.SKIP);
-    List<String> expectedResults = new ArrayList<>();
-    expectedResults.add("/");
-    expectedResults.add("/tmp");
+    List<String> expectedResults = expectedParents();
     expectedResults.add(tempDir.getPath());
     expectedResults.add(tempDir.getPath() + "/home");
     expectedResults.add(tempDir.getPath() + "/home/a");
@@ -158,6 +147,7 @@ public class FilesystemIteratorTestTODO extends TestCase {
   /**
    * Test exists.
    */
+  @Test
   public void testFileExistsRuleExists() throws IOException {
     Map<String, FilesystemIteratorRule> rules = new HashMap<>();
     rules.put(tempDir.getPath(), FilesystemIteratorRule.OK);
@@ -165,9 +155,7 @@ public class FilesystemIteratorTestTODO extends TestCase {
         tempDir.getPath() + "/home/a/aoadmin/something",
         new FileExistsRule(new String[]{tempDir.getPath() + "/home/a/aoadmin/something2"}, FilesystemIteratorRule.SKIP, FilesystemIteratorRule.OK)
     );
-    List<String> expectedResults = new ArrayList<>();
-    expectedResults.add("/");
-    expectedResults.add("/tmp");
+    List<String> expectedResults = expectedParents();
     expectedResults.add(tempDir.getPath());
     expectedResults.add(tempDir.getPath() + "/home");
     expectedResults.add(tempDir.getPath() + "/home/a");
@@ -188,6 +176,7 @@ public class FilesystemIteratorTestTODO extends TestCase {
   /**
    * Tests not exists.
    */
+  @Test
   public void testFileExistsRuleNotExists() throws IOException {
     Map<String, FilesystemIteratorRule> rules = new HashMap<>();
     rules.put(tempDir.getPath(), FilesystemIteratorRule.OK);
@@ -195,9 +184,7 @@ public class FilesystemIteratorTestTODO extends TestCase {
         tempDir.getPath() + "/home/a/aoadmin/something",
         new FileExistsRule(new String[]{tempDir.getPath() + "/home/a/aoadmin/somethingNotHere"}, FilesystemIteratorRule.SKIP, FilesystemIteratorRule.OK)
     );
-    List<String> expectedResults = new ArrayList<>();
-    expectedResults.add("/");
-    expectedResults.add("/tmp");
+    List<String> expectedResults = expectedParents();
     expectedResults.add(tempDir.getPath());
     expectedResults.add(tempDir.getPath() + "/home");
     expectedResults.add(tempDir.getPath() + "/home/a");
@@ -219,6 +206,7 @@ public class FilesystemIteratorTestTODO extends TestCase {
   /**
    * Tests broken link.
    */
+  @Test
   public void testFileExistsRuleBrokenLink() throws IOException {
     Map<String, FilesystemIteratorRule> rules = new HashMap<>();
     rules.put(tempDir.getPath(), FilesystemIteratorRule.OK);
@@ -226,9 +214,7 @@ public class FilesystemIteratorTestTODO extends TestCase {
         tempDir.getPath() + "/home/a/aoadmin/something",
         new FileExistsRule(new String[]{tempDir.getPath() + "/home/a/aoadmin/brokenlink"}, FilesystemIteratorRule.SKIP, FilesystemIteratorRule.OK)
     );
-    List<String> expectedResults = new ArrayList<>();
-    expectedResults.add("/");
-    expectedResults.add("/tmp");
+    List<String> expectedResults = expectedParents();
     expectedResults.add(tempDir.getPath());
     expectedResults.add(tempDir.getPath() + "/home");
     expectedResults.add(tempDir.getPath() + "/home/a");
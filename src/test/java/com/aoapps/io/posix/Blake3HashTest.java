@@ -0,0 +1,102 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertEquals;
+
+import java.io.BufferedOutputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import org.junit.Test;
+
+/**
+ * Tests {@link PosixFile#getBlake3Hash()} against the official BLAKE3 test vectors, whose input is the repeating
+ * bytes <code>0, 1, ..., 250</code>.  The larger sizes, beyond the official vectors, fall on each side of the
+ * 16 MiB ranges hashed in parallel, with their hashes from the reference implementation.
+ *
+ * @author  AO Industries, Inc.
+ */
+public class Blake3HashTest extends NativeTest {
+
+  private static final long MIB = 1024 * 1024;
+
+  /**
+   * Hashes a new file of the test vector input of the given length.
+   */
+  private String hash(long length) throws IOException {
+    PosixFile file = new PosixFile(tempDir, "file", false);
+    try (OutputStream out = new BufferedOutputStream(new FileOutputStream(file.getFile()))) {
+      for (long i = 0; i < length; i++) {
+        out.write((int) (i % 251));
+      }
+    }
+    byte[] hash = file.getBlake3Hash();
+    StringBuilder hex = new StringBuilder(hash.length * 2);
+    for (byte b : hash) {
+      hex.append(Character.forDigit((b >> 4) & 0xf, 16)).append(Character.forDigit(b & 0xf, 16));
+    }
+    return hex.toString();
+  }
+
+  @Test
+  public void testEmpty() throws IOException {
+    assertEquals("af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262", hash(0));
+  }
+
+  @Test
+  public void testOneByte() throws IOException {
+    assertEquals("2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213", hash(1));
+  }
+
+  @Test
+  public void testOneChunk() throws IOException {
+    assertEquals("42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7", hash(1024));
+  }
+
+  @Test
+  public void testTwoChunks() throws IOException {
+    assertEquals("d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444", hash(1025));
+  }
+
+  @Test
+  public void testBelowOneRange() throws IOException {
+    assertEquals("397e524ebb0625e4322c06508780ab35db716b71641148327b61dc57396e035c", hash(16 * MIB - 1));
+  }
+
+  @Test
+  public void testOneRange() throws IOException {
+    assertEquals("869b1292c8bed5bdb2e0075e0c50ccf8b24b33a0f81071c86206bd8fdb269579", hash(16 * MIB));
+  }
+
+  @Test
+  public void testAboveOneRange() throws IOException {
+    assertEquals("3a734b24df8a7d6c13f0a980f06b74c9ffe3ea327dd5a23a3a108533c18684ff", hash(16 * MIB + 1));
+  }
+
+  @Test
+  public void testAboveThreeRanges() throws IOException {
+    assertEquals("e5bef239ca268ca64aba3035782207f98cc6d803a017be7b2a3f622bb60c53cb", hash(48 * MIB + 1));
+  }
+}
@@ -0,0 +1,204 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+
+import java.io.FileNotFoundException;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.nio.file.Files;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.List;
+import java.util.Random;
+import org.junit.Test;
+
+/**
+ * Tests {@link PosixFile#copyFiles(java.util.List, java.util.List, boolean)} and
+ * {@link PosixFile#contentEquals(java.util.List, java.util.List)} on the native worker pool.
+ *
+ * @author  AO Industries, Inc.
+ */
+public class BulkFilesTest extends NativeTest {
+
+  /**
+   * Sizes around the 1 MiB buffer of each worker.
+   */
+  private static final int[] SIZES = {0, 1, 4095, 4096, 1024 * 1024 - 1, 1024 * 1024, 1024 * 1024 + 1, 3 * 1024 * 1024 + 7};
+
+  private static final long[] MODES = {0644, 0600, 0755, 0444};
+
+  private final Random random = new Random(1);
+
+  private byte[] write(PosixFile file, int size) throws IOException {
+    byte[] contents = new byte[size];
+    random.nextBytes(contents);
+    try (OutputStream out = new FileOutputStream(file.getFile())) {
+      out.write(contents);
+    }
+    return contents;
+  }
+
+  /**
+   * Creates the sources, spread over a few directories so they may be queued on different nodes.
+   */
+  private List<PosixFile> createSources(int count, List<byte[]> contents) throws IOException {
+    List<PosixFile> sources = new ArrayList<>(count);
+    for (int i = 0; i < count; i++) {
+      PosixFile dir = new PosixFile(tempDir, "from" + (i % 4), false);
+      if (!dir.getStat().exists()) {
+        dir.mkdir();
+      }
+      PosixFile file = new PosixFile(dir, "file" + i, false);
+      contents.add(write(file, SIZES[i % SIZES.length]));
+      file.setMode(MODES[i % MODES.length]);
+      sources.add(file);
+    }
+    return sources;
+  }
+
+  private List<PosixFile> createTargets(int count) throws IOException {
+    PosixFile dir = new PosixFile(tempDir, "to", false).mkdir();
+    List<PosixFile> targets = new ArrayList<>(count);
+    for (int i = 0; i < count; i++) {
+      targets.add(new PosixFile(dir, "file" + i, false));
+    }
+    return targets;
+  }
+
+  @Test
+  public void testCopyFiles() throws IOException {
+    List<byte[]> contents = new ArrayList<>();
+    List<PosixFile> from = createSources(100, contents);
+    List<PosixFile> to = createTargets(100);
+    PosixFile.copyFiles(from, to, false);
+    for (int i = 0; i < 100; i++) {
+      PosixFile target = to.get(i);
+      assertArrayEquals(target.getPath(), contents.get(i), Files.readAllBytes(target.getFile().toPath()));
+      assertEquals(target.getPath(), from.get(i).getStat().getMode(), target.getStat().getMode());
+    }
+  }
+
+  @Test
+  public void testCopyFilesNoOverwrite() throws IOException {
+    List<PosixFile> from = createSources(10, new ArrayList<>());
+    List<PosixFile> to = createTargets(10);
+    byte[] existing = write(to.get(5), 10);
+    try {
+      PosixFile.copyFiles(from, to, false);
+      fail("Existing destination overwritten");
+    } catch (IOException e) {
+      // Expected
+    }
+    assertArrayEquals(existing, Files.readAllBytes(to.get(5).getFile().toPath()));
+  }
+
+  @Test
+  public void testCopyFilesOverwrite() throws IOException {
+    List<byte[]> contents = new ArrayList<>();
+    List<PosixFile> from = createSources(10, contents);
+    List<PosixFile> to = createTargets(10);
+    write(to.get(5), 5 * 1024 * 1024);
+    PosixFile.copyFiles(from, to, true);
+    assertArrayEquals(contents.get(5), Files.readAllBytes(to.get(5).getFile().toPath()));
+  }
+
+  /**
+   * The failure reported is the one that happened, not a copy skipped because of it, whatever the order of the
+   * pairs.
+   */
+  @Test
+  public void testCopyFilesReportsFailure() throws IOException {
+    for (int missing : new int[] {0, 100, 199}) {
+      List<PosixFile> from = createSources(200, new ArrayList<>());
+      List<PosixFile> to = createTargets(200);
+      from.get(missing).delete();
+      try {
+        PosixFile.copyFiles(from, to, false);
+        fail("Missing source copied");
+      } catch (FileNotFoundException e) {
+        assertTrue(e.getMessage(), e.getMessage().startsWith(from.get(missing).getPath() + ": "));
+      }
+      tempDir.deleteRecursive();
+      tempDir = createTempDir();
+    }
+  }
+
+  @Test
+  public void testContentEquals() throws IOException {
+    List<byte[]> contents = new ArrayList<>();
+    List<PosixFile> files1 = createSources(40, contents);
+    List<PosixFile> files2 = createTargets(40);
+    boolean[] expected = new boolean[40];
+    for (int i = 0; i < 40; i++) {
+      byte[] bytes = contents.get(i).clone();
+      switch (i % 4) {
+        case 0:
+          // Equal
+          expected[i] = true;
+          break;
+        case 1:
+          // Last byte differs
+          if (bytes.length > 0) {
+            bytes[bytes.length - 1]++;
+          } else {
+            expected[i] = true;
+          }
+          break;
+        case 2:
+          // Longer
+          bytes = Arrays.copyOf(bytes, bytes.length + 1);
+          break;
+        default:
+          // First byte differs
+          if (bytes.length > 0) {
+            bytes[0]++;
+          } else {
+            expected[i] = true;
+          }
+      }
+      try (OutputStream out = new FileOutputStream(files2.get(i).getFile())) {
+        out.write(bytes);
+      }
+    }
+    assertArrayEquals(expected, PosixFile.contentEquals(files1, files2));
+  }
+
+  @Test
+  public void testEmpty() throws IOException {
+    PosixFile.copyFiles(Collections.emptyList(), Collections.emptyList(), false);
+    assertEquals(0, PosixFile.contentEquals(Collections.emptyList(), Collections.emptyList()).length);
+  }
+
+  @Test(expected = IllegalArgumentException.class)
+  public void testSizeMismatch() throws IOException {
+    PosixFile.copyFiles(Collections.singletonList(new PosixFile(tempDir, "a", false)), Collections.emptyList(), false);
+  }
+}
@@ -0,0 +1,100 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+
+import java.io.FileOutputStream;
+import java.io.IOException;
+import org.junit.Before;
+import org.junit.Test;
+
+/**
+ * Tests {@link PosixFile#getCacheResidency(long, long)}.
+ *
+ * @author  AO Industries, Inc.
+ */
+public class CacheResidencyTest extends NativeTest {
+
+  private long pageSize;
+  private PosixFile file;
+
+  @Before
+  public void setUp() throws IOException {
+    pageSize = MappedRegion.getPageSize();
+    file = new PosixFile(tempDir, "file", false);
+    try (FileOutputStream out = new FileOutputStream(file.getFile())) {
+      out.write(new byte[(int) (10 * pageSize + 1)]);
+    }
+  }
+
+  private static void assertUnknownOrAtLeastZero(long count) {
+    assertTrue(Long.toString(count), count >= -1);
+  }
+
+  /**
+   * Just written, so every page is cached, whether still dirty or not.
+   */
+  @Test
+  public void testWholeFile() throws IOException {
+    CacheResidency residency = file.getCacheResidency(0, 0);
+    assertEquals(11, residency.getPages());
+    assertEquals(11, residency.getCached());
+    assertTrue(residency.isFullyCached());
+    assertUnknownOrAtLeastZero(residency.getDirty());
+    assertUnknownOrAtLeastZero(residency.getWriteback());
+    assertUnknownOrAtLeastZero(residency.getEvicted());
+    assertUnknownOrAtLeastZero(residency.getRecentlyEvicted());
+  }
+
+  /**
+   * The range is widened to whole pages and limited to the end of the file.
+   */
+  @Test
+  public void testRange() throws IOException {
+    assertEquals(1, file.getCacheResidency(pageSize + 1, 1).getPages());
+    assertEquals(2, file.getCacheResidency(pageSize - 1, 2).getPages());
+    assertEquals(2, file.getCacheResidency(9 * pageSize, 100 * pageSize).getPages());
+    assertEquals(0, file.getCacheResidency(20 * pageSize, pageSize).getPages());
+  }
+
+  @Test
+  public void testEmpty() throws IOException {
+    PosixFile empty = new PosixFile(tempDir, "empty", false);
+    new FileOutputStream(empty.getFile()).close();
+    CacheResidency residency = empty.getCacheResidency(0, 0);
+    assertEquals(0, residency.getPages());
+    assertTrue(residency.isFullyCached());
+  }
+
+  @Test(expected = IllegalArgumentException.class)
+  public void testNegativeOffset() throws IOException {
+    file.getCacheResidency(-1, 0);
+  }
+
+  @Test(expected = IOException.class)
+  public void testNotRegular() throws IOException {
+    tempDir.getCacheResidency(0, 0);
+  }
+}
@@ -0,0 +1,242 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+import static org.junit.Assume.assumeNoException;
+
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.charset.StandardCharsets;
+import java.util.Arrays;
+import org.junit.Test;
+
+/**
+ * Tests the checkpointed recursive operations, interrupting a delete with an entry that cannot be removed.
+ *
+ * @author  AO Industries, Inc.
+ */
+public class CheckpointTest extends NativeTest {
+
+  private static final String INVALID = "Checkpoint is invalid or from another operation: ";
+
+  @FunctionalInterface
+  private static interface IOAction {
+    void run() throws IOException;
+  }
+
+  /**
+   * Asserts that a walk fails, such as on an entry that cannot be removed.  Failures are reported by errno, not all
+   * of which are an {@link IOException}.
+   */
+  private static void assertFails(IOAction action) throws IOException {
+    try {
+      action.run();
+      fail("Walk completed");
+    } catch (IOException | RuntimeException e) {
+      // Expected
+    }
+  }
+
+  /**
+   * Asserts that a checkpoint is rejected.
+   */
+  private static void assertRejected(File checkpoint, IOAction action) throws IOException {
+    try {
+      action.run();
+      fail("Checkpoint accepted");
+    } catch (IOException e) {
+      assertEquals(INVALID + checkpoint.getPath(), e.getMessage());
+    }
+  }
+
+  private static PosixFile newFile(PosixFile dir, String name) throws IOException {
+    PosixFile file = new PosixFile(dir, name, false);
+    new FileOutputStream(file.getFile()).close();
+    return file;
+  }
+
+  /**
+   * Creates a tree, in name order, of the files a0 through a9, the directory m holding the files x and y, and the
+   * files z0 through z9.
+   */
+  private PosixFile createTree() throws IOException {
+    PosixFile root = new PosixFile(tempDir, "root", false).mkdir();
+    for (int i = 0; i < 10; i++) {
+      newFile(root, "a" + i);
+    }
+    PosixFile m = new PosixFile(root, "m", false).mkdir();
+    newFile(m, "x");
+    newFile(m, "y");
+    for (int i = 0; i < 10; i++) {
+      newFile(root, "z" + i);
+    }
+    return root;
+  }
+
+  private static boolean isRoot() {
+    return "root".equals(System.getProperty("user.name"));
+  }
+
+  /**
+   * Makes m/x impossible to remove: immutable when running as root, otherwise by making m read-only.
+   */
+  private static void block(PosixFile root) throws IOException {
+    PosixFile m = new PosixFile(root, "m", false);
+    if (isRoot()) {
+      try {
+        new PosixFile(m, "x", false).chattr(PosixFile.FLAG_IMMUTABLE, 0);
+      } catch (IOException e) {
+        assumeNoException("Inode flags not supported", e);
+      }
+    } else {
+      m.setMode(0555);
+    }
+  }
+
+  private static void unblock(PosixFile root) throws IOException {
+    PosixFile m = new PosixFile(root, "m", false);
+    if (isRoot()) {
+      new PosixFile(m, "x", false).chattr(0, PosixFile.FLAG_IMMUTABLE);
+    } else {
+      m.setMode(0755);
+    }
+  }
+
+  private static String[] list(PosixFile dir) throws IOException {
+    String[] names = dir.list();
+    Arrays.sort(names);
+    return names;
+  }
+
+  /**
+   * Deletes until stopped on m/x, leaving a checkpoint.
+   */
+  private File interruptDelete(PosixFile root) throws IOException {
+    File checkpoint = new File(tempDir.getFile(), "checkpoint");
+    block(root);
+    assertFails(() -> root.deleteRecursive(checkpoint));
+    unblock(root);
+    assertTrue(checkpoint.exists());
+    // Stopped in name order, after the a* files and before the z* files
+    String[] expected = new String[11];
+    expected[0] = "m";
+    for (int i = 0; i < 10; i++) {
+      expected[i + 1] = "z" + i;
+    }
+    assertEquals(Arrays.asList(expected), Arrays.asList(list(root)));
+    assertEquals(Arrays.asList("x", "y"), Arrays.asList(list(new PosixFile(root, "m", false))));
+    return checkpoint;
+  }
+
+  @Test
+  public void testCompleteRemovesCheckpoint() throws IOException {
+    PosixFile root = createTree();
+    File checkpoint = new File(tempDir.getFile(), "checkpoint");
+    root.deleteRecursive(checkpoint);
+    assertFalse(root.getStat().exists());
+    assertFalse(checkpoint.exists());
+  }
+
+  @Test
+  public void testResume() throws IOException {
+    PosixFile root = createTree();
+    File checkpoint = interruptDelete(root);
+    root.deleteRecursive(checkpoint);
+    assertFalse(root.getStat().exists());
+    assertFalse(checkpoint.exists());
+  }
+
+  /**
+   * The entries finished before the checkpoint are not read again, so an entry added among them is not deleted,
+   * while one added after the checkpoint is.
+   */
+  @Test
+  public void testResumeOnlyRemaining() throws IOException {
+    PosixFile root = createTree();
+    File checkpoint = interruptDelete(root);
+    newFile(root, "a-new");
+    newFile(root, "z-new");
+    // The directory is not empty because of the entry added before the checkpoint
+    assertFails(() -> root.deleteRecursive(checkpoint));
+    assertEquals(Arrays.asList("a-new"), Arrays.asList(list(root)));
+    new PosixFile(root, "a-new", false).delete();
+    root.deleteRecursive(checkpoint);
+    assertFalse(root.getStat().exists());
+    assertFalse(checkpoint.exists());
+  }
+
+  @Test
+  public void testRejectCorrupt() throws IOException {
+    PosixFile root = createTree();
+    File checkpoint = new File(tempDir.getFile(), "checkpoint");
+    try (FileOutputStream out = new FileOutputStream(checkpoint)) {
+      out.write("not a checkpoint".getBytes(StandardCharsets.US_ASCII));
+    }
+    assertRejected(checkpoint, () -> root.deleteRecursive(checkpoint));
+    // Nothing deleted
+    assertEquals(21, root.list().length);
+  }
+
+  @Test
+  public void testRejectTruncated() throws IOException {
+    PosixFile root = createTree();
+    File checkpoint = interruptDelete(root);
+    try (RandomAccessFile raf = new RandomAccessFile(checkpoint, "rw")) {
+      raf.setLength(raf.length() - 1);
+    }
+    assertRejected(checkpoint, () -> root.deleteRecursive(checkpoint));
+    assertEquals(11, root.list().length);
+  }
+
+  @Test
+  public void testRejectOtherOperation() throws IOException {
+    PosixFile root = createTree();
+    File checkpoint = interruptDelete(root);
+    assertRejected(checkpoint, () -> root.chattr(PosixFile.FLAG_NO_DUMP, 0, checkpoint));
+  }
+
+  @Test
+  public void testRejectOtherOptions() throws IOException {
+    PosixFile root = createTree();
+    File checkpoint = interruptDelete(root);
+    assertRejected(checkpoint, () -> root.deleteRecursive(checkpoint, WalkOption.INODE_ORDER));
+    assertRejected(checkpoint, () -> root.deleteRecursive(checkpoint, WalkOption.ONE_FILE_SYSTEM));
+  }
+
+  @Test
+  public void testRejectOtherTree() throws IOException {
+    PosixFile root = createTree();
+    File checkpoint = interruptDelete(root);
+    PosixFile other = new PosixFile(tempDir, "other", false).mkdir();
+    newFile(other, "file");
+    assertRejected(checkpoint, () -> other.deleteRecursive(checkpoint));
+    assertEquals(1, other.list().length);
+  }
+}
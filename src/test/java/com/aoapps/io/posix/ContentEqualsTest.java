@@ -0,0 +1,128 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.util.Random;
+import org.junit.Before;
+import org.junit.Test;
+
+/**
+ * Tests {@link PosixFile#contentEquals(com.aoapps.io.posix.PosixFile)} and
+ * {@link PosixFile#contentEqualsParallel(com.aoapps.io.posix.PosixFile)}.
+ *
+ * @author  AO Industries, Inc.
+ */
+public class ContentEqualsTest extends NativeTest {
+
+  /**
+   * Three of the 16 MiB ranges compared in parallel, the last partial.
+   */
+  private static final int FILE_SIZE = 32 * 1024 * 1024 + 4097;
+
+  private PosixFile file1;
+  private PosixFile file2;
+  private byte[] contents;
+
+  @Before
+  public void setUp() throws IOException {
+    file1 = new PosixFile(tempDir, "file1", false);
+    file2 = new PosixFile(tempDir, "file2", false);
+    contents = new byte[FILE_SIZE];
+    new Random(1).nextBytes(contents);
+    write(file1, contents);
+  }
+
+  private static void write(PosixFile file, byte[] data) throws IOException {
+    try (FileOutputStream out = new FileOutputStream(file.getFile())) {
+      out.write(data);
+    }
+  }
+
+  /**
+   * Replaces a file with 64 MiB that is a hole except for a few bytes in the middle and the given last bytes.
+   */
+  private static void writeSparse(PosixFile file, String last) throws IOException {
+    long size = 64L * 1024 * 1024;
+    try (RandomAccessFile raf = new RandomAccessFile(file.getFile(), "rw")) {
+      raf.setLength(0);
+      raf.setLength(size);
+      raf.seek(20L * 1024 * 1024);
+      raf.writeBytes("hello");
+      raf.seek(size - last.length());
+      raf.writeBytes(last);
+    }
+  }
+
+  @Test
+  public void testEqualCopy() throws IOException {
+    write(file2, contents);
+    assertTrue(file1.contentEquals(file2));
+    assertTrue(file1.contentEqualsParallel(file2));
+  }
+
+  @Test
+  public void testLastByteDiffers() throws IOException {
+    contents[FILE_SIZE - 1] ^= 1;
+    write(file2, contents);
+    assertFalse(file1.contentEquals(file2));
+    assertFalse(file1.contentEqualsParallel(file2));
+  }
+
+  @Test
+  public void testFirstByteOfLastRangeDiffers() throws IOException {
+    contents[32 * 1024 * 1024] ^= (byte) 0x80;
+    write(file2, contents);
+    assertFalse(file1.contentEquals(file2));
+    assertFalse(file1.contentEqualsParallel(file2));
+  }
+
+  @Test
+  public void testSameInode() throws IOException {
+    PosixFile link = new PosixFile(tempDir, "link", false).link(file1);
+    assertTrue(file1.contentEquals(link));
+    assertTrue(file1.contentEqualsParallel(link));
+  }
+
+  @Test
+  public void testSparseEqual() throws IOException {
+    writeSparse(file1, "world");
+    writeSparse(file2, "world");
+    assertTrue(file1.contentEquals(file2));
+    assertTrue(file1.contentEqualsParallel(file2));
+  }
+
+  @Test
+  public void testSparseLastByteDiffers() throws IOException {
+    writeSparse(file1, "world");
+    writeSparse(file2, "worle");
+    assertFalse(file1.contentEquals(file2));
+    assertFalse(file1.contentEqualsParallel(file2));
+  }
+}
@@ -0,0 +1,121 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import java.nio.file.attribute.FileTime;
+import java.nio.file.attribute.PosixFilePermissions;
+import java.security.GeneralSecurityException;
+import java.security.MessageDigest;
+import java.security.NoSuchAlgorithmException;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+/**
+ * Tests the checks of a previously extracted library before it is reused.  Does not need <code>libaocode.so</code>.
+ *
+ * @author  AO Industries, Inc.
+ */
+public class ExtractLibraryTest {
+
+  private static final byte[] LIBRARY = {0x7f, 'E', 'L', 'F', 2, 1, 1, 0};
+
+  private Path dir;
+  private Path file;
+  private byte[] digest;
+  private FileTime stamp;
+  private int uid;
+
+  @Before
+  public void setUp() throws IOException, NoSuchAlgorithmException {
+    dir = Files.createTempDirectory("ExtractLibraryTest.");
+    file = dir.resolve("libaocode.so");
+    Files.write(file, LIBRARY);
+    Files.setPosixFilePermissions(file, PosixFilePermissions.fromString("rwxr-xr-x"));
+    digest = MessageDigest.getInstance("SHA-256").digest(LIBRARY);
+    stamp = PosixFile.getExtractedTime(digest);
+    Files.setLastModifiedTime(file, stamp);
+    uid = (Integer) Files.getAttribute(Paths.get("/proc/self"), "unix:uid");
+  }
+
+  @After
+  public void tearDown() throws IOException {
+    Files.deleteIfExists(dir.resolve("link"));
+    Files.deleteIfExists(file);
+    Files.delete(dir);
+  }
+
+  private boolean isExtracted(Path path) throws IOException, GeneralSecurityException {
+    return PosixFile.isExtracted(path, LIBRARY.length, digest, stamp, uid);
+  }
+
+  @Test
+  public void testIntact() throws Exception {
+    assertTrue(isExtracted(file));
+  }
+
+  /**
+   * A copy with another modification time is verified by its SHA-256, then given the time it was extracted with.
+   */
+  @Test
+  public void testIntactOtherTime() throws Exception {
+    Files.setLastModifiedTime(file, FileTime.fromMillis(System.currentTimeMillis()));
+    assertTrue(isExtracted(file));
+    assertEquals(stamp, Files.getLastModifiedTime(file));
+  }
+
+  @Test
+  public void testModified() throws Exception {
+    byte[] modified = LIBRARY.clone();
+    modified[7] = 1;
+    Files.write(file, modified);
+    assertFalse(isExtracted(file));
+  }
+
+  @Test
+  public void testTruncated() throws Exception {
+    Files.write(file, new byte[] {0x7f});
+    assertFalse(isExtracted(file));
+  }
+
+  @Test
+  public void testWritableByOthers() throws Exception {
+    Files.setPosixFilePermissions(file, PosixFilePermissions.fromString("rwxrwxr-x"));
+    assertFalse(isExtracted(file));
+  }
+
+  @Test
+  public void testSymbolicLink() throws Exception {
+    Path link = Files.createSymbolicLink(dir.resolve("link"), file);
+    assertFalse(isExtracted(link));
+  }
+}
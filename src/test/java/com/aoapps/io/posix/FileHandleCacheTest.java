@@ -0,0 +1,230 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+
+import java.io.ByteArrayOutputStream;
+import java.io.File;
+import java.io.FileNotFoundException;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Paths;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+/**
+ * Tests {@link FileHandleCache}.
+ *
+ * @author  AO Industries, Inc.
+ */
+public class FileHandleCacheTest extends NativeTest {
+
+  private FileHandleCache cache;
+  private PosixFile dir;
+  private PosixFile file;
+
+  @Before
+  public void setUp() throws IOException {
+    cache = new FileHandleCache(16);
+    dir = new PosixFile(tempDir, "dir", false).mkdir();
+    file = new PosixFile(dir, "file", false);
+    write(file, "first", false);
+  }
+
+  @After
+  public void tearDown() throws IOException {
+    cache.close();
+  }
+
+  private static void write(PosixFile file, String contents, boolean append) throws IOException {
+    try (FileOutputStream out = new FileOutputStream(file.getFile(), append)) {
+      out.write(contents.getBytes(StandardCharsets.US_ASCII));
+    }
+  }
+
+  /**
+   * Reads the whole file through the cache.
+   */
+  private String read(PosixFile file) throws IOException {
+    try (FileHandleCache.Lease lease = cache.open(file)) {
+      ByteArrayOutputStream bout = new ByteArrayOutputStream();
+      try (InputStream in = lease.getInputStream()) {
+        byte[] buff = new byte[4096];
+        int count;
+        while ((count = in.read(buff)) != -1) {
+          bout.write(buff, 0, count);
+        }
+      }
+      assertEquals(bout.size(), lease.getSize());
+      return new String(bout.toByteArray(), StandardCharsets.US_ASCII);
+    }
+  }
+
+  /**
+   * Counts the file descriptors of this process open on the given path, including after it has been removed.
+   */
+  private static int countOpen(PosixFile file) throws IOException {
+    String path = file.getPath();
+    int count = 0;
+    File[] fds = new File("/proc/self/fd").listFiles();
+    if (fds == null) {
+      throw new AssertionError("/proc/self/fd not available");
+    }
+    for (File fd : fds) {
+      String target;
+      try {
+        target = Files.readSymbolicLink(fd.toPath()).toString();
+      } catch (IOException e) {
+        // Closed since listed
+        continue;
+      }
+      if (target.equals(path) || target.equals(path + " (deleted)")) {
+        count++;
+      }
+    }
+    return count;
+  }
+
+  /**
+   * Repeated opens share one file descriptor.
+   */
+  @Test
+  public void testHit() throws IOException {
+    for (int i = 0; i < 100; i++) {
+      assertEquals("first", read(file));
+    }
+    assertEquals(1, cache.size());
+    assertEquals(1, countOpen(file));
+  }
+
+  @Test
+  public void testModified() throws IOException {
+    assertEquals("first", read(file));
+    write(file, ", second", true);
+    assertEquals("first, second", read(file));
+    assertEquals(1, cache.size());
+    assertEquals(1, countOpen(file));
+  }
+
+  /**
+   * A lease keeps reading the file it opened, which is closed once the lease is.
+   */
+  @Test
+  public void testReplacedWhileLeased() throws IOException {
+    try (FileHandleCache.Lease lease = cache.open(file)) {
+      PosixFile temp = new PosixFile(dir, "temp", false);
+      write(temp, "replaced", false);
+      temp.renameTo(file);
+      assertEquals("replaced", read(file));
+      byte[] buff = new byte[5];
+      assertEquals(5, lease.read(0, buff, 0, 5));
+      assertArrayEquals("first".getBytes(StandardCharsets.US_ASCII), buff);
+      assertEquals(2, countOpen(file));
+    }
+    assertEquals(1, countOpen(file));
+  }
+
+  @Test
+  public void testParentRenamed() throws IOException {
+    assertEquals("first", read(file));
+    dir.renameTo(new PosixFile(tempDir, "moved", false));
+    dir.mkdir();
+    write(file, "new", false);
+    assertEquals("new", read(file));
+    assertEquals(1, cache.size());
+  }
+
+  @Test
+  public void testDeleted() throws IOException {
+    assertEquals("first", read(file));
+    file.delete();
+    try {
+      read(file);
+      fail("Read a deleted file");
+    } catch (FileNotFoundException e) {
+      // Expected
+    }
+    assertEquals(0, cache.size());
+    assertEquals(0, countOpen(file));
+  }
+
+  @Test
+  public void testNotRegular() throws IOException {
+    try {
+      read(dir);
+      fail("Read a directory");
+    } catch (FileNotFoundException e) {
+      throw e;
+    } catch (IOException e) {
+      assertEquals("Not a regular file: " + dir.getPath(), e.getMessage());
+    }
+    assertEquals(0, cache.size());
+  }
+
+  private void assertSymlinkRefused(PosixFile path) throws IOException {
+    try {
+      read(path);
+      fail("Read through a symbolic link: " + path);
+    } catch (FileNotFoundException e) {
+      throw e;
+    } catch (IOException e) {
+      assertEquals("Symbolic link found in path: " + path.getPath(), e.getMessage());
+    }
+  }
+
+  @Test
+  public void testSymlinkLeaf() throws IOException {
+    PosixFile link = new PosixFile(dir, "link", false).symLink("file");
+    assertSymlinkRefused(link);
+    assertEquals(0, cache.size());
+  }
+
+  @Test
+  public void testSymlinkParent() throws IOException {
+    new PosixFile(tempDir, "dirlink", false).symLink("dir");
+    assertSymlinkRefused(new PosixFile(tempDir, "dirlink/file", false));
+    assertEquals(0, cache.size());
+  }
+
+  /**
+   * A cached path that now passes through a symbolic link is refused, even though it leads to the same file.
+   */
+  @Test
+  public void testSymlinkAfterCached() throws IOException {
+    assertEquals("first", read(file));
+    PosixFile moved = new PosixFile(tempDir, "moved", false);
+    dir.renameTo(moved);
+    dir.symLink("moved");
+    assertTrue(Files.isSameFile(Paths.get(file.getPath()), Paths.get(moved.getPath(), "file")));
+    assertSymlinkRefused(file);
+    assertEquals(0, cache.size());
+  }
+}
@@ -0,0 +1,131 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assume.assumeNoException;
+
+import java.io.FileInputStream;
+import java.io.FileNotFoundException;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import org.junit.Before;
+import org.junit.Test;
+
+/**
+ * Tests {@link PosixFile#getFileHandle()} and {@link PosixFile#openByHandle(com.aoapps.io.posix.FileHandle)}.
+ * Opening is skipped without the <code>CAP_DAC_READ_SEARCH</code> capability, and everything is skipped on
+ * filesystems without persistent handles.
+ *
+ * @author  AO Industries, Inc.
+ */
+public class FileHandleTest extends NativeTest {
+
+  private PosixFile file;
+  private FileHandle handle;
+
+  @Before
+  public void setUp() throws IOException {
+    file = new PosixFile(tempDir, "file", false);
+    try (FileOutputStream out = new FileOutputStream(file.getFile())) {
+      out.write(new byte[] {1, 2, 3});
+    }
+    try {
+      handle = file.getFileHandle();
+    } catch (IOException e) {
+      assumeNoException("Persistent handles not supported", e);
+    }
+  }
+
+  /**
+   * Opens the file by its handle, skipping the test without the capability to.
+   */
+  private FileInputStream open() throws IOException {
+    try {
+      return PosixFile.openByHandle(handle);
+    } catch (FileNotFoundException e) {
+      throw e;
+    } catch (IOException e) {
+      assumeNoException("CAP_DAC_READ_SEARCH required", e);
+      throw e;
+    }
+  }
+
+  @Test
+  public void testEncoding() {
+    assertTrue(handle.getMountId() > 0);
+    assertEquals(handle, FileHandle.valueOf(handle.toByteArray()));
+  }
+
+  @Test
+  public void testOpen() throws IOException {
+    try (FileInputStream in = open()) {
+      assertEquals(1, in.read());
+      assertEquals(2, in.read());
+      assertEquals(3, in.read());
+      assertEquals(-1, in.read());
+    }
+  }
+
+  @Test(expected = FileNotFoundException.class)
+  public void testDeleted() throws IOException {
+    open().close();
+    file.delete();
+    open().close();
+  }
+
+  /**
+   * Many threads sharing the cached mount descriptor, which must stay open while any of them is using it.
+   */
+  @Test
+  public void testConcurrent() throws Exception {
+    open().close();
+    ExecutorService executor = Executors.newFixedThreadPool(8);
+    try {
+      List<Future<Integer>> futures = new ArrayList<>();
+      for (int i = 0; i < 8; i++) {
+        futures.add(executor.submit(() -> {
+          int sum = 0;
+          for (int j = 0; j < 500; j++) {
+            try (FileInputStream in = PosixFile.openByHandle(handle)) {
+              sum += in.read();
+            }
+          }
+          return sum;
+        }));
+      }
+      for (Future<Integer> future : futures) {
+        assertEquals(Integer.valueOf(500), future.get());
+      }
+    } finally {
+      executor.shutdownNow();
+    }
+  }
+}
@@ -0,0 +1,102 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assume.assumeNoException;
+import static org.junit.Assume.assumeTrue;
+
+import java.io.FileOutputStream;
+import java.io.IOException;
+import org.junit.Test;
+
+/**
+ * Tests the inode flags of {@link PosixFile#getFlags()} and <code>chattr</code>, and the
+ * <code>statx</code> attributes of {@link Stat}.  The flags tests are skipped on filesystems without inode flags, such
+ * as <code>tmpfs</code> on older kernels.
+ *
+ * @author  AO Industries, Inc.
+ */
+public class InodeFlagsTest extends NativeTest {
+
+  private PosixFile newFile(PosixFile dir, String name) throws IOException {
+    PosixFile file = new PosixFile(dir, name, false);
+    new FileOutputStream(file.getFile()).close();
+    return file;
+  }
+
+  /**
+   * Adds the no dump flag, skipping the test when the filesystem does not support inode flags.
+   */
+  private static void addNoDump(PosixFile file, boolean recursive) throws IOException {
+    try {
+      file.chattr(PosixFile.FLAG_NO_DUMP, 0, recursive);
+    } catch (IOException e) {
+      assumeNoException("Inode flags not supported", e);
+    }
+  }
+
+  @Test
+  public void testAddAndRemove() throws IOException {
+    PosixFile file = newFile(tempDir, "file");
+    addNoDump(file, false);
+    assertEquals(PosixFile.FLAG_NO_DUMP, file.getFlags() & PosixFile.FLAG_NO_DUMP);
+    Stat stat = file.getStat();
+    if ((stat.getAttributesMask() & Stat.ATTR_NO_DUMP) != 0) {
+      assertTrue(stat.isNoDump());
+    }
+    file.chattr(0, PosixFile.FLAG_NO_DUMP);
+    assertEquals(0, file.getFlags() & PosixFile.FLAG_NO_DUMP);
+    stat = file.getStat();
+    if ((stat.getAttributesMask() & Stat.ATTR_NO_DUMP) != 0) {
+      assertFalse(stat.isNoDump());
+    }
+  }
+
+  @Test
+  public void testRecursive() throws IOException {
+    PosixFile dir = new PosixFile(tempDir, "dir", false).mkdir();
+    PosixFile sub = new PosixFile(dir, "sub", false).mkdir();
+    PosixFile file1 = newFile(dir, "file1");
+    PosixFile file2 = newFile(sub, "file2");
+    PosixFile outside = newFile(tempDir, "outside");
+    new PosixFile(sub, "link", false).symLink("../../outside");
+    addNoDump(dir, true);
+    for (PosixFile file : new PosixFile[] {dir, sub, file1, file2}) {
+      assertEquals(file.getPath(), PosixFile.FLAG_NO_DUMP, file.getFlags() & PosixFile.FLAG_NO_DUMP);
+    }
+    // The symbolic link is not followed
+    assertEquals(0, outside.getFlags() & PosixFile.FLAG_NO_DUMP);
+  }
+
+  @Test
+  public void testNotMountRoot() throws IOException {
+    Stat stat = tempDir.getStat();
+    assumeTrue((stat.getAttributesMask() & Stat.ATTR_MOUNT_ROOT) != 0);
+    assertFalse(stat.isMountRoot());
+    assertTrue(new PosixFile("/").getStat().isMountRoot());
+  }
+}
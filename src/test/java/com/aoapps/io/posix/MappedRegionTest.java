@@ -0,0 +1,131 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.fail;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.ClosedChannelException;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Paths;
+import org.junit.Before;
+import org.junit.Test;
+
+/**
+ * Tests the lifetime of the memory of a {@link MappedRegion} and its windows.
+ *
+ * @author  AO Industries, Inc.
+ */
+public class MappedRegionTest extends NativeTest {
+
+  private PosixFile file;
+  private long size;
+
+  @Before
+  public void setUp() throws IOException {
+    file = new PosixFile(tempDir, "file", false);
+    size = 4 * MappedRegion.getPageSize();
+    try (PosixFileHandle handle = PosixFileHandle.open(file, PosixFileHandle.O_RDWR | PosixFileHandle.O_CREAT, 0600)) {
+      handle.truncate(size);
+    }
+  }
+
+  private MappedRegion mapReadWrite() throws IOException {
+    try (PosixFileHandle handle = PosixFileHandle.open(file, PosixFileHandle.O_RDWR, 0)) {
+      return handle.map(0, size, 0);
+    }
+  }
+
+  /**
+   * Counts the mappings of this process of the file.
+   */
+  private int countMappings() throws IOException {
+    int count = 0;
+    for (String line : Files.readAllLines(Paths.get("/proc/self/maps"), StandardCharsets.ISO_8859_1)) {
+      if (line.endsWith(' ' + file.getPath()) || line.endsWith(' ' + file.getPath() + " (deleted)")) {
+        count++;
+      }
+    }
+    return count;
+  }
+
+  /**
+   * A window remains mapped and usable after its region is closed, and is unmapped once unreachable.
+   */
+  @Test
+  public void testWindowOutlivesClose() throws Exception {
+    ByteBuffer window;
+    try (MappedRegion region = mapReadWrite()) {
+      window = region.getBuffer(MappedRegion.getPageSize() + 1, 4);
+    }
+    window.put(0, (byte) 1).put(3, (byte) 4);
+    assertEquals(1, window.get(0));
+    assertEquals(4, window.get(3));
+    // Written through to the file
+    byte[] contents = Files.readAllBytes(Paths.get(file.getPath()));
+    assertEquals(1, contents[(int) MappedRegion.getPageSize() + 1]);
+    assertEquals(4, contents[(int) MappedRegion.getPageSize() + 4]);
+    assertEquals(1, countMappings());
+    window = null;
+    awaitUnmapped();
+  }
+
+  @Test
+  public void testClosedRegion() throws IOException {
+    MappedRegion region = mapReadWrite();
+    region.close();
+    region.close();
+    assertEquals(0, countMappings());
+    try {
+      region.getBuffer(0, 1);
+      fail("ClosedChannelException expected");
+    } catch (ClosedChannelException e) {
+      // Expected
+    }
+  }
+
+  /**
+   * A region that becomes unreachable without being closed is unmapped by the daemon thread, without another
+   * region being mapped or closed.
+   */
+  @Test
+  public void testLeakUnmapped() throws Exception {
+    mapReadWrite().getBuffer(0, 1);
+    assertEquals(1, countMappings());
+    awaitUnmapped();
+  }
+
+  private void awaitUnmapped() throws Exception {
+    long deadline = System.currentTimeMillis() + 30000;
+    while (countMappings() != 0) {
+      if (System.currentTimeMillis() >= deadline) {
+        fail("Not unmapped: " + file);
+      }
+      System.gc();
+      Thread.sleep(10);
+    }
+  }
+}
@@ -0,0 +1,87 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import static org.junit.Assume.assumeNoException;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.BeforeClass;
+
+/**
+ * The fixture shared by the tests of <code>libaocode.so</code>: loads the library once and gives each test its own
+ * temporary directory, removed after the test.
+ * <p>
+ * The tests are skipped when the library cannot be loaded, unless {@link #REQUIRED_PROPERTY} is {@code true}, such as
+ * in the <code>native</code> profile, where they fail instead.
+ * </p>
+ *
+ * @author  AO Industries, Inc.
+ */
+public abstract class NativeTest {
+
+  /**
+   * The system property that makes the tests fail instead of being skipped when the library cannot be loaded.
+   */
+  public static final String REQUIRED_PROPERTY = NativeTest.class.getName() + ".required";
+
+  @BeforeClass
+  public static void loadLibrary() {
+    try {
+      PosixFile.loadLibrary();
+    } catch (UnsatisfiedLinkError e) {
+      if (Boolean.getBoolean(REQUIRED_PROPERTY)) {
+        throw e;
+      }
+      assumeNoException("libaocode.so not available", e);
+    }
+  }
+
+  /**
+   * The temporary directory of the current test.
+   */
+  protected PosixFile tempDir;
+
+  /**
+   * Creates the temporary directory of each test, in the default temporary-file directory.
+   */
+  protected PosixFile createTempDir() throws IOException {
+    return new PosixFile(Files.createTempDirectory(getClass().getSimpleName() + '.').toFile());
+  }
+
+  @Before
+  public final void setUpTempDir() throws IOException {
+    tempDir = createTempDir();
+  }
+
+  @After
+  public final void tearDownTempDir() throws IOException {
+    if (tempDir != null && tempDir.getStat().exists()) {
+      tempDir.deleteRecursive();
+    }
+    tempDir = null;
+  }
+}
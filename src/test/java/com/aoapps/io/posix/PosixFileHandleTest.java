@@ -0,0 +1,197 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.fail;
+
+import java.io.IOException;
+import java.nio.ByteBuffer;
+import java.nio.channels.ClosedChannelException;
+import java.nio.channels.FileChannel;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.NoSuchFileException;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+import org.junit.Before;
+import org.junit.Test;
+
+/**
+ * Tests {@link PosixFileHandle}.
+ *
+ * @author  AO Industries, Inc.
+ */
+public class PosixFileHandleTest extends NativeTest {
+
+  private PosixFile file;
+
+  @Before
+  public void setUp() throws IOException {
+    file = new PosixFile(tempDir, "file", false);
+  }
+
+  @Test
+  public void testMetadata() throws IOException {
+    try (PosixFileHandle handle = PosixFileHandle.open(file, PosixFileHandle.O_WRONLY | PosixFileHandle.O_CREAT | PosixFileHandle.O_EXCL, 0600)) {
+      handle.chmod(0640).truncate(12345).utimens(1_500_000_000_123_456_789L, PosixFileHandle.UTIME_OMIT).sync();
+      Stat stat = handle.stat();
+      assertEquals(0640, stat.getMode() & PosixFile.PERMISSION_MASK);
+      assertEquals(12345, stat.getSize());
+      assertEquals(1_500_000_000_000L, stat.getAccessTime());
+      // Same file through the path
+      assertEquals(stat.getInode(), file.getStat().getInode());
+    }
+  }
+
+  @Test
+  public void testAllocateKeepSize() throws IOException {
+    try (PosixFileHandle handle = PosixFileHandle.open(file, PosixFileHandle.O_RDWR | PosixFileHandle.O_CREAT, 0600)) {
+      handle.allocate(0, 1024 * 1024, true);
+      assertEquals(0, handle.stat().getSize());
+      handle.allocate(0, 4096, false);
+      assertEquals(4096, handle.stat().getSize());
+    } catch (IOException e) {
+      // Filesystems without fallocate cannot keep the size
+      if (!e.getMessage().contains("not supported")) {
+        throw e;
+      }
+    }
+  }
+
+  @Test
+  public void testChannelAfterUnlink() throws IOException {
+    byte[] contents = "Hello, handle".getBytes(StandardCharsets.US_ASCII);
+    try (PosixFileHandle handle = PosixFileHandle.open(file, PosixFileHandle.O_RDWR | PosixFileHandle.O_CREAT, 0600)) {
+      file.delete();
+      try (FileChannel channel = handle.getChannel()) {
+        channel.write(ByteBuffer.wrap(contents));
+        ByteBuffer read = ByteBuffer.allocate(contents.length);
+        channel.read(read, 0);
+        assertArrayEquals(contents, read.array());
+      }
+      assertEquals(contents.length, handle.stat().getSize());
+    }
+  }
+
+  @Test
+  public void testVectored() throws IOException {
+    try (PosixFileHandle handle = PosixFileHandle.open(file, PosixFileHandle.O_RDWR | PosixFileHandle.O_CREAT, 0600)) {
+      ByteBuffer first = ByteBuffer.allocateDirect(3);
+      first.put(new byte[] {1, 2, 3}).flip();
+      ByteBuffer second = ByteBuffer.allocateDirect(2);
+      second.put(new byte[] {4, 5}).flip();
+      assertEquals(5, handle.write(10, new ByteBuffer[] {first, second}, 0));
+      assertEquals(0, first.remaining());
+      assertEquals(0, second.remaining());
+      ByteBuffer read1 = ByteBuffer.allocateDirect(4);
+      ByteBuffer read2 = ByteBuffer.allocateDirect(4);
+      assertEquals(5, handle.read(9, new ByteBuffer[] {read1, read2}, 0));
+      assertEquals(4, read1.position());
+      assertEquals(1, read2.position());
+      assertEquals(0, read1.get(0));
+      assertEquals(3, read1.get(3));
+      assertEquals(5, read2.get(0));
+      read1.clear();
+      assertEquals(-1, handle.read(15, new ByteBuffer[] {read1}, 0));
+    }
+  }
+
+  @Test
+  public void testMap() throws IOException {
+    long size = 3 * MappedRegion.getPageSize() + 100;
+    try (PosixFileHandle handle = PosixFileHandle.open(file, PosixFileHandle.O_RDWR | PosixFileHandle.O_CREAT, 0600)) {
+      handle.truncate(size);
+      // Unaligned position
+      try (MappedRegion region = handle.map(10, size - 10, MappedRegion.MAP_POPULATE)) {
+        region.advise(0, region.getSize(), MappedRegion.MADV_RANDOM);
+        ByteBuffer window = region.getBuffer(MappedRegion.getPageSize(), 4);
+        window.put(new byte[] {9, 8, 7, 6});
+        region.sync(MappedRegion.getPageSize(), 4, false);
+      }
+    }
+    try (MappedRegion region = file.map(0, size, 0)) {
+      ByteBuffer window = region.getBuffer(10 + MappedRegion.getPageSize(), 4);
+      assertEquals(9, window.get(0));
+      assertEquals(6, window.get(3));
+      assertEquals(true, window.isReadOnly());
+    }
+  }
+
+  @Test(expected = IllegalArgumentException.class)
+  public void testHeapBufferRejected() throws IOException {
+    try (PosixFileHandle handle = PosixFileHandle.open(file, PosixFileHandle.O_RDWR | PosixFileHandle.O_CREAT, 0600)) {
+      handle.read(0, new ByteBuffer[] {ByteBuffer.allocate(1)}, 0);
+    }
+  }
+
+  @Test
+  public void testClosed() throws IOException {
+    PosixFileHandle handle = PosixFileHandle.open(file, PosixFileHandle.O_WRONLY | PosixFileHandle.O_CREAT, 0600);
+    handle.close();
+    handle.close();
+    try {
+      handle.stat();
+      fail("ClosedChannelException expected");
+    } catch (ClosedChannelException e) {
+      // Expected
+    }
+  }
+
+  /**
+   * Opens a handle and drops it without closing, returning its file descriptor.
+   */
+  private int leak(PosixFile file) throws IOException {
+    return PosixFileHandle.open(file, PosixFileHandle.O_WRONLY | PosixFileHandle.O_CREAT, 0600).getFd();
+  }
+
+  /**
+   * A handle that becomes unreachable without being closed has its file descriptor closed by the daemon thread,
+   * without another handle being opened or closed.
+   */
+  @Test
+  public void testLeakClosed() throws Exception {
+    PosixFile leaked = new PosixFile(tempDir, "leaked", false);
+    Path fdPath = Paths.get("/proc/self/fd", Integer.toString(leak(leaked)));
+    Path target = Paths.get(leaked.getPath());
+    long deadline = System.currentTimeMillis() + 30000;
+    while (true) {
+      try {
+        if (!Files.readSymbolicLink(fdPath).equals(target)) {
+          // Closed and reused
+          break;
+        }
+      } catch (NoSuchFileException e) {
+        // Closed
+        break;
+      }
+      if (System.currentTimeMillis() >= deadline) {
+        fail("File descriptor not closed: " + fdPath);
+      }
+      System.gc();
+      Thread.sleep(10);
+    }
+  }
+}
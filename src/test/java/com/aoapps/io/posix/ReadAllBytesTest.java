@@ -0,0 +1,223 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+import static org.junit.Assume.assumeTrue;
+
+import java.io.FileNotFoundException;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.nio.file.Files;
+import java.nio.file.Paths;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.Random;
+import org.junit.Test;
+
+/**
+ * Tests the variants of {@link PosixFile#readAllBytes()}.
+ *
+ * @author  AO Industries, Inc.
+ */
+public class ReadAllBytesTest extends NativeTest {
+
+  /**
+   * Sizes around the 8 KiB stack buffer and one over a megabyte.
+   */
+  private static final int[] SIZES = {0, 1, 8190, 8191, 8192, 8193, 1024 * 1024 + 3};
+
+  private final Random random = new Random(1);
+
+  private byte[] write(PosixFile file, int size) throws IOException {
+    byte[] contents = new byte[size];
+    random.nextBytes(contents);
+    try (OutputStream out = new FileOutputStream(file.getFile())) {
+      out.write(contents);
+    }
+    return contents;
+  }
+
+  @Test
+  public void testReadAllBytes() throws IOException {
+    for (int size : SIZES) {
+      PosixFile file = new PosixFile(tempDir, "file" + size, false);
+      byte[] contents = write(file, size);
+      assertArrayEquals("size=" + size, contents, file.readAllBytes());
+    }
+  }
+
+  @Test(expected = FileNotFoundException.class)
+  public void testReadAllBytesMissing() throws IOException {
+    new PosixFile(tempDir, "missing", false).readAllBytes();
+  }
+
+  /**
+   * A final symbolic link is not followed.
+   */
+  @Test(expected = FileNotFoundException.class)
+  public void testReadAllBytesSymLink() throws IOException {
+    PosixFile file = new PosixFile(tempDir, "file", false);
+    write(file, 10);
+    new PosixFile(tempDir, "link", false).symLink("file").readAllBytes();
+  }
+
+  @Test
+  public void testReadAllBytesNotRegular() throws IOException {
+    PosixFile dir = new PosixFile(tempDir, "dir", false).mkdir();
+    // Opened non-blocking, so a FIFO without a writer does not hang
+    PosixFile fifo = new PosixFile(tempDir, "fifo", false).mkfifo(0600);
+    for (PosixFile file : Arrays.asList(dir, fifo)) {
+      try {
+        file.readAllBytes();
+        fail("Read " + file);
+      } catch (FileNotFoundException e) {
+        throw e;
+      } catch (IOException e) {
+        assertEquals("Not a regular file: " + file.getPath(), e.getMessage());
+      }
+    }
+  }
+
+  @Test
+  public void testReadAllBytesIntoBuffer() throws IOException {
+    for (int size : SIZES) {
+      PosixFile file = new PosixFile(tempDir, "file" + size, false);
+      byte[] contents = write(file, size);
+      // Larger than the file, at an offset
+      byte[] buff = new byte[size + 10];
+      assertEquals("size=" + size, size, file.readAllBytes(buff, 3, size + 7));
+      assertArrayEquals("size=" + size, contents, Arrays.copyOfRange(buff, 3, 3 + size));
+      // Exactly the size of the file
+      buff = new byte[size];
+      assertEquals("size=" + size, size, file.readAllBytes(buff, 0, size));
+      assertArrayEquals("size=" + size, contents, buff);
+    }
+  }
+
+  /**
+   * A buffer too small is filled with the start of the file, and the full size is returned.
+   */
+  @Test
+  public void testReadAllBytesIntoSmallBuffer() throws IOException {
+    PosixFile file = new PosixFile(tempDir, "file", false);
+    byte[] contents = write(file, 20000);
+    for (int len : new int[]{0, 1, 8192, 19999}) {
+      byte[] buff = new byte[len + 1];
+      assertEquals("len=" + len, 20000, file.readAllBytes(buff, 1, len));
+      assertArrayEquals("len=" + len, Arrays.copyOf(contents, len), Arrays.copyOfRange(buff, 1, 1 + len));
+      assertEquals("len=" + len, 0, buff[0]);
+    }
+  }
+
+  @Test(expected = IndexOutOfBoundsException.class)
+  public void testReadAllBytesIntoOutOfBounds() throws IOException {
+    PosixFile file = new PosixFile(tempDir, "file", false);
+    write(file, 10);
+    file.readAllBytes(new byte[10], 5, 6);
+  }
+
+  @Test
+  public void testReadAllBytesBatch() throws IOException {
+    PosixFile[] files = new PosixFile[SIZES.length + 1];
+    byte[][] expected = new byte[files.length][];
+    for (int i = 0; i < SIZES.length; i++) {
+      files[i] = new PosixFile(tempDir, "file" + i, false);
+      expected[i] = write(files[i], SIZES[i]);
+    }
+    // Missing files are null
+    files[SIZES.length] = new PosixFile(tempDir, "missing", false);
+    byte[][] actual = PosixFile.readAllBytes(Arrays.asList(files));
+    assertEquals(files.length, actual.length);
+    for (int i = 0; i < SIZES.length; i++) {
+      assertArrayEquals(files[i].getPath(), expected[i], actual[i]);
+    }
+    assertNull(actual[SIZES.length]);
+  }
+
+  @Test
+  public void testReadAllBytesBatchEmpty() throws IOException {
+    assertEquals(0, PosixFile.readAllBytes(Collections.<PosixFile>emptyList()).length);
+  }
+
+  /**
+   * Any failure other than a missing file stops the batch.
+   */
+  @Test
+  public void testReadAllBytesBatchNotRegular() throws IOException {
+    PosixFile file = new PosixFile(tempDir, "file", false);
+    write(file, 10);
+    PosixFile dir = new PosixFile(tempDir, "dir", false).mkdir();
+    try {
+      PosixFile.readAllBytes(Arrays.asList(file, dir, file));
+      fail("Read " + dir);
+    } catch (FileNotFoundException e) {
+      throw e;
+    } catch (IOException e) {
+      assertEquals("Not a regular file: " + dir.getPath(), e.getMessage());
+    }
+  }
+
+  /**
+   * Checks that no parent of the given directory would be changed by
+   * {@link PosixFile#secureParents(java.util.List, int, int)} with the largest ids, so the test does not briefly
+   * change directories shared with others, like <code>/tmp</code>.
+   */
+  private static boolean parentsSecure(PosixFile dir) throws IOException {
+    for (PosixFile parent = dir; !parent.isRootDirectory(); parent = parent.getParent()) {
+      if ((parent.getStat().getRawMode() & (PosixFile.OTHER_WRITE | PosixFile.SET_GID | PosixFile.SET_UID)) != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  @Test
+  public void testReadAllBytesSecure() throws IOException {
+    // Under the build directory, since the default temporary directory is world-writable
+    PosixFile dir = new PosixFile(Files.createTempDirectory(Paths.get("target").toAbsolutePath(), "ReadAllBytesTest.").toFile());
+    try {
+      assumeTrue("Parents of " + dir + " are not secure", parentsSecure(dir));
+      PosixFile file = new PosixFile(dir, "file", false);
+      byte[] contents = write(file, 10000);
+      assertArrayEquals(contents, file.readAllBytesSecure(Integer.MAX_VALUE, Integer.MAX_VALUE));
+      // Symbolic links are not allowed anywhere in the path
+      PosixFile link = new PosixFile(dir, "link", false).symLink(".");
+      try {
+        new PosixFile(link, "file", false).readAllBytesSecure(Integer.MAX_VALUE, Integer.MAX_VALUE);
+        fail("Read through " + link);
+      } catch (FileNotFoundException e) {
+        throw e;
+      } catch (IOException e) {
+        assertTrue(e.getMessage(), e.getMessage().startsWith("Symbolic link found in path: "));
+      }
+    } finally {
+      dir.deleteRecursive();
+    }
+  }
+}
@@ -0,0 +1,243 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+import static org.junit.Assume.assumeFalse;
+
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.nio.charset.StandardCharsets;
+import java.util.ArrayList;
+import java.util.Collections;
+import java.util.HashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.Random;
+import org.junit.Test;
+
+/**
+ * Tests {@link PosixFile#search(byte[][], long, com.aoapps.io.posix.SearchHandler, com.aoapps.io.posix.WalkOption...)}
+ * against a naive search.
+ *
+ * @author  AO Industries, Inc.
+ */
+public class SearchTest extends NativeTest {
+
+  /**
+   * The size of the blocks read by the native scanners, which matches must span.
+   */
+  private static final int BUFFER_SIZE = 1024 * 1024;
+
+  private static byte[] ascii(String s) {
+    return s.getBytes(StandardCharsets.US_ASCII);
+  }
+
+  /**
+   * Patterns that overlap, are prefixes or suffixes of each other, repeat, or hold any byte value.
+   */
+  private static final byte[][] PATTERNS = {
+      ascii("a"),
+      ascii("aa"),
+      ascii("aaa"),
+      ascii("ab"),
+      ascii("abab"),
+      ascii("bab"),
+      ascii("ab"),
+      {0},
+      {0, 0, (byte) 0xff},
+      {(byte) 0xff, (byte) 0xfe, (byte) 0x80, 0x7f},
+      {(byte) 0x80, 0x7f, (byte) 0xff}
+  };
+
+  private static void write(PosixFile file, byte[] contents) throws IOException {
+    try (OutputStream out = new FileOutputStream(file.getFile())) {
+      out.write(contents);
+    }
+  }
+
+  /**
+   * Gets contents from a small alphabet so that the patterns are found often and overlap.
+   */
+  private static byte[] randomContents(Random random, int size) {
+    byte[] alphabet = {'a', 'b', 0, (byte) 0xff, (byte) 0xfe, (byte) 0x80, 0x7f};
+    byte[] contents = new byte[size];
+    for (int i = 0; i < size; i++) {
+      contents[i] = alphabet[random.nextInt(alphabet.length)];
+    }
+    return contents;
+  }
+
+  private static String hit(String path, long offset, int pattern) {
+    return path + ':' + offset + ':' + pattern;
+  }
+
+  /**
+   * Finds every match by comparing each pattern at each offset.
+   */
+  private static List<String> naiveSearch(String path, byte[] contents, byte[][] patterns) {
+    List<String> hits = new ArrayList<>();
+    for (int offset = 0; offset < contents.length; offset++) {
+      for (int p = 0; p < patterns.length; p++) {
+        byte[] pattern = patterns[p];
+        if (offset + pattern.length <= contents.length) {
+          int i = 0;
+          while (i < pattern.length && contents[offset + i] == pattern[i]) {
+            i++;
+          }
+          if (i == pattern.length) {
+            hits.add(hit(path, offset, p));
+          }
+        }
+      }
+    }
+    return hits;
+  }
+
+  private List<String> search(byte[][] patterns) throws IOException {
+    List<String> hits = new ArrayList<>();
+    tempDir.search(patterns, -1, (path, offset, pattern) -> hits.add(hit(path, offset, pattern)));
+    Collections.sort(hits);
+    return hits;
+  }
+
+  @Test
+  public void testMatchesNaive() throws IOException {
+    Random random = new Random(1);
+    List<String> expected = new ArrayList<>();
+    int[] sizes = {1, 2, 3, 100, 4096, 65537};
+    for (int i = 0; i < sizes.length; i++) {
+      PosixFile file = new PosixFile(tempDir, "file" + i, false);
+      byte[] contents = randomContents(random, sizes[i]);
+      write(file, contents);
+      expected.addAll(naiveSearch(file.getPath(), contents, PATTERNS));
+    }
+    Collections.sort(expected);
+    assertEquals(expected, search(PATTERNS));
+  }
+
+  /**
+   * Each split of a pattern between the last bytes of one block and the first bytes of the next.
+   */
+  @Test
+  public void testSpansBlocks() throws IOException {
+    // No zero bytes, so only the planted matches are found
+    byte[][] patterns = {ascii("abab"), {(byte) 0xff, (byte) 0xfe, (byte) 0x80, 0x7f}};
+    List<String> expected = new ArrayList<>();
+    for (int p = 0; p < patterns.length; p++) {
+      byte[] pattern = patterns[p];
+      for (int before = 1; before < pattern.length; before++) {
+        byte[] contents = new byte[2 * BUFFER_SIZE];
+        int offset = BUFFER_SIZE - before;
+        System.arraycopy(pattern, 0, contents, offset, pattern.length);
+        PosixFile file = new PosixFile(tempDir, "span" + p + '.' + before, false);
+        write(file, contents);
+        expected.add(hit(file.getPath(), offset, p));
+      }
+    }
+    Collections.sort(expected);
+    assertEquals(expected, search(patterns));
+  }
+
+  @Test
+  public void testUnreadableFile() throws IOException {
+    assumeFalse("Root can read any file", "root".equals(System.getProperty("user.name")));
+    byte[] contents = ascii("one needle here");
+    PosixFile readable1 = new PosixFile(tempDir, "a", false);
+    write(readable1, contents);
+    PosixFile unreadable = new PosixFile(tempDir, "b", false);
+    write(unreadable, contents);
+    unreadable.setMode(0);
+    PosixFile readable2 = new PosixFile(tempDir, "c", false);
+    write(readable2, contents);
+    Map<String, IOException> failures = new HashMap<>();
+    List<String> hits = new ArrayList<>();
+    tempDir.search(
+        new byte[][] {ascii("needle")},
+        -1,
+        new SearchHandler() {
+          @Override
+          public void hit(String path, long offset, int pattern) {
+            hits.add(hit(path, offset, pattern));
+          }
+
+          @Override
+          public void failed(String path, IOException cause) {
+            assertNull(failures.put(path, cause));
+          }
+        }
+    );
+    Collections.sort(hits);
+    List<String> expected = new ArrayList<>();
+    expected.add(hit(readable1.getPath(), 4, 0));
+    expected.add(hit(readable2.getPath(), 4, 0));
+    assertEquals(expected, hits);
+    assertEquals(Collections.singleton(unreadable.getPath()), failures.keySet());
+    assertTrue(failures.get(unreadable.getPath()).getMessage().startsWith(unreadable.getPath() + ": "));
+    // Skipped by default
+    assertEquals(expected, search(new byte[][] {ascii("needle")}));
+    // Stopped by the handler
+    IOException stop = new IOException("Stop");
+    try {
+      tempDir.search(
+          new byte[][] {ascii("needle")},
+          -1,
+          new SearchHandler() {
+            @Override
+            public void hit(String path, long offset, int pattern) {
+              // Ignored
+            }
+
+            @Override
+            public void failed(String path, IOException cause) throws IOException {
+              throw stop;
+            }
+          }
+      );
+      fail("Search not stopped");
+    } catch (IOException e) {
+      assertSame(stop, e);
+    }
+  }
+
+  @Test(expected = IllegalArgumentException.class)
+  public void testPatternsTooLarge() throws IOException {
+    // Every byte value in a long pattern gives one state per byte and one column per byte value
+    byte[] pattern = new byte[300000];
+    for (int i = 0; i < pattern.length; i++) {
+      pattern[i] = (byte) i;
+    }
+    search(new byte[][] {pattern});
+  }
+
+  @Test(expected = IllegalArgumentException.class)
+  public void testEmptyPattern() throws IOException {
+    search(new byte[][] {ascii("a"), new byte[0]});
+  }
+}
@@ -0,0 +1,296 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+
+import java.io.IOException;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.concurrent.CountDownLatch;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.TimeoutException;
+import java.util.concurrent.atomic.AtomicBoolean;
+import java.util.concurrent.atomic.AtomicLong;
+import java.util.concurrent.atomic.AtomicReference;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+/**
+ * Tests {@link SupervisedPool} with operations that block until released, like a thread stuck on a hung mount, and a
+ * clock moved by hand.
+ *
+ * @author  AO Industries, Inc.
+ */
+public class SupervisedPoolTest extends NativeTest {
+
+  private static final long TIMEOUT = 100;
+
+  private final AtomicLong now = new AtomicLong();
+  private final List<CountDownLatch> blocked = new ArrayList<>();
+  private SupervisedPool pool;
+  private ExecutorService callers;
+  private PosixFile file;
+
+  @Before
+  public void setUp() throws IOException, TimeoutException {
+    pool = new SupervisedPool(16, now::get);
+    callers = Executors.newCachedThreadPool();
+    file = new PosixFile(tempDir, "file", true);
+    // Resolves the mount of the file ahead, so the calls below only block in the operation
+    assertEquals("ok", pool.call(10, TimeUnit.SECONDS, () -> "ok", file));
+  }
+
+  @After
+  public void tearDown() {
+    for (CountDownLatch latch : blocked) {
+      latch.countDown();
+    }
+    callers.shutdownNow();
+  }
+
+  private CountDownLatch newLatch() {
+    CountDownLatch latch = new CountDownLatch(1);
+    blocked.add(latch);
+    return latch;
+  }
+
+  /**
+   * An operation that blocks, ignoring interrupts like a thread in the kernel, until released.
+   */
+  private static <V> SupervisedPool.Operation<V> blocking(CountDownLatch started, CountDownLatch release, V result) {
+    return () -> {
+      started.countDown();
+      boolean interrupted = false;
+      while (true) {
+        try {
+          release.await();
+          break;
+        } catch (InterruptedException e) {
+          interrupted = true;
+        }
+      }
+      if (interrupted) {
+        Thread.currentThread().interrupt();
+      }
+      return result;
+    };
+  }
+
+  /**
+   * Times out an operation on the files, returning the message.
+   */
+  private String timeOut(CountDownLatch release, PosixFile ... files) throws IOException {
+    try {
+      pool.call(TIMEOUT, TimeUnit.MILLISECONDS, blocking(new CountDownLatch(1), release, null), files);
+      throw new AssertionError("Timeout expected");
+    } catch (TimeoutException e) {
+      assertTrue(e.getMessage(), e.getMessage().startsWith("Timeout after " + TIMEOUT + " ms on "));
+      return e.getMessage();
+    }
+  }
+
+  /**
+   * Starts an operation on another thread, with a long timeout, waiting until it is running.
+   */
+  private Future<String> startBlocking(CountDownLatch release, String result) throws InterruptedException {
+    CountDownLatch started = new CountDownLatch(1);
+    Future<String> future = callers.submit(() -> pool.call(1, TimeUnit.MINUTES, blocking(started, release, result), file));
+    assertTrue(started.await(10, TimeUnit.SECONDS));
+    return future;
+  }
+
+  private void assertFailsFast(String expectedPrefix, PosixFile ... files) throws IOException {
+    AtomicBoolean ran = new AtomicBoolean();
+    try {
+      pool.call(10, TimeUnit.SECONDS, () -> {
+        ran.set(true);
+        return null;
+      }, files);
+      fail("TimeoutException expected");
+    } catch (TimeoutException e) {
+      assertTrue(e.getMessage(), e.getMessage().startsWith(expectedPrefix));
+    }
+    assertFalse(ran.get());
+  }
+
+  private void awaitReleased() throws InterruptedException {
+    long deadline = System.nanoTime() + TimeUnit.SECONDS.toNanos(10);
+    while (pool.getQuarantinedCount() != 0) {
+      assertTrue("Quarantined helpers not released", System.nanoTime() - deadline < 0);
+      Thread.sleep(10);
+    }
+  }
+
+  @Test
+  public void testTimeoutOpensBreaker() throws Exception {
+    assertTrue(pool.isHealthy(file));
+    CountDownLatch release = newLatch();
+    timeOut(release, file);
+    assertEquals(1, pool.getQuarantinedCount());
+    assertFalse(pool.isHealthy(file));
+    assertFailsFast("Mount unhealthy: ", file);
+
+    release.countDown();
+    awaitReleased();
+    // Still cooling down
+    assertFalse(pool.isHealthy(file));
+    assertFailsFast("Mount unhealthy: ", file);
+  }
+
+  @Test
+  public void testQuarantine() throws Exception {
+    AtomicReference<Thread> helper = new AtomicReference<>();
+    CountDownLatch release = newLatch();
+    try {
+      pool.call(TIMEOUT, TimeUnit.MILLISECONDS, () -> {
+        helper.set(Thread.currentThread());
+        return blocking(new CountDownLatch(1), release, null).call();
+      }, file);
+      fail("TimeoutException expected");
+    } catch (TimeoutException e) {
+      // Expected
+    }
+    String name = helper.get().getName();
+    assertTrue(name, name.contains(" (quarantined on "));
+    assertEquals(1, pool.getQuarantinedCount());
+
+    release.countDown();
+    awaitReleased();
+    assertFalse(helper.get().getName().contains(" (quarantined on "));
+  }
+
+  @Test
+  public void testTooManyQuarantined() throws Exception {
+    pool = new SupervisedPool(1, now::get);
+    assertEquals("ok", pool.call(10, TimeUnit.SECONDS, () -> "ok", file));
+    CountDownLatch release = newLatch();
+    timeOut(release, file);
+    // Another mount is refused too while the pool is full
+    PosixFile other = new PosixFile("/proc/self/stat");
+    assertFailsFast("Too many operations quarantined: 1", other);
+
+    release.countDown();
+    awaitReleased();
+    assertEquals("ok", pool.call(10, TimeUnit.SECONDS, () -> "ok", other));
+  }
+
+  @Test
+  public void testProbeRecovers() throws Exception {
+    CountDownLatch release = newLatch();
+    timeOut(release, file);
+    release.countDown();
+    awaitReleased();
+
+    now.addAndGet(SupervisedPool.MIN_COOLDOWN);
+    CountDownLatch probeRelease = newLatch();
+    Future<String> probe = startBlocking(probeRelease, "probed");
+    // Only one probe at a time
+    assertFailsFast("Mount unhealthy: ", file);
+    probeRelease.countDown();
+    assertEquals("probed", probe.get(10, TimeUnit.SECONDS));
+
+    assertTrue(pool.isHealthy(file));
+    assertEquals("ok", pool.call(10, TimeUnit.SECONDS, () -> "ok", file));
+  }
+
+  @Test
+  public void testProbeErrorRecovers() throws Exception {
+    CountDownLatch release = newLatch();
+    timeOut(release, file);
+    release.countDown();
+    awaitReleased();
+
+    // An error is still an answer from the mount
+    now.addAndGet(SupervisedPool.MIN_COOLDOWN);
+    try {
+      pool.call(10, TimeUnit.SECONDS, () -> {
+        throw new IOException("answered");
+      }, file);
+      fail("IOException expected");
+    } catch (IOException e) {
+      assertEquals("answered", e.getMessage());
+    }
+    assertTrue(pool.isHealthy(file));
+  }
+
+  @Test
+  public void testProbeTimeoutDoublesCooldown() throws Exception {
+    CountDownLatch release = newLatch();
+    timeOut(release, file);
+    release.countDown();
+    awaitReleased();
+
+    now.addAndGet(SupervisedPool.MIN_COOLDOWN);
+    CountDownLatch probeRelease = newLatch();
+    timeOut(probeRelease, file);
+    probeRelease.countDown();
+    awaitReleased();
+
+    now.addAndGet(SupervisedPool.MIN_COOLDOWN);
+    assertFailsFast("Mount unhealthy: ", file);
+    now.addAndGet(SupervisedPool.MIN_COOLDOWN);
+    assertEquals("ok", pool.call(10, TimeUnit.SECONDS, () -> "ok", file));
+    assertTrue(pool.isHealthy(file));
+  }
+
+  @Test
+  public void testStaleCompletionDoesNotClose() throws Exception {
+    // Started while the mount was healthy
+    CountDownLatch staleRelease = newLatch();
+    Future<String> stale = startBlocking(staleRelease, "stale");
+
+    CountDownLatch release = newLatch();
+    timeOut(release, file);
+    assertFalse(pool.isHealthy(file));
+
+    // Returns after the breaker opened, but tells nothing of the mount since
+    staleRelease.countDown();
+    assertEquals("stale", stale.get(10, TimeUnit.SECONDS));
+    assertFalse(pool.isHealthy(file));
+    assertFailsFast("Mount unhealthy: ", file);
+  }
+
+  @Test
+  public void testSymlinkResolvesToTarget() throws Exception {
+    PosixFile link = new PosixFile(tempDir, "proc", false).symLink("/proc");
+    PosixFile linked = new PosixFile(link, "self", false);
+    assertEquals("ok", pool.call(10, TimeUnit.SECONDS, () -> "ok", linked));
+
+    CountDownLatch release = newLatch();
+    String message = timeOut(release, linked);
+    assertEquals("Timeout after " + TIMEOUT + " ms on /proc", message);
+    assertFalse(pool.isHealthy(linked));
+
+    // The mount of the directory holding the link is unaffected
+    assertTrue(pool.isHealthy(file));
+    assertEquals("ok", pool.call(10, TimeUnit.SECONDS, () -> "ok", file));
+  }
+}
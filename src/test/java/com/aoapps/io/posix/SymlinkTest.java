@@ -0,0 +1,244 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertNull;
+import static org.junit.Assert.assertSame;
+import static org.junit.Assert.fail;
+
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.util.HashMap;
+import java.util.Map;
+import org.junit.Before;
+import org.junit.Test;
+
+/**
+ * Tests the classification of links by
+ * {@link PosixFile#analyzeSymlinks(com.aoapps.io.posix.PosixFile, com.aoapps.io.posix.SymlinkHandler, com.aoapps.io.posix.WalkOption...)}.
+ *
+ * @author  AO Industries, Inc.
+ */
+public class SymlinkTest extends NativeTest {
+
+  /**
+   * The contents and classification of each link found.
+   */
+  private static class Results implements SymlinkHandler {
+    private final Map<String, String> targets = new HashMap<>();
+    private final Map<String, Integer> statuses = new HashMap<>();
+
+    @Override
+    public void links(String[] paths, String[] targets, int[] statuses) {
+      assertEquals(paths.length, targets.length);
+      assertEquals(paths.length, statuses.length);
+      for (int i = 0; i < paths.length; i++) {
+        assertNull("Link found twice: " + paths[i], this.targets.put(paths[i], targets[i]));
+        this.statuses.put(paths[i], statuses[i]);
+      }
+    }
+  }
+
+  private PosixFile dir;
+
+  @Before
+  public void setUp() throws IOException {
+    try (FileOutputStream out = new FileOutputStream(new PosixFile(tempDir, "file", false).getFile())) {
+      out.write('x');
+    }
+    dir = new PosixFile(tempDir, "dir", false).mkdir();
+    new PosixFile(dir, "sub", false).mkdir();
+    try (FileOutputStream out = new FileOutputStream(new PosixFile(dir, "file", false).getFile())) {
+      out.write('y');
+    }
+  }
+
+  private PosixFile symLink(PosixFile parent, String name, String target) throws IOException {
+    return new PosixFile(parent, name, false).symLink(target);
+  }
+
+  private Results analyze(PosixFile tree, PosixFile root) throws IOException {
+    Results results = new Results();
+    tree.analyzeSymlinks(root, results);
+    return results;
+  }
+
+  /**
+   * Checks the contents and classification of a link, with its path relative to the temporary directory.
+   */
+  private void assertLink(Results results, String name, String target, int status) {
+    String path = tempDir.getPath() + '/' + name;
+    assertEquals(path, target, results.targets.get(path));
+    assertEquals(path, Integer.valueOf(status), results.statuses.get(path));
+  }
+
+  @Test
+  public void testOk() throws IOException {
+    symLink(tempDir, "rel", "dir/file");
+    symLink(tempDir, "abs", dir.getPath() + "/file");
+    symLink(tempDir, "dirlink", "dir");
+    symLink(tempDir, "dot", ".");
+    symLink(dir, "up", "../file");
+    Results results = analyze(tempDir, tempDir);
+    assertLink(results, "rel", "dir/file", SymlinkHandler.OK);
+    assertLink(results, "abs", dir.getPath() + "/file", SymlinkHandler.OK);
+    assertLink(results, "dirlink", "dir", SymlinkHandler.OK);
+    assertLink(results, "dot", ".", SymlinkHandler.OK);
+    assertLink(results, "dir/up", "../file", SymlinkHandler.OK);
+    assertEquals(5, results.targets.size());
+  }
+
+  @Test
+  public void testEscape() throws IOException {
+    symLink(tempDir, "rel", "..");
+    symLink(tempDir, "abs", "/");
+    symLink(tempDir, "dotdot", "dir/../..");
+    symLink(dir, "parent", "../..");
+    Results results = analyze(tempDir, tempDir);
+    assertLink(results, "rel", "..", SymlinkHandler.ESCAPE);
+    assertLink(results, "abs", "/", SymlinkHandler.ESCAPE);
+    assertLink(results, "dotdot", "dir/../..", SymlinkHandler.ESCAPE);
+    assertLink(results, "dir/parent", "../..", SymlinkHandler.ESCAPE);
+    assertEquals(4, results.targets.size());
+  }
+
+  /**
+   * Whether a link escapes depends on the root, not on the tree analyzed.
+   */
+  @Test
+  public void testEscapeRoot() throws IOException {
+    symLink(dir, "up", "../file");
+    symLink(dir, "sublink", "sub");
+    Results results = analyze(dir, tempDir);
+    assertLink(results, "dir/up", "../file", SymlinkHandler.OK);
+    assertLink(results, "dir/sublink", "sub", SymlinkHandler.OK);
+    results = analyze(dir, dir);
+    assertLink(results, "dir/up", "../file", SymlinkHandler.ESCAPE);
+    assertLink(results, "dir/sublink", "sub", SymlinkHandler.OK);
+  }
+
+  @Test
+  public void testBroken() throws IOException {
+    symLink(tempDir, "rel", "missing");
+    symLink(tempDir, "abs", tempDir.getPath() + "/missing");
+    symLink(tempDir, "outside", "/nonexistent-" + tempDir.getFile().getName());
+    // A regular file along the way
+    symLink(tempDir, "throughFile", "file/x");
+    Results results = analyze(tempDir, tempDir);
+    assertLink(results, "rel", "missing", SymlinkHandler.BROKEN);
+    assertLink(results, "abs", tempDir.getPath() + "/missing", SymlinkHandler.BROKEN);
+    assertLink(results, "outside", "/nonexistent-" + tempDir.getFile().getName(), SymlinkHandler.BROKEN);
+    assertLink(results, "throughFile", "file/x", SymlinkHandler.BROKEN);
+  }
+
+  @Test
+  public void testLoop() throws IOException {
+    symLink(tempDir, "self", "self");
+    symLink(tempDir, "a", "b");
+    symLink(tempDir, "b", "a");
+    symLink(dir, "loop", "../dir/loop");
+    Results results = analyze(tempDir, tempDir);
+    assertLink(results, "self", "self", SymlinkHandler.LOOP);
+    assertLink(results, "a", "b", SymlinkHandler.LOOP);
+    assertLink(results, "b", "a", SymlinkHandler.LOOP);
+    assertLink(results, "dir/loop", "../dir/loop", SymlinkHandler.LOOP);
+  }
+
+  /**
+   * A chain of links takes the classification of where it finally resolves, through links to directories and
+   * links in other directories.
+   */
+  @Test
+  public void testChains() throws IOException {
+    symLink(tempDir, "dirlink", "dir");
+    symLink(tempDir, "toFile", "dirlink/file");
+    symLink(dir, "rel", "../file");
+    symLink(tempDir, "toRel", "dirlink/rel");
+    symLink(dir, "up", "../dirlink/sub/../file");
+    symLink(dir, "parent", "../..");
+    symLink(tempDir, "toParent", "dir/parent/");
+    symLink(tempDir, "self", "self");
+    symLink(tempDir, "toSelf", "self");
+    symLink(tempDir, "missing", "nope");
+    symLink(tempDir, "toMissing", "missing");
+    Results results = analyze(tempDir, tempDir);
+    assertLink(results, "toFile", "dirlink/file", SymlinkHandler.OK);
+    assertLink(results, "toRel", "dirlink/rel", SymlinkHandler.OK);
+    assertLink(results, "dir/up", "../dirlink/sub/../file", SymlinkHandler.OK);
+    assertLink(results, "toParent", "dir/parent/", SymlinkHandler.ESCAPE);
+    assertLink(results, "toSelf", "self", SymlinkHandler.LOOP);
+    assertLink(results, "toMissing", "missing", SymlinkHandler.BROKEN);
+  }
+
+  /**
+   * A chain of 40 links resolves, as in the kernel, but one more is a loop.
+   */
+  @Test
+  public void testLongChain() throws IOException {
+    symLink(tempDir, "l40", "file");
+    for (int i = 39; i >= 0; i--) {
+      symLink(tempDir, "l" + i, "l" + (i + 1));
+    }
+    Results results = analyze(tempDir, tempDir);
+    assertLink(results, "l1", "l2", SymlinkHandler.OK);
+    assertLink(results, "l0", "l1", SymlinkHandler.LOOP);
+  }
+
+  /**
+   * Every link is delivered once across batches.
+   */
+  @Test
+  public void testManyLinks() throws IOException {
+    for (int i = 0; i < 3000; i++) {
+      symLink(dir, "link" + i, (i % 2) == 0 ? "file" : "missing");
+    }
+    Results results = analyze(tempDir, tempDir);
+    assertEquals(3000, results.targets.size());
+    for (int i = 0; i < 3000; i++) {
+      assertLink(results, "dir/link" + i, (i % 2) == 0 ? "file" : "missing", (i % 2) == 0 ? SymlinkHandler.OK : SymlinkHandler.BROKEN);
+    }
+  }
+
+  /**
+   * An exception from the handler stops the analysis and is thrown as-is.
+   */
+  @Test
+  public void testHandlerException() throws IOException {
+    for (int i = 0; i < 3000; i++) {
+      symLink(dir, "link" + i, "file");
+    }
+    IOException stop = new IOException("stop");
+    int[] calls = {0};
+    try {
+      tempDir.analyzeSymlinks((paths, targets, statuses) -> {
+        calls[0]++;
+        throw stop;
+      });
+      fail("Handler exception not thrown");
+    } catch (IOException e) {
+      assertSame(stop, e);
+    }
+    assertEquals(1, calls[0]);
+  }
+}
@@ -0,0 +1,163 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.fail;
+
+import java.io.ByteArrayOutputStream;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.util.Arrays;
+import java.util.Random;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+import java.util.concurrent.Future;
+import org.junit.After;
+import org.junit.Before;
+import org.junit.Test;
+
+/**
+ * Tests {@link PosixFile#transferTo(java.io.FileDescriptor, long, long)} through a FIFO.
+ *
+ * @author  AO Industries, Inc.
+ */
+public class TransferTest extends NativeTest {
+
+  private static final int FILE_SIZE = 3 * 1024 * 1024 + 17;
+
+  private PosixFile file;
+  private byte[] contents;
+  private ExecutorService executor;
+
+  @Before
+  public void setUp() throws IOException {
+    file = new PosixFile(tempDir, "file", false);
+    contents = new byte[FILE_SIZE];
+    new Random(1).nextBytes(contents);
+    try (FileOutputStream out = new FileOutputStream(file.getFile())) {
+      out.write(contents);
+    }
+    executor = Executors.newSingleThreadExecutor();
+  }
+
+  @After
+  public void tearDown() {
+    executor.shutdownNow();
+  }
+
+  /**
+   * Transfers a range through a new FIFO, returning what was read from the other end.
+   */
+  private byte[] transfer(long offset, long length, long expectedTransferred) throws Exception {
+    PosixFile fifo = new PosixFile(tempDir, "fifo", false).mkfifo(0600);
+    try {
+      Future<byte[]> read = executor.submit(() -> {
+        try (InputStream in = new FileInputStream(fifo.getFile())) {
+          ByteArrayOutputStream bout = new ByteArrayOutputStream();
+          byte[] buff = new byte[8192];
+          int count;
+          while ((count = in.read(buff)) != -1) {
+            bout.write(buff, 0, count);
+          }
+          return bout.toByteArray();
+        }
+      });
+      try (FileOutputStream out = new FileOutputStream(fifo.getFile())) {
+        assertEquals(expectedTransferred, file.transferTo(out.getFD(), offset, length));
+      }
+      return read.get();
+    } finally {
+      fifo.delete();
+    }
+  }
+
+  @Test
+  public void testTransferAll() throws Exception {
+    assertArrayEquals(contents, transfer(0, -1, FILE_SIZE));
+  }
+
+  @Test
+  public void testTransferRange() throws Exception {
+    assertArrayEquals(Arrays.copyOfRange(contents, 1000, 1000 + 70000), transfer(1000, 70000, 70000));
+  }
+
+  @Test
+  public void testTransferPastEnd() throws Exception {
+    assertArrayEquals(Arrays.copyOfRange(contents, FILE_SIZE - 10, FILE_SIZE), transfer(FILE_SIZE - 10, 100, 10));
+  }
+
+  /**
+   * Gets the number of open file descriptors of this process.
+   */
+  private static int countOpenFds() {
+    String[] fds = new File("/proc/self/fd").list();
+    if (fds == null) {
+      throw new AssertionError("/proc/self/fd not available");
+    }
+    return fds.length;
+  }
+
+  /**
+   * The descriptor opened for the source is closed after each transfer, whether it succeeds or fails.
+   */
+  @Test
+  public void testClosesSource() throws Exception {
+    PosixFile outFile = new PosixFile(tempDir, "out", false);
+    try (FileOutputStream out = new FileOutputStream(outFile.getFile())) {
+      // Opened once before counting, in case the first call opens anything that stays open
+      file.transferTo(out.getFD(), 0, 1);
+      int before = countOpenFds();
+      for (int i = 0; i < 100; i++) {
+        assertEquals(1000, file.transferTo(out.getFD(), i * 1000L, 1000));
+      }
+      assertEquals(before, countOpenFds());
+    }
+    // A destination that cannot be written
+    try (FileInputStream in = new FileInputStream(outFile.getFile())) {
+      int before = countOpenFds();
+      for (int i = 0; i < 100; i++) {
+        try {
+          file.transferTo(in.getFD(), 0, 1000);
+          fail("Transferred to a read-only descriptor");
+        } catch (IOException e) {
+          // Expected
+        }
+      }
+      assertEquals(before, countOpenFds());
+    }
+  }
+
+  @Test(expected = IOException.class)
+  public void testTransferNotRegular() throws Exception {
+    PosixFile dir = new PosixFile(tempDir, "dir", false).mkdir();
+    try (FileOutputStream out = new FileOutputStream(new PosixFile(tempDir, "out", false).getFile())) {
+      dir.transferTo(out.getFD(), 0, -1);
+    }
+  }
+}
@@ -0,0 +1,266 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assume.assumeFalse;
+import static org.junit.Assume.assumeTrue;
+
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Paths;
+import java.util.Arrays;
+import org.junit.Test;
+
+/**
+ * Benchmarks the recursive operations on trees from {@link TreeGenerator}.  Excluded from the default build, these
+ * are run by the <code>benchmark</code> profile, which loads <code>libaocode.so</code> from where
+ * <code>compile.sh</code> writes it.
+ * <p>
+ * The defaults are small.  For repeatable numbers at over one million entries, generate into a tmpfs or
+ * loopback-mounted image:
+ * </p>
+ * <pre>mvn -Pbenchmark test \
+ *   -Dcom.aoapps.io.posix.TreeBenchmarkTest.dir=/mnt/bench \
+ *   -Dcom.aoapps.io.posix.TreeBenchmarkTest.fanOut=10 \
+ *   -Dcom.aoapps.io.posix.TreeBenchmarkTest.depth=5 \
+ *   -Dcom.aoapps.io.posix.TreeBenchmarkTest.filesPerDirectory=9 \
+ *   -Dcom.aoapps.io.posix.TreeBenchmarkTest.iterations=5 \
+ *   -Dcom.aoapps.io.posix.TreeBenchmarkTest.options=INODE_ORDER</pre>
+ * <p>
+ * The <code>latency</code> profile runs these same benchmarks under <code>aocode_latency_shim.c</code>, which injects
+ * NFS-like or overloaded-disk latency into the filesystem calls below the benchmark directory.  The scenario is included
+ * in the output.
+ * </p>
+ *
+ * @author  AO Industries, Inc.
+ */
+@SuppressWarnings("UseOfSystemOutOrSystemErr")
+public class TreeBenchmarkTest extends NativeTest {
+
+  private static final String PROPERTY_PREFIX = TreeBenchmarkTest.class.getName() + '.';
+
+  private static String getProperty(String name, String def) {
+    return System.getProperty(PROPERTY_PREFIX + name, def);
+  }
+
+  private static int getInt(String name, int def) {
+    return Integer.parseInt(getProperty(name, Integer.toString(def)));
+  }
+
+  /**
+   * Creates a generator from the system properties.
+   */
+  static TreeGenerator newGenerator() {
+    return new TreeGenerator()
+        .setSeed(Long.parseLong(getProperty("seed", "1")))
+        .setFanOut(getInt("fanOut", 4))
+        .setDepth(getInt("depth", 3))
+        .setFilesPerDirectory(getInt("filesPerDirectory", 8));
+  }
+
+  /**
+   * Gets the walk options for the native recursive operations, a comma-separated list of {@link WalkOption} names.
+   */
+  private static WalkOption[] getOptions() {
+    String value = getProperty("options", "").trim();
+    if (value.isEmpty()) {
+      return new WalkOption[0];
+    }
+    String[] names = value.split(",");
+    WalkOption[] options = new WalkOption[names.length];
+    for (int i = 0; i < names.length; i++) {
+      options[i] = WalkOption.valueOf(names[i].trim());
+    }
+    return options;
+  }
+
+  private final int iterations = getInt("iterations", 1);
+  private final WalkOption[] options = getOptions();
+  private final TreeGenerator generator = newGenerator();
+
+  /**
+   * Creates the temporary directory in the benchmark directory, when given.
+   */
+  @Override
+  protected PosixFile createTempDir() throws IOException {
+    return new PosixFile(
+        Files.createTempDirectory(Paths.get(getProperty("dir", System.getProperty("java.io.tmpdir"))), "TreeBenchmarkTest.").toFile()
+    );
+  }
+
+  /**
+   * Generates a new tree below the temporary directory.
+   */
+  private PosixFile generate(String name) throws IOException {
+    PosixFile root = new PosixFile(tempDir, name, false).mkdir();
+    assertEquals(generator.getEntryCount(), generator.generate(root));
+    return root;
+  }
+
+  /**
+   * Prints the best and median times for one operation.
+   */
+  private void report(String operation, long entries, long[] nanos) {
+    Arrays.sort(nanos);
+    long best = nanos[0];
+    long median = nanos[nanos.length / 2];
+    String scenario = System.getenv("AOCODE_SHIM");
+    System.out.println(
+        "TreeBenchmarkTest." + operation + (scenario == null ? "" : (" [" + scenario + ']'))
+            + (options.length == 0 ? "" : (' ' + Arrays.toString(options))) + ": " + entries + " entries, best "
+            + (best / 1000000) + " ms, median " + (median / 1000000) + " ms, "
+            + (best == 0 ? "-" : Long.toString(entries * 1000000000L / best)) + " entries/s"
+    );
+  }
+
+  /**
+   * Lists recursively without following symbolic links, returning the number of entries below the directory.
+   */
+  private static long list(PosixFile dir) throws IOException {
+    String[] names = dir.list();
+    long count = names.length;
+    for (String name : names) {
+      PosixFile child = new PosixFile(dir, name, false);
+      if (child.getStat().isDirectory()) {
+        count += list(child);
+      }
+    }
+    return count;
+  }
+
+  /**
+   * Copies recursively without following symbolic links, returning the number of entries copied below the directory.
+   */
+  private static long copy(PosixFile from, PosixFile to) throws IOException {
+    from.copyTo(to, false);
+    long count = 0;
+    if (from.getStat().isDirectory()) {
+      for (String name : from.list()) {
+        count += 1 + copy(new PosixFile(from, name, false), new PosixFile(to, name, false));
+      }
+    }
+    return count;
+  }
+
+  /**
+   * Compares all regular files recursively, returning the number of entries below the directory.
+   */
+  private static long contentEquals(PosixFile dir1, PosixFile dir2) throws IOException {
+    long count = 0;
+    for (String name : dir1.list()) {
+      PosixFile file1 = new PosixFile(dir1, name, false);
+      PosixFile file2 = new PosixFile(dir2, name, false);
+      Stat stat = file1.getStat();
+      if (stat.isDirectory()) {
+        count += contentEquals(file1, file2);
+      } else if (stat.isRegularFile()) {
+        assertTrue(file1.getPath(), file1.contentEquals(file2));
+      }
+      count++;
+    }
+    return count;
+  }
+
+  @Test
+  public void testList() throws IOException {
+    PosixFile root = generate("list");
+    long entries = generator.getEntryCount();
+    long[] nanos = new long[iterations];
+    for (int i = 0; i < iterations; i++) {
+      long start = System.nanoTime();
+      assertEquals(entries, list(root));
+      nanos[i] = System.nanoTime() - start;
+    }
+    report("list", entries, nanos);
+  }
+
+  @Test
+  public void testDeleteRecursive() throws IOException {
+    long entries = generator.getEntryCount();
+    long[] nanos = new long[iterations];
+    for (int i = 0; i < iterations; i++) {
+      PosixFile root = generate("deleteRecursive" + i);
+      long start = System.nanoTime();
+      root.deleteRecursive(options);
+      nanos[i] = System.nanoTime() - start;
+      assertFalse(root.getStat().exists());
+    }
+    report("deleteRecursive", entries, nanos);
+  }
+
+  /**
+   * Requires root and a benchmark directory whose parents are not world-writable, since the parents are
+   * temporarily secured.
+   */
+  @Test
+  public void testSecureDeleteRecursive() throws IOException {
+    assumeTrue("Requires root", "root".equals(System.getProperty("user.name")));
+    for (PosixFile parent = tempDir; !parent.isRootDirectory(); parent = parent.getParent()) {
+      assumeFalse("World-writable parent: " + parent, (parent.getStat().getRawMode() & PosixFile.OTHER_WRITE) != 0);
+    }
+    long entries = generator.getEntryCount();
+    long[] nanos = new long[iterations];
+    for (int i = 0; i < iterations; i++) {
+      PosixFile root = generate("secureDeleteRecursive" + i);
+      long start = System.nanoTime();
+      root.secureDeleteRecursive(Integer.MAX_VALUE, Integer.MAX_VALUE, options);
+      nanos[i] = System.nanoTime() - start;
+      assertFalse(root.getStat().exists());
+    }
+    report("secureDeleteRecursive", entries, nanos);
+  }
+
+  @Test
+  public void testCopyTo() throws IOException {
+    PosixFile root = generate("copyTo");
+    long entries = generator.getEntryCount();
+    long[] nanos = new long[iterations];
+    for (int i = 0; i < iterations; i++) {
+      PosixFile copy = new PosixFile(tempDir, "copyTo" + i, false);
+      long start = System.nanoTime();
+      assertEquals(entries, copy(root, copy));
+      nanos[i] = System.nanoTime() - start;
+      copy.deleteRecursive();
+    }
+    report("copyTo", entries, nanos);
+  }
+
+  @Test
+  public void testContentEquals() throws IOException {
+    PosixFile root = generate("contentEquals");
+    PosixFile copy = new PosixFile(tempDir, "contentEqualsCopy", false);
+    copy(root, copy);
+    long entries = generator.getEntryCount();
+    long[] nanos = new long[iterations];
+    for (int i = 0; i < iterations; i++) {
+      long start = System.nanoTime();
+      assertEquals(entries, contentEquals(root, copy));
+      nanos[i] = System.nanoTime() - start;
+    }
+    report("contentEquals", entries, nanos);
+  }
+}
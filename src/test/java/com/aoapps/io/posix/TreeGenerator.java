@@ -0,0 +1,215 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.io.RandomAccessFile;
+import java.util.ArrayList;
+import java.util.List;
+import java.util.Random;
+
+/**
+ * Generates reproducible synthetic filesystem trees for benchmarks.  The same settings and seed always
+ * produce the same names, sizes, contents, links, and permissions.
+ * <p>
+ * For meaningful numbers, generate into a tmpfs or a loopback-mounted filesystem image so that results are
+ * not skewed by other activity on the disk.
+ * </p>
+ *
+ * @author  AO Industries, Inc.
+ */
+public class TreeGenerator {
+
+  private static final int CONTENT_SIZE = 1 << 16;
+
+  private long seed = 1;
+  private int fanOut = 10;
+  private int depth = 3;
+  private int filesPerDirectory = 10;
+  private long medianFileSize = 4096;
+  private double fileSizeSigma = 1.5;
+  private long maxFileSize = 1L << 24;
+  private double symlinkRatio = 0.02;
+  private double hardlinkRatio = 0.01;
+  private double sparseRatio = 0.01;
+  private long[] fileModes = {0644, 0644, 0644, 0600, 0640, 0444, 0755};
+  private long[] directoryModes = {0755, 0755, 0700, 0750};
+  private int[] uids = {};
+  private int[] gids = {};
+
+  /**
+   * Sets the seed for all random choices.
+   */
+  public TreeGenerator setSeed(long seed) {
+    this.seed = seed;
+    return this;
+  }
+
+  /**
+   * Sets the number of subdirectories in each directory above the maximum depth.
+   */
+  public TreeGenerator setFanOut(int fanOut) {
+    this.fanOut = fanOut;
+    return this;
+  }
+
+  /**
+   * Sets the number of directory levels below the root.
+   */
+  public TreeGenerator setDepth(int depth) {
+    this.depth = depth;
+    return this;
+  }
+
+  /**
+   * Sets the number of non-directory entries in each directory, including links.
+   */
+  public TreeGenerator setFilesPerDirectory(int filesPerDirectory) {
+    this.filesPerDirectory = filesPerDirectory;
+    return this;
+  }
+
+  /**
+   * Sets the log-normal distribution of file sizes.
+   *
+   * @param  median  the median file size
+   * @param  sigma   the standard deviation of the natural logarithm of the size
+   * @param  max     the largest file size
+   */
+  public TreeGenerator setFileSizes(long median, double sigma, long max) {
+    this.medianFileSize = median;
+    this.fileSizeSigma = sigma;
+    this.maxFileSize = max;
+    return this;
+  }
+
+  /**
+   * Sets the fraction of entries that are symbolic links, hard links, and sparse files.
+   */
+  public TreeGenerator setRatios(double symlinkRatio, double hardlinkRatio, double sparseRatio) {
+    this.symlinkRatio = symlinkRatio;
+    this.hardlinkRatio = hardlinkRatio;
+    this.sparseRatio = sparseRatio;
+    return this;
+  }
+
+  /**
+   * Sets the permissions chosen from for files and directories.  Duplicate values increase their frequency.
+   * Directory modes must allow the owner to write and search.
+   */
+  public TreeGenerator setModes(long[] fileModes, long[] directoryModes) {
+    this.fileModes = fileModes.clone();
+    this.directoryModes = directoryModes.clone();
+    return this;
+  }
+
+  /**
+   * Sets the owners chosen from.  When empty, which is the default, ownership is not changed.
+   * Changing ownership requires root privileges.
+   */
+  public TreeGenerator setOwners(int[] uids, int[] gids) {
+    this.uids = uids.clone();
+    this.gids = gids.clone();
+    return this;
+  }
+
+  /**
+   * Gets the number of entries that will be generated below the root.
+   */
+  public long getEntryCount() {
+    long directories = 0;
+    long level = 1;
+    for (int d = 0; d < depth; d++) {
+      level *= fanOut;
+      directories += level;
+    }
+    return directories + (directories + 1) * filesPerDirectory;
+  }
+
+  /**
+   * Generates the tree into an existing, empty directory.
+   *
+   * @return  the number of entries created below the root
+   */
+  public long generate(PosixFile root) throws IOException {
+    Random random = new Random(seed);
+    byte[] content = new byte[CONTENT_SIZE];
+    random.nextBytes(content);
+    return generate(root, 0, random, content);
+  }
+
+  private long generate(PosixFile dir, int level, Random random, byte[] content) throws IOException {
+    long count = 0;
+    List<PosixFile> regularFiles = new ArrayList<>();
+    for (int i = 0; i < filesPerDirectory; i++) {
+      double type = random.nextDouble();
+      if (type < symlinkRatio) {
+        // Relative links to siblings, some of which are dangling
+        String target = random.nextInt(4) == 0 ? ("missing" + i) : ("f" + random.nextInt(filesPerDirectory));
+        setOwner(new PosixFile(dir, "l" + i, false).symLink(target), random);
+      } else if (type < symlinkRatio + hardlinkRatio && !regularFiles.isEmpty()) {
+        new PosixFile(dir, "h" + i, false).link(regularFiles.get(random.nextInt(regularFiles.size())));
+      } else {
+        PosixFile file = new PosixFile(dir, "f" + i, false);
+        long size = Math.min(maxFileSize, Math.round(medianFileSize * Math.exp(fileSizeSigma * random.nextGaussian())));
+        if (type > 1 - sparseRatio) {
+          // Sparse: a hole of at least one megabyte followed by one block of data
+          try (RandomAccessFile raf = new RandomAccessFile(file.getFile(), "rw")) {
+            raf.seek(Math.max(size, 1L << 20) - 4096);
+            raf.write(content, random.nextInt(CONTENT_SIZE - 4096), 4096);
+          }
+        } else {
+          try (OutputStream out = new FileOutputStream(file.getFile())) {
+            long remaining = size;
+            while (remaining > 0) {
+              int off = random.nextInt(CONTENT_SIZE);
+              int len = (int) Math.min(remaining, CONTENT_SIZE - off);
+              out.write(content, off, len);
+              remaining -= len;
+            }
+          }
+        }
+        setOwner(file.setMode(fileModes[random.nextInt(fileModes.length)]), random);
+        regularFiles.add(file);
+      }
+      count++;
+    }
+    if (level < depth) {
+      for (int i = 0; i < fanOut; i++) {
+        PosixFile subdir = new PosixFile(dir, "d" + i, false).mkdir();
+        count += 1 + generate(subdir, level + 1, random, content);
+        setOwner(subdir.setMode(directoryModes[random.nextInt(directoryModes.length)]), random);
+      }
+    }
+    return count;
+  }
+
+  private void setOwner(PosixFile file, Random random) throws IOException {
+    if (uids.length > 0 && gids.length > 0) {
+      file.chown(uids[random.nextInt(uids.length)], gids[random.nextInt(gids.length)]);
+    }
+  }
+}
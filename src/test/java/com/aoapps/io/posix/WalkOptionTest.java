@@ -0,0 +1,158 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assume.assumeNoException;
+
+import java.io.FileOutputStream;
+import java.io.IOException;
+import org.junit.Test;
+
+/**
+ * Tests that the {@link WalkOption options} of the native recursive operations change only how a tree is walked,
+ * never what is done to it.
+ *
+ * @author  AO Industries, Inc.
+ */
+public class WalkOptionTest extends NativeTest {
+
+  /**
+   * Generates a tree with many hard links, which share inodes and so are sorted by name in inode order.
+   */
+  private PosixFile generate(String name) throws IOException {
+    PosixFile root = new PosixFile(tempDir, name, false).mkdir();
+    TreeGenerator generator = new TreeGenerator()
+        .setFanOut(3)
+        .setDepth(2)
+        .setFilesPerDirectory(50)
+        .setFileSizes(64, 1.0, 4096)
+        .setRatios(0.05, 0.25, 0.02);
+    assertEquals(generator.getEntryCount(), generator.generate(root));
+    return root;
+  }
+
+  /**
+   * Creates one directory with more entries than fit in one <code>getdents64</code> buffer.
+   */
+  private PosixFile generateWide(String name, int count) throws IOException {
+    PosixFile dir = new PosixFile(tempDir, name, false).mkdir();
+    for (int i = 0; i < count; i++) {
+      PosixFile file = new PosixFile(dir, "file" + i + "-with-a-longer-name-to-fill-the-buffer", false);
+      new FileOutputStream(file.getFile()).close();
+    }
+    return dir;
+  }
+
+  /**
+   * Asserts that the flag is set or cleared on all regular files and directories, returning the number checked.
+   */
+  private static long assertFlag(PosixFile dir, int flag, boolean set) throws IOException {
+    assertEquals(dir.getPath(), set ? flag : 0, dir.getFlags() & flag);
+    long count = 1;
+    for (String name : dir.list()) {
+      PosixFile child = new PosixFile(dir, name, false);
+      Stat stat = child.getStat();
+      if (stat.isDirectory()) {
+        count += assertFlag(child, flag, set);
+      } else if (stat.isRegularFile()) {
+        assertEquals(child.getPath(), set ? flag : 0, child.getFlags() & flag);
+        count++;
+      }
+    }
+    return count;
+  }
+
+  /**
+   * Deletes a generated tree and a wide directory with the given options.
+   */
+  private void assertDeleteRecursive(WalkOption... options) throws IOException {
+    PosixFile root = generate("tree");
+    root.deleteRecursive(options);
+    assertFalse(root.getStat().exists());
+    PosixFile wide = generateWide("wide", 2000);
+    wide.deleteRecursive(options);
+    assertFalse(wide.getStat().exists());
+  }
+
+  /**
+   * Sets the no dump flag on a generated tree with the given options, skipping the test when the filesystem does not
+   * support inode flags.
+   */
+  private void assertChattrRecursive(WalkOption... options) throws IOException {
+    PosixFile root = generate("tree");
+    try {
+      root.chattr(PosixFile.FLAG_NO_DUMP, 0, true, options);
+    } catch (IOException e) {
+      assumeNoException("Inode flags not supported", e);
+    }
+    assertFlag(root, PosixFile.FLAG_NO_DUMP, true);
+    PosixFile wide = generateWide("wide", 2000);
+    wide.chattr(PosixFile.FLAG_NO_DUMP, 0, true, options);
+    assertEquals(2001, assertFlag(wide, PosixFile.FLAG_NO_DUMP, true));
+    root.chattr(0, PosixFile.FLAG_NO_DUMP, true, options);
+    assertFlag(root, PosixFile.FLAG_NO_DUMP, false);
+  }
+
+  @Test
+  public void testDeleteRecursive() throws IOException {
+    assertDeleteRecursive();
+  }
+
+  @Test
+  public void testDeleteRecursiveInodeOrder() throws IOException {
+    assertDeleteRecursive(WalkOption.INODE_ORDER);
+  }
+
+  @Test
+  public void testDeleteRecursivePrefetch() throws IOException {
+    assertDeleteRecursive(WalkOption.PREFETCH);
+  }
+
+  @Test
+  public void testDeleteRecursiveAll() throws IOException {
+    assertDeleteRecursive(WalkOption.ONE_FILE_SYSTEM, WalkOption.INODE_ORDER, WalkOption.PREFETCH);
+  }
+
+  @Test
+  public void testChattrRecursive() throws IOException {
+    assertChattrRecursive();
+  }
+
+  @Test
+  public void testChattrRecursiveInodeOrder() throws IOException {
+    assertChattrRecursive(WalkOption.INODE_ORDER);
+  }
+
+  @Test
+  public void testChattrRecursivePrefetch() throws IOException {
+    assertChattrRecursive(WalkOption.PREFETCH);
+  }
+
+  @Test
+  public void testChattrRecursiveAll() throws IOException {
+    assertChattrRecursive(WalkOption.ONE_FILE_SYSTEM, WalkOption.INODE_ORDER, WalkOption.PREFETCH);
+  }
+}
@@ -0,0 +1,201 @@
+/*
+ * ao-io-posix - Java interface to native POSIX filesystem objects.
+ * Copyright (C) 2026  AO Industries, Inc.
+ *     support@aoindustries.com
+ *     7262 Bull Pen Cir
+ *     Mobile, AL 36695
+ *
+ * This file is part of ao-io-posix.
+ *
+ * ao-io-posix is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * ao-io-posix is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with ao-io-posix.  If not, see <https://www.gnu.org/licenses/>.
+ */
+package com.aoapps.io.posix;
+
+import static org.junit.Assert.assertArrayEquals;
+import static org.junit.Assert.assertEquals;
+import static org.junit.Assert.assertFalse;
+import static org.junit.Assert.assertTrue;
+import static org.junit.Assert.fail;
+import static org.junit.Assume.assumeTrue;
+
+import java.io.FileNotFoundException;
+import java.io.FileOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+import java.nio.file.Files;
+import java.util.ArrayList;
+import java.util.Arrays;
+import java.util.Collections;
+import java.util.List;
+import java.util.Random;
+import org.junit.Test;
+
+/**
+ * Tests {@link PosixFile#writeFiles(java.util.List, boolean)}.
+ *
+ * @author  AO Industries, Inc.
+ */
+public class WriteFilesTest extends NativeTest {
+
+  private static final long[] MODES = {0644, 0600, 0755, 0444};
+
+  private final Random random = new Random(1);
+
+  private byte[] randomBytes(int size) {
+    byte[] bytes = new byte[size];
+    random.nextBytes(bytes);
+    return bytes;
+  }
+
+  /**
+   * Creates the specs of many files, spread over a few directories.
+   */
+  private List<FileSpec> createSpecs(int count) throws IOException {
+    List<FileSpec> specs = new ArrayList<>(count);
+    for (int i = 0; i < count; i++) {
+      PosixFile dir = new PosixFile(tempDir, "dir" + (i % 4), false);
+      if (!dir.getStat().exists()) {
+        dir.mkdir();
+      }
+      specs.add(new FileSpec(new PosixFile(dir, "file" + i, false), randomBytes(i * 37), MODES[i % MODES.length]));
+    }
+    return specs;
+  }
+
+  private static void assertWritten(List<FileSpec> specs) throws IOException {
+    for (FileSpec spec : specs) {
+      PosixFile file = spec.getFile();
+      Stat stat = file.getStat();
+      assertTrue(file.getPath(), stat.isRegularFile());
+      assertEquals(file.getPath(), spec.getMode(), stat.getMode());
+      assertArrayEquals(file.getPath(), spec.getContents(), Files.readAllBytes(file.getFile().toPath()));
+    }
+  }
+
+  /**
+   * Checks that no temporary file was left in any of the given directories.
+   */
+  private static void assertNoTemporaries(PosixFile... dirs) throws IOException {
+    for (PosixFile dir : dirs) {
+      for (String name : dir.list()) {
+        assertFalse(dir.getPath() + '/' + name, name.startsWith("."));
+      }
+    }
+  }
+
+  @Test
+  public void testWriteFiles() throws IOException {
+    List<FileSpec> specs = createSpecs(200);
+    PosixFile.writeFiles(specs, false);
+    assertWritten(specs);
+  }
+
+  @Test
+  public void testWriteFilesSync() throws IOException {
+    List<FileSpec> specs = createSpecs(50);
+    PosixFile.writeFiles(specs, true);
+    assertWritten(specs);
+  }
+
+  @Test
+  public void testWriteFilesEmpty() throws IOException {
+    PosixFile.writeFiles(Collections.<FileSpec>emptyList(), true);
+  }
+
+  /**
+   * Existing files are replaced, not written in place, so another link to the old file keeps the old contents.
+   */
+  @Test
+  public void testWriteFilesReplaces() throws IOException {
+    PosixFile file = new PosixFile(tempDir, "file", false);
+    byte[] old = randomBytes(1000);
+    try (OutputStream out = new FileOutputStream(file.getFile())) {
+      out.write(old);
+    }
+    PosixFile link = new PosixFile(tempDir, "link", false);
+    link.link(file);
+    List<FileSpec> specs = Collections.singletonList(new FileSpec(file, randomBytes(10), 0600));
+    PosixFile.writeFiles(specs, false);
+    assertWritten(specs);
+    assertArrayEquals(old, Files.readAllBytes(link.getFile().toPath()));
+    assertNoTemporaries(tempDir);
+  }
+
+  @Test
+  public void testWriteFilesOwner() throws IOException {
+    assumeTrue("Not root", "root".equals(System.getProperty("user.name")));
+    PosixFile file = new PosixFile(tempDir, "file", false);
+    PosixFile.writeFiles(Collections.singletonList(new FileSpec(file, randomBytes(10), 0640, 1234, 2345)), false);
+    Stat stat = file.getStat();
+    assertEquals(1234, stat.getUid());
+    assertEquals(2345, stat.getGid());
+    assertEquals(0640, stat.getMode());
+  }
+
+  /**
+   * The same path twice is rejected before anything is written.
+   */
+  @Test
+  public void testWriteFilesDuplicate() throws IOException {
+    List<FileSpec> specs = createSpecs(10);
+    FileSpec first = specs.get(3);
+    specs.add(new FileSpec(new PosixFile(first.getFile().getPath()), randomBytes(10), 0644));
+    try {
+      PosixFile.writeFiles(specs, false);
+      fail("Duplicate path written");
+    } catch (IllegalArgumentException e) {
+      assertEquals("Duplicate path: " + first.getFile().getPath(), e.getMessage());
+    }
+    for (FileSpec spec : specs) {
+      assertFalse(spec.getFile().getPath(), spec.getFile().getStat().exists());
+    }
+  }
+
+  /**
+   * A failure is reported with the path of the file that failed, at any position in the batch.
+   */
+  @Test
+  public void testWriteFilesReportsFailure() throws IOException {
+    for (int index : new int[]{0, 100, 199}) {
+      List<FileSpec> specs = createSpecs(200);
+      PosixFile missing = new PosixFile(tempDir, "missing/file", false);
+      specs.set(index, new FileSpec(missing, randomBytes(10), 0644));
+      try {
+        PosixFile.writeFiles(specs, false);
+        fail("Written into a missing directory");
+      } catch (FileNotFoundException e) {
+        assertTrue(e.getMessage(), e.getMessage().startsWith(missing.getPath() + ": "));
+      }
+      tempDir.deleteRecursive();
+      tempDir.mkdir();
+    }
+  }
+
+  /**
+   * A failure after the temporary file is written, such as a rename over a directory, removes the temporary file.
+   */
+  @Test
+  public void testWriteFilesOverDirectory() throws IOException {
+    PosixFile dir = new PosixFile(tempDir, "dir", false).mkdir();
+    new PosixFile(dir, "child", false).mkdir();
+    try {
+      PosixFile.writeFiles(Arrays.asList(new FileSpec(dir, randomBytes(10), 0644)), true);
+      fail("Written over a directory");
+    } catch (IOException e) {
+      assertTrue(e.getMessage(), e.getMessage().startsWith(dir.getPath() + ": "));
+    }
+    assertTrue(dir.getStat().isDirectory());
+    assertNoTemporaries(tempDir);
+  }
+}